@@ -86,6 +86,23 @@ RES _ResourceLoader::load_threaded_get(const String &p_path) {
 	return res;
 }
 
+Error _ResourceLoader::prefetch_request(const String &p_path, int64_t p_memory_budget) {
+	ERR_FAIL_COND_V(p_memory_budget < 0, ERR_INVALID_PARAMETER);
+	return ResourceLoader::prefetch_request(p_path, p_memory_budget);
+}
+
+_ResourceLoader::ThreadLoadStatus _ResourceLoader::prefetch_get_status(const String &p_path, Array r_progress) {
+	float progress = 0;
+	ResourceLoader::ThreadLoadStatus tls = ResourceLoader::prefetch_get_status(p_path, &progress);
+	r_progress.resize(1);
+	r_progress[0] = progress;
+	return (ThreadLoadStatus)tls;
+}
+
+void _ResourceLoader::prefetch_release(const String &p_path) {
+	ResourceLoader::prefetch_release(p_path);
+}
+
 RES _ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p_no_cache) {
 	Error err = OK;
 	RES ret = ResourceLoader::load(p_path, p_type_hint, p_no_cache, &err);
@@ -135,6 +152,10 @@ void _ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load_threaded_get_status", "path", "progress"), &_ResourceLoader::load_threaded_get_status, DEFVAL(Array()));
 	ClassDB::bind_method(D_METHOD("load_threaded_get", "path"), &_ResourceLoader::load_threaded_get);
 
+	ClassDB::bind_method(D_METHOD("prefetch_request", "path", "memory_budget"), &_ResourceLoader::prefetch_request, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("prefetch_get_status", "path", "progress"), &_ResourceLoader::prefetch_get_status, DEFVAL(Array()));
+	ClassDB::bind_method(D_METHOD("prefetch_release", "path"), &_ResourceLoader::prefetch_release);
+
 	ClassDB::bind_method(D_METHOD("load", "path", "type_hint", "no_cache"), &_ResourceLoader::load, DEFVAL(""), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_recognized_extensions_for_type", "type"), &_ResourceLoader::get_recognized_extensions_for_type);
 	ClassDB::bind_method(D_METHOD("set_abort_on_missing_resources", "abort"), &_ResourceLoader::set_abort_on_missing_resources);
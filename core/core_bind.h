@@ -62,6 +62,10 @@ public:
 	ThreadLoadStatus load_threaded_get_status(const String &p_path, Array r_progress = Array());
 	RES load_threaded_get(const String &p_path);
 
+	Error prefetch_request(const String &p_path, int64_t p_memory_budget = 0);
+	ThreadLoadStatus prefetch_get_status(const String &p_path, Array r_progress = Array());
+	void prefetch_release(const String &p_path);
+
 	RES load(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false);
 	Vector<String> get_recognized_extensions_for_type(const String &p_type);
 	void set_abort_on_missing_resources(bool p_abort);
@@ -95,6 +95,45 @@ Error FileAccessCompressed::open_after_magic(FileAccess *p_base) {
 	return OK;
 }
 
+int FileAccessCompressed::get_block_source_size(int p_block, uint32_t p_total, uint32_t p_block_size) {
+	return p_block == (get_block_count(p_total, p_block_size) - 1) ? p_total % p_block_size : p_block_size;
+}
+
+Vector<uint8_t> FileAccessCompressed::compress_block(const uint8_t *p_src, int p_src_size, Compression::Mode p_mode) {
+	Vector<uint8_t> cblock;
+	cblock.resize(Compression::get_max_compressed_buffer_size(p_src_size, p_mode));
+	int s = Compression::compress(cblock.ptrw(), p_src, p_src_size, p_mode);
+	cblock.resize(s);
+	return cblock;
+}
+
+uint64_t FileAccessCompressed::get_stored_size(const Vector<Vector<uint8_t>> &p_blocks) {
+	uint64_t size = 4 + 4 + 4 + 4 + 4; //magic, mode, block size, total size and magic at the end
+	for (int i = 0; i < p_blocks.size(); i++) {
+		size += 4 + p_blocks[i].size();
+	}
+	return size;
+}
+
+void FileAccessCompressed::store_blocks(FileAccess *p_dst, const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size, uint32_t p_total, const Vector<Vector<uint8_t>> &p_blocks) {
+	ERR_FAIL_COND(p_blocks.size() != get_block_count(p_total, p_block_size));
+
+	CharString mgc = p_magic.utf8();
+	p_dst->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
+	p_dst->store_32(p_mode); //write compression mode 4
+	p_dst->store_32(p_block_size); //write block size 4
+	p_dst->store_32(p_total); //max amount of data written 4
+
+	for (int i = 0; i < p_blocks.size(); i++) {
+		p_dst->store_32(p_blocks[i].size()); //compressed sizes
+	}
+	for (int i = 0; i < p_blocks.size(); i++) {
+		p_dst->store_buffer(p_blocks[i].ptr(), p_blocks[i].size());
+	}
+
+	p_dst->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
+}
+
 Error FileAccessCompressed::_open(const String &p_path, int p_mode_flags) {
 	ERR_FAIL_COND_V(p_mode_flags == READ_WRITE, ERR_UNAVAILABLE);
 
@@ -143,36 +182,14 @@ void FileAccessCompressed::close() {
 	if (writing) {
 		//save block table and all compressed blocks
 
-		CharString mgc = magic.utf8();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
-		f->store_32(cmode); //write compression mode 4
-		f->store_32(block_size); //write block size 4
-		f->store_32(write_max); //max amount of data written 4
-		int bc = (write_max / block_size) + 1;
-
+		int bc = get_block_count(write_max, block_size);
+		Vector<Vector<uint8_t>> blocks;
+		blocks.resize(bc);
 		for (int i = 0; i < bc; i++) {
-			f->store_32(0); //compressed sizes, will update later
+			blocks.write[i] = compress_block(&write_ptr[i * block_size], get_block_source_size(i, write_max, block_size), cmode);
 		}
 
-		Vector<int> block_sizes;
-		for (int i = 0; i < bc; i++) {
-			int bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
-
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
-		}
-
-		f->seek(16); //ok write block sizes
-		for (int i = 0; i < bc; i++) {
-			f->store_32(block_sizes[i]);
-		}
-		f->seek_end();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
+		store_blocks(f, magic, cmode, block_size, write_max, blocks);
 
 		buffer.clear();
 
@@ -68,6 +68,13 @@ public:
 
 	Error open_after_magic(FileAccess *p_base);
 
+	// Build the same block layout from memory, so blocks can be compressed separately (e.g. in parallel).
+	static int get_block_count(uint32_t p_total, uint32_t p_block_size) { return (p_total / p_block_size) + 1; }
+	static int get_block_source_size(int p_block, uint32_t p_total, uint32_t p_block_size);
+	static Vector<uint8_t> compress_block(const uint8_t *p_src, int p_src_size, Compression::Mode p_mode);
+	static uint64_t get_stored_size(const Vector<Vector<uint8_t>> &p_blocks);
+	static void store_blocks(FileAccess *p_dst, const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size, uint32_t p_total, const Vector<Vector<uint8_t>> &p_blocks);
+
 	virtual Error _open(const String &p_path, int p_mode_flags); ///< open a file
 	virtual void close(); ///< close a file
 	virtual bool is_open() const; ///< true when file is open
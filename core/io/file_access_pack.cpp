@@ -30,6 +30,7 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/object/script_language.h"
 #include "core/version.h"
@@ -46,7 +47,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, size_t p_
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_compressed) {
 	PathMD5 pmd5(path.md5_buffer());
 	//printf("adding path %s, %lli, %lli\n", path.utf8().get_data(), pmd5.a, pmd5.b);
 
@@ -54,6 +55,7 @@ void PackedData::add_path(const String &pkg_path, const String &path, uint64_t o
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.compressed = p_compressed;
 	pf.pack = pkg_path;
 	pf.offset = ofs;
 	pf.size = size;
@@ -117,11 +119,44 @@ void PackedData::_free_packed_dirs(PackedDir *p_dir) {
 	memdelete(p_dir);
 }
 
+const uint8_t *PackedData::get_mapped_pack(const String &p_pack) {
+	MutexLock lock(mapped_packs_mutex);
+
+	Map<String, MappedPack>::Element *E = mapped_packs.find(p_pack);
+	if (E) {
+		return E->get().data;
+	}
+
+	//the pack is mapped once and shared by every file opened from it
+	MappedPack mp;
+	mp.f = FileAccess::open(p_pack, FileAccess::READ);
+	if (mp.f) {
+		mp.data = mp.f->map_read_only();
+		if (!mp.data) {
+			memdelete(mp.f);
+			mp.f = nullptr;
+		}
+	}
+
+	mapped_packs[p_pack] = mp;
+	return mp.data;
+}
+
 PackedData::~PackedData() {
 	for (int i = 0; i < sources.size(); i++) {
 		memdelete(sources[i]);
 	}
 	_free_packed_dirs(root);
+
+	for (Map<String, MappedPack>::Element *E = mapped_packs.front(); E; E = E->next()) {
+		if (E->get().f) {
+			memdelete(E->get().f);
+		}
+	}
+
+	if (singleton == this) {
+		singleton = nullptr;
+	}
 }
 
 //////////////////////////////////////////////////////////////////
@@ -171,7 +206,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	if (version != PACK_FORMAT_VERSION) {
+	if (version < PACK_FORMAT_VERSION_MIN || version > PACK_FORMAT_VERSION) {
 		f->close();
 		memdelete(f);
 		ERR_FAIL_V_MSG(false, "Pack version unsupported: " + itos(version) + ".");
@@ -234,7 +269,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), (flags & PACK_FILE_COMPRESSED));
 	}
 
 	f->close();
@@ -243,7 +278,27 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 }
 
 FileAccess *PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
-	return memnew(FileAccessPack(p_path, *p_file));
+	FileAccess *f = memnew(FileAccessPack(p_path, *p_file));
+	if (!p_file->compressed) {
+		return f;
+	}
+
+	uint8_t magic[4];
+	f->get_buffer(magic, 4);
+	if (magic[0] != 'G' || magic[1] != 'C' || magic[2] != 'M' || magic[3] != 'P') {
+		memdelete(f);
+		ERR_FAIL_V_MSG(nullptr, "Can't open compressed pack-referenced file '" + p_path + "', unrecognized header.");
+	}
+
+	//decompressed block by block as it is read, the compressed file takes ownership of the pack file
+	FileAccessCompressed *fac = memnew(FileAccessCompressed);
+	Error err = fac->open_after_magic(f);
+	if (err != OK) {
+		memdelete(fac);
+		memdelete(f);
+		ERR_FAIL_V_MSG(nullptr, "Can't open compressed pack-referenced file '" + p_path + "'.");
+	}
+	return fac;
 }
 
 //////////////////////////////////////////////////////////////////
@@ -254,10 +309,17 @@ Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
 }
 
 void FileAccessPack::close() {
+	if (from_mapping) {
+		mapped = nullptr;
+		return;
+	}
 	f->close();
 }
 
 bool FileAccessPack::is_open() const {
+	if (from_mapping) {
+		return mapped != nullptr;
+	}
 	return f->is_open();
 }
 
@@ -268,7 +330,9 @@ void FileAccessPack::seek(size_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!from_mapping) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -294,11 +358,18 @@ uint8_t FileAccessPack::get_8() const {
 		return 0;
 	}
 
+	if (from_mapping) {
+		ERR_FAIL_COND_V_MSG(!mapped, 0, "File must be opened before use.");
+		return mapped[pos++];
+	}
+
 	pos++;
 	return f->get_8();
 }
 
 int FileAccessPack::get_buffer(uint8_t *p_dst, int p_length) const {
+	ERR_FAIL_COND_V_MSG(from_mapping && !mapped, -1, "File must be opened before use.");
+
 	if (eof) {
 		return 0;
 	}
@@ -309,19 +380,37 @@ int FileAccessPack::get_buffer(uint8_t *p_dst, int p_length) const {
 		to_read = int64_t(pf.size) - int64_t(pos);
 	}
 
+	const uint8_t *src = from_mapping ? &mapped[pos] : nullptr;
 	pos += p_length;
 
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (src) {
+		copymem(p_dst, src, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_buffer_ptr(int p_length) const {
+	if (!mapped || eof || p_length < 0 || pos + p_length > pf.size) {
+		return nullptr;
+	}
+
+	const uint8_t *ptr = &mapped[pos];
+	pos += p_length;
+	return ptr;
+}
+
 void FileAccessPack::set_endian_swap(bool p_swap) {
 	FileAccess::set_endian_swap(p_swap);
-	f->set_endian_swap(p_swap);
+	if (f) {
+		f->set_endian_swap(p_swap);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -348,12 +437,25 @@ bool FileAccessPack::file_exists(const String &p_name) {
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+	off = pf.offset;
+
+	if (!pf.encrypted) {
+		//reads go straight to the mapped pack, no need for a file handle
+		const uint8_t *pack_data = PackedData::get_singleton()->get_mapped_pack(pf.pack);
+		if (pack_data) {
+			mapped = &pack_data[pf.offset];
+			from_mapping = true;
+			return;
+		}
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(!f, "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
-	off = pf.offset;
 
 	if (pf.encrypted) {
 		FileAccessEncrypted *fae = memnew(FileAccessEncrypted);
@@ -375,8 +477,6 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
 }
 
 FileAccessPack::~FileAccessPack() {
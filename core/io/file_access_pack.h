@@ -33,6 +33,7 @@
 
 #include "core/os/dir_access.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/list.h"
 #include "core/templates/map.h"
@@ -40,14 +41,17 @@
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 // The current packed file format version number.
-#define PACK_FORMAT_VERSION 2
+#define PACK_FORMAT_VERSION 3
+// The oldest packed file format version that can still be read.
+#define PACK_FORMAT_VERSION_MIN 2
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0
 };
 
 enum PackFileFlags {
-	PACK_FILE_ENCRYPTED = 1 << 0
+	PACK_FILE_ENCRYPTED = 1 << 0,
+	PACK_FILE_COMPRESSED = 1 << 1 // Stored using FileAccessCompressed's block layout (since version 3).
 };
 
 class PackSource;
@@ -65,6 +69,7 @@ public:
 		uint8_t md5[16];
 		PackSource *src;
 		bool encrypted;
+		bool compressed;
 	};
 
 private:
@@ -107,15 +112,25 @@ private:
 	static PackedData *singleton;
 	bool disabled = false;
 
+	struct MappedPack {
+		FileAccess *f = nullptr;
+		const uint8_t *data = nullptr; //nullptr if the pack can't be mapped
+	};
+
+	Map<String, MappedPack> mapped_packs;
+	Mutex mapped_packs_mutex;
+
 	void _free_packed_dirs(PackedDir *p_dir);
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_compressed = false); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
+	const uint8_t *get_mapped_pack(const String &p_pack);
+
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, size_t p_offset);
 
@@ -149,7 +164,9 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 	uint64_t off;
 
-	FileAccess *f;
+	FileAccess *f = nullptr;
+	const uint8_t *mapped = nullptr; //start of the file inside the mapped pack, nullptr once closed
+	bool from_mapping = false; //read from the mapped pack, so there is no file handle
 	virtual Error _open(const String &p_path, int p_mode_flags);
 	virtual uint64_t _get_modified_time(const String &p_file) { return 0; }
 	virtual uint32_t _get_unix_permissions(const String &p_file) { return 0; }
@@ -169,6 +186,7 @@ public:
 	virtual uint8_t get_8() const;
 
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
+	virtual const uint8_t *get_buffer_ptr(int p_length) const;
 
 	virtual void set_endian_swap(bool p_swap);
 
@@ -31,9 +31,11 @@
 #include "pck_packer.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
 #include "core/os/file_access.h"
+#include "core/os/threaded_array_processor.h"
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -48,8 +50,26 @@ static int _get_pad(int p_alignment, int p_n) {
 
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_name", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(0), DEFVAL(String()), DEFVAL(false));
-	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt", "compress"), &PCKPacker::add_file, DEFVAL(false), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+
+	ClassDB::bind_method(D_METHOD("set_compression_mode", "mode"), &PCKPacker::set_compression_mode);
+	ClassDB::bind_method(D_METHOD("get_compression_mode"), &PCKPacker::get_compression_mode);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_mode", PROPERTY_HINT_ENUM, "FastLZ,Deflate,Zstd,GZip"), "set_compression_mode", "get_compression_mode");
+
+	BIND_ENUM_CONSTANT(COMPRESSION_FASTLZ);
+	BIND_ENUM_CONSTANT(COMPRESSION_DEFLATE);
+	BIND_ENUM_CONSTANT(COMPRESSION_ZSTD);
+	BIND_ENUM_CONSTANT(COMPRESSION_GZIP);
+}
+
+void PCKPacker::set_compression_mode(CompressionMode p_mode) {
+	compression_mode = p_mode;
+}
+
+PCKPacker::CompressionMode PCKPacker::get_compression_mode() const {
+	return compression_mode;
 }
 
 Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -105,12 +125,11 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	file->store_32(pack_flags); // flags
 
 	files.clear();
-	ofs = 0;
 
 	return OK;
 }
 
-Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt) {
+Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt, bool p_compress) {
 	FileAccess *f = FileAccess::open(p_src, FileAccess::READ);
 	if (!f) {
 		return ERR_FILE_CANT_OPEN;
@@ -119,7 +138,6 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 	File pf;
 	pf.path = p_file;
 	pf.src_path = p_src;
-	pf.ofs = ofs;
 	pf.size = f->get_len();
 
 	Vector<uint8_t> data = FileAccess::get_file_as_array(p_src);
@@ -132,19 +150,8 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 		}
 	}
 	pf.encrypted = p_encrypt;
-
-	uint64_t _size = pf.size;
-	if (p_encrypt) { // Add encryption overhead.
-		if (_size % 16) { // Pad to encryption block size.
-			_size += 16 - (_size % 16);
-		}
-		_size += 16; // hash
-		_size += 8; // data size
-		_size += 16; // iv
-	}
-
-	int pad = _get_pad(alignment, ofs + _size);
-	ofs = ofs + _size + pad;
+	// FileAccessCompressed uses 32 bits offsets, larger files are stored as is.
+	pf.compressed = p_compress && pf.size > 0 && pf.size < 0x7FFFFFFF;
 
 	files.push_back(pf);
 
@@ -154,28 +161,21 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 	return OK;
 }
 
-Error PCKPacker::flush(bool p_verbose) {
-	ERR_FAIL_COND_V_MSG(!file, ERR_INVALID_PARAMETER, "File must be opened before use.");
-
-	int64_t file_base_ofs = file->get_position();
-	file->store_64(0); // files base
-
-	for (int i = 0; i < 16; i++) {
-		file->store_32(0); // reserved
-	}
-
-	// write the index
-	file->store_32(files.size());
+void PCKPacker::_compress_block(uint32_t p_index, CompressBlock *p_blocks) {
+	CompressBlock &cb = p_blocks[p_index];
+	*cb.dst = FileAccessCompressed::compress_block(cb.src, cb.src_size, Compression::Mode(compression_mode));
+}
 
+void PCKPacker::_store_index() {
 	FileAccessEncrypted *fae = nullptr;
 	FileAccess *fhead = file;
 
 	if (enc_dir) {
 		fae = memnew(FileAccessEncrypted);
-		ERR_FAIL_COND_V(!fae, ERR_CANT_CREATE);
+		ERR_FAIL_COND(!fae);
 
 		Error err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
-		ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
+		ERR_FAIL_COND(err != OK);
 
 		fhead = fae;
 	}
@@ -198,6 +198,9 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -205,54 +208,146 @@ Error PCKPacker::flush(bool p_verbose) {
 		fae->release();
 		memdelete(fae);
 	}
+}
+
+Error PCKPacker::_store_file(int p_file, FileAccess *p_src, const CompressedFile *p_compressed) {
+	File &pf = files.write[p_file];
+	pf.ofs = file->get_position() - file_base;
+
+	FileAccessEncrypted *fae = nullptr;
+	FileAccess *ftmp = file;
+	if (pf.encrypted) {
+		fae = memnew(FileAccessEncrypted);
+		ERR_FAIL_COND_V(!fae, ERR_CANT_CREATE);
+
+		Error err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
+		ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
+		ftmp = fae;
+	}
+
+	if (p_compressed && pf.compressed) {
+		FileAccessCompressed::store_blocks(ftmp, "GCMP", Compression::Mode(compression_mode), COMPRESSION_BLOCK_SIZE, p_compressed->data.size(), p_compressed->blocks);
+	} else if (p_compressed) {
+		ftmp->store_buffer(p_compressed->data.ptr(), p_compressed->data.size());
+	} else {
+		const uint32_t buf_max = 65536;
+		uint8_t *buf = memnew_arr(uint8_t, buf_max);
+
+		uint64_t to_write = pf.size;
+		while (to_write > 0) {
+			int read = p_src->get_buffer(buf, MIN(to_write, buf_max));
+			ftmp->store_buffer(buf, read);
+			to_write -= read;
+		}
+
+		memdelete_arr(buf);
+	}
+
+	if (fae) {
+		fae->release();
+		memdelete(fae);
+	}
+
+	int pad = _get_pad(alignment, file->get_position());
+	for (int j = 0; j < pad; j++) {
+		file->store_8(Math::rand() % 256);
+	}
+
+	return OK;
+}
+
+Error PCKPacker::_store_compressed_batch(Vector<CompressedFile> &p_batch) {
+	// Blocks of every file in the batch are compressed in parallel, big files included.
+	Vector<CompressBlock> blocks;
+	for (int i = 0; i < p_batch.size(); i++) {
+		CompressedFile &cf = p_batch.write[i];
+		int bc = FileAccessCompressed::get_block_count(cf.data.size(), COMPRESSION_BLOCK_SIZE);
+		cf.blocks.resize(bc);
+		for (int j = 0; j < bc; j++) {
+			CompressBlock cb;
+			cb.src = cf.data.ptr() + j * COMPRESSION_BLOCK_SIZE;
+			cb.src_size = FileAccessCompressed::get_block_source_size(j, cf.data.size(), COMPRESSION_BLOCK_SIZE);
+			cb.dst = &cf.blocks.write[j];
+			blocks.push_back(cb);
+		}
+	}
+
+	thread_process_array(blocks.size(), this, &PCKPacker::_compress_block, blocks.ptrw());
+
+	for (int i = 0; i < p_batch.size(); i++) {
+		const CompressedFile &cf = p_batch[i];
+		File &pf = files.write[cf.file];
+
+		// Not worth it if it doesn't get smaller (e.g. already compressed formats).
+		uint64_t stored_size = FileAccessCompressed::get_stored_size(cf.blocks);
+		if (stored_size < uint64_t(cf.data.size())) {
+			pf.size = stored_size;
+		} else {
+			pf.compressed = false;
+		}
+
+		Error err = _store_file(cf.file, nullptr, &cf);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+
+	return OK;
+}
+
+Error PCKPacker::flush(bool p_verbose) {
+	ERR_FAIL_COND_V_MSG(!file, ERR_INVALID_PARAMETER, "File must be opened before use.");
+
+	int64_t file_base_ofs = file->get_position();
+	file->store_64(0); // files base
+
+	for (int i = 0; i < 16; i++) {
+		file->store_32(0); // reserved
+	}
+
+	// write the index
+	file->store_32(files.size());
+
+	// Offsets, and sizes of compressed files, are only known once the data is written.
+	// The index has the same size regardless, so store it now and again at the end.
+	int64_t index_ofs = file->get_position();
+	_store_index();
 
 	int header_padding = _get_pad(alignment, file->get_position());
 	for (int i = 0; i < header_padding; i++) {
 		file->store_8(Math::rand() % 256);
 	}
 
-	int64_t file_base = file->get_position();
+	file_base = file->get_position();
 	file->seek(file_base_ofs);
 	file->store_64(file_base); // update files base
 	file->seek(file_base);
 
-	const uint32_t buf_max = 65536;
-	uint8_t *buf = memnew_arr(uint8_t, buf_max);
+	Vector<CompressedFile> batch;
+	uint64_t batch_size = 0;
 
 	int count = 0;
 	for (int i = 0; i < files.size(); i++) {
-		FileAccess *src = FileAccess::open(files[i].src_path, FileAccess::READ);
-		uint64_t to_write = files[i].size;
-
-		fae = nullptr;
-		FileAccess *ftmp = file;
-		if (files[i].encrypted) {
-			fae = memnew(FileAccessEncrypted);
-			ERR_FAIL_COND_V(!fae, ERR_CANT_CREATE);
-
-			Error err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
-			ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
-			ftmp = fae;
-		}
-
-		while (to_write > 0) {
-			int read = src->get_buffer(buf, MIN(to_write, buf_max));
-			ftmp->store_buffer(buf, read);
-			to_write -= read;
-		}
-
-		if (fae) {
-			fae->release();
-			memdelete(fae);
-		}
-
-		int pad = _get_pad(alignment, file->get_position());
-		for (int j = 0; j < pad; j++) {
-			file->store_8(Math::rand() % 256);
+		if (files[i].compressed) {
+			CompressedFile cf;
+			cf.file = i;
+			cf.data = FileAccess::get_file_as_array(files[i].src_path);
+			batch_size += cf.data.size();
+			batch.push_back(cf);
+
+			if (batch_size >= COMPRESSION_BATCH_SIZE) {
+				Error err = _store_compressed_batch(batch);
+				ERR_FAIL_COND_V(err != OK, err);
+				batch.clear();
+				batch_size = 0;
+			}
+		} else {
+			FileAccess *src = FileAccess::open(files[i].src_path, FileAccess::READ);
+			ERR_FAIL_COND_V_MSG(!src, ERR_FILE_CANT_OPEN, "Can't open file to pack: " + files[i].src_path + ".");
+			Error err = _store_file(i, src, nullptr);
+			src->close();
+			memdelete(src);
+			ERR_FAIL_COND_V(err != OK, err);
 		}
 
-		src->close();
-		memdelete(src);
 		count += 1;
 		const int file_num = files.size();
 		if (p_verbose && (file_num > 0)) {
@@ -263,12 +358,19 @@ Error PCKPacker::flush(bool p_verbose) {
 		}
 	}
 
+	if (!batch.empty()) {
+		Error err = _store_compressed_batch(batch);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+
 	if (p_verbose) {
 		printf("\n");
 	}
 
+	file->seek(index_ofs);
+	_store_index();
+
 	file->close();
-	memdelete_arr(buf);
 
 	return OK;
 }
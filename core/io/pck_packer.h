@@ -31,6 +31,7 @@
 #ifndef PCK_PACKER_H
 #define PCK_PACKER_H
 
+#include "core/io/compression.h"
 #include "core/object/reference.h"
 
 class FileAccess;
@@ -38,9 +39,24 @@ class FileAccess;
 class PCKPacker : public Reference {
 	GDCLASS(PCKPacker, Reference);
 
+public:
+	enum CompressionMode {
+		COMPRESSION_FASTLZ = Compression::MODE_FASTLZ,
+		COMPRESSION_DEFLATE = Compression::MODE_DEFLATE,
+		COMPRESSION_ZSTD = Compression::MODE_ZSTD,
+		COMPRESSION_GZIP = Compression::MODE_GZIP
+	};
+
+private:
+	enum {
+		COMPRESSION_BLOCK_SIZE = 65536,
+		COMPRESSION_BATCH_SIZE = 64 * 1024 * 1024, // Max source bytes held in memory while compressing.
+	};
+
 	FileAccess *file = nullptr;
 	int alignment = 0;
-	uint64_t ofs = 0;
+	uint64_t file_base = 0;
+	CompressionMode compression_mode = COMPRESSION_ZSTD;
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
@@ -53,17 +69,40 @@ class PCKPacker : public Reference {
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
 
+	struct CompressedFile {
+		int file = 0;
+		Vector<uint8_t> data;
+		Vector<Vector<uint8_t>> blocks;
+	};
+
+	struct CompressBlock {
+		const uint8_t *src = nullptr;
+		int src_size = 0;
+		Vector<uint8_t> *dst = nullptr;
+	};
+
+	void _compress_block(uint32_t p_index, CompressBlock *p_blocks);
+	void _store_index();
+	Error _store_file(int p_file, FileAccess *p_src, const CompressedFile *p_compressed);
+	Error _store_compressed_batch(Vector<CompressedFile> &p_batch);
+
 public:
 	Error pck_start(const String &p_file, int p_alignment = 0, const String &p_key = String(), bool p_encrypt_directory = false);
-	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false);
+	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false, bool p_compress = false);
 	Error flush(bool p_verbose = false);
 
+	void set_compression_mode(CompressionMode p_mode);
+	CompressionMode get_compression_mode() const;
+
 	PCKPacker() {}
 	~PCKPacker();
 };
 
+VARIANT_ENUM_CAST(PCKPacker::CompressionMode);
+
 #endif // PCK_PACKER_H
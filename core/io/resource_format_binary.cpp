@@ -319,7 +319,19 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						}
 						r_v = internal_index_cache[path];
 					} else {
-						RES res = ResourceLoader::load(path);
+						RES res;
+						int internal_index = internal_resource_subindices.has(index) ? internal_resource_subindices[index] : -1;
+						if (internal_index != -1 && !ResourceCache::has(path)) {
+							//not deserialized yet (loading a single sub-resource), read it from its offset now
+							uint64_t pos = f->get_position();
+							error = _load_internal_resource(internal_index, res);
+							f->seek(pos);
+							if (error) {
+								return error;
+							}
+						} else {
+							res = ResourceLoader::load(path);
+						}
 						if (res.is_null()) {
 							WARN_PRINT(String("Couldn't load resource: " + path).utf8().get_data());
 						}
@@ -358,13 +370,20 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
 					} else {
-						if (external_resources[erindex].cache.is_null()) {
+						if (external_resources[erindex].cache.is_null() && !external_resources[erindex].load_failed) {
 							//cache not here yet, wait for it?
-							if (use_sub_threads) {
+							if (!use_sub_threads) {
+								//only loaded when first referenced (loading a single sub-resource)
+								error = _load_external_resource(erindex);
+								if (error) {
+									return error;
+								}
+							} else {
 								Error err;
 								external_resources.write[erindex].cache = ResourceLoader::load_threaded_get(external_resources[erindex].path, &err);
 
 								if (err != OK || external_resources[erindex].cache.is_null()) {
+									external_resources.write[erindex].load_failed = true;
 									if (!ResourceLoader::get_abort_on_missing_resources()) {
 										ResourceLoader::notify_dependency_error(local_path, external_resources[erindex].path, external_resources[erindex].type);
 									} else {
@@ -611,13 +630,7 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
-Error ResourceLoaderBinary::load() {
-	if (error != OK) {
-		return error;
-	}
-
-	int stage = 0;
-
+void ResourceLoaderBinary::_resolve_external_paths() {
 	for (int i = 0; i < external_resources.size(); i++) {
 		String path = external_resources[i].path;
 
@@ -631,127 +644,166 @@ Error ResourceLoaderBinary::load() {
 		}
 
 		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+	}
+}
 
-		if (!use_sub_threads) {
-			external_resources.write[i].cache = ResourceLoader::load(path, external_resources[i].type);
-
-			if (external_resources[i].cache.is_null()) {
-				if (!ResourceLoader::get_abort_on_missing_resources()) {
-					ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
-				} else {
-					error = ERR_FILE_MISSING_DEPENDENCIES;
-					ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
-				}
-			}
+Error ResourceLoaderBinary::_load_external_resource(int p_index) {
+	const String &path = external_resources[p_index].path;
+	external_resources.write[p_index].cache = ResourceLoader::load(path, external_resources[p_index].type);
 
+	if (external_resources[p_index].cache.is_null()) {
+		external_resources.write[p_index].load_failed = true;
+		if (!ResourceLoader::get_abort_on_missing_resources()) {
+			ResourceLoader::notify_dependency_error(local_path, path, external_resources[p_index].type);
 		} else {
-			Error err = ResourceLoader::load_threaded_request(path, external_resources[i].type, use_sub_threads, local_path);
-			if (err != OK) {
-				if (!ResourceLoader::get_abort_on_missing_resources()) {
-					ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
-				} else {
-					error = ERR_FILE_MISSING_DEPENDENCIES;
-					ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
-				}
-			}
+			error = ERR_FILE_MISSING_DEPENDENCIES;
+			ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
 		}
-
-		stage++;
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
+	return OK;
+}
 
-		//maybe it is loaded already
-		String path;
-		int subindex = 0;
+Error ResourceLoaderBinary::_load_internal_resource(int p_index, RES &r_res) {
+	bool main = p_index == (internal_resources.size() - 1);
 
-		if (!main) {
-			path = internal_resources[i].path;
+	//maybe it is loaded already
+	String path;
+	int subindex = 0;
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				subindex = path.to_int();
-				path = res_path + "::" + path;
-			}
+	if (!main) {
+		path = internal_resources[p_index].path;
 
-			if (!use_nocache) {
-				if (ResourceCache::has(path)) {
-					//already loaded, don't do anything
-					stage++;
-					error = OK;
-					continue;
-				}
-			}
-		} else {
-			if (!use_nocache && !ResourceCache::has(res_path)) {
-				path = res_path;
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			subindex = path.to_int();
+			path = res_path + "::" + path;
+		}
+
+		if (!use_nocache) {
+			if (ResourceCache::has(path)) {
+				//already loaded, don't do anything
+				r_res = RES(ResourceCache::get(path));
+				return OK;
 			}
 		}
+	} else {
+		if (!use_nocache && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
+	}
 
-		uint64_t offset = internal_resources[i].offset;
+	uint64_t offset = internal_resources[p_index].offset;
 
-		f->seek(offset);
+	f->seek(offset);
 
-		String t = get_unicode_string();
+	String t = get_unicode_string();
 
-		Object *obj = ClassDB::instance(t);
-		if (!obj) {
-			error = ERR_FILE_CORRUPT;
-			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-		}
+	Object *obj = ClassDB::instance(t);
+	if (!obj) {
+		error = ERR_FILE_CORRUPT;
+		ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
+	}
+
+	Resource *r = Object::cast_to<Resource>(obj);
+	if (!r) {
+		String obj_class = obj->get_class();
+		error = ERR_FILE_CORRUPT;
+		memdelete(obj); //bye
+		ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
+	}
+
+	RES res = RES(r);
+
+	if (path != String()) {
+		r->set_path(path);
+	}
+	r->set_subindex(subindex);
+
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
+
+	int pc = f->get_32();
+
+	//set properties
 
-		Resource *r = Object::cast_to<Resource>(obj);
-		if (!r) {
-			String obj_class = obj->get_class();
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
+
+		if (name == StringName()) {
 			error = ERR_FILE_CORRUPT;
-			memdelete(obj); //bye
-			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
 		}
 
-		RES res = RES(r);
+		Variant value;
 
-		if (path != String()) {
-			r->set_path(path);
+		error = parse_variant(value);
+		if (error) {
+			return error;
 		}
-		r->set_subindex(subindex);
 
-		if (!main) {
-			internal_index_cache[path] = res;
-		}
+		res->set(name, value);
+	}
+#ifdef TOOLS_ENABLED
+	res->set_edited(false);
+#endif
 
-		int pc = f->get_32();
+	resource_cache.push_back(res);
+	r_res = res;
 
-		//set properties
+	return OK;
+}
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+Error ResourceLoaderBinary::load() {
+	if (error != OK) {
+		return error;
+	}
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+	int stage = 0;
+
+	_resolve_external_paths();
 
-			Variant value;
+	for (int i = 0; i < external_resources.size(); i++) {
+		String path = external_resources[i].path;
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
+		if (!use_sub_threads) {
+			Error err = _load_external_resource(i);
+			if (err != OK) {
+				return err;
 			}
 
-			res->set(name, value);
+		} else {
+			Error err = ResourceLoader::load_threaded_request(path, external_resources[i].type, use_sub_threads, local_path);
+			if (err != OK) {
+				external_resources.write[i].load_failed = true;
+				if (!ResourceLoader::get_abort_on_missing_resources()) {
+					ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
+				} else {
+					error = ERR_FILE_MISSING_DEPENDENCIES;
+					ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
+				}
+			}
 		}
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
+
+		stage++;
+	}
+
+	for (int i = 0; i < internal_resources.size(); i++) {
+		bool main = i == (internal_resources.size() - 1);
+
+		RES res;
+		error = _load_internal_resource(i, res);
+		if (error) {
+			return error;
+		}
+
 		stage++;
 
 		if (progress) {
 			*progress = (i + 1) / float(internal_resources.size());
 		}
 
-		resource_cache.push_back(res);
-
 		if (main) {
 			f->close();
 			resource = res;
@@ -764,6 +816,29 @@ Error ResourceLoaderBinary::load() {
 	return ERR_FILE_EOF;
 }
 
+Error ResourceLoaderBinary::load_sub_resource(int p_subindex) {
+	if (error != OK) {
+		return error;
+	}
+
+	ERR_FAIL_COND_V_MSG(!internal_resource_subindices.has(p_subindex), ERR_DOES_NOT_EXIST, "Sub-resource " + itos(p_subindex) + " not found in: " + local_path + ".");
+
+	// Only this sub-resource and what it references is deserialized,
+	// external dependencies are loaded when first referenced.
+	_resolve_external_paths();
+
+	RES res;
+	error = _load_internal_resource(internal_resource_subindices[p_subindex], res);
+	if (error) {
+		return error;
+	}
+
+	f->close();
+	resource = res;
+	resource->set_as_translation_remapped(translation_remapped);
+	return OK;
+}
+
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
 	translation_remapped = p_remapped;
 }
@@ -901,6 +976,10 @@ void ResourceLoaderBinary::open(FileAccess *p_f) {
 		ir.path = get_unicode_string();
 		ir.offset = f->get_64();
 		internal_resources.push_back(ir);
+
+		if (ir.path.begins_with("local://")) {
+			internal_resource_subindices[ir.path.replace_first("local://", "").to_int()] = i;
+		}
 	}
 
 	print_bl("int resources: " + itos(int_resources_size));
@@ -967,7 +1046,7 @@ RES ResourceFormatLoaderBinary::load(const String &p_path, const String &p_origi
 	}
 
 	Error err;
-	FileAccess *f = FileAccess::open(p_path, FileAccess::READ, &err);
+	FileAccess *f = FileAccess::open(p_path.get_slice("::", 0), FileAccess::READ, &err);
 
 	ERR_FAIL_COND_V_MSG(err != OK, RES(), "Cannot open file '" + p_path + "'.");
 
@@ -976,12 +1055,18 @@ RES ResourceFormatLoaderBinary::load(const String &p_path, const String &p_origi
 	loader.use_sub_threads = p_use_sub_threads;
 	loader.progress = r_progress;
 	String path = p_original_path != "" ? p_original_path : p_path;
-	loader.local_path = ProjectSettings::get_singleton()->localize_path(path);
+	loader.local_path = ProjectSettings::get_singleton()->localize_path(path.get_slice("::", 0));
 	loader.res_path = loader.local_path;
 	//loader.set_local_path( Globals::get_singleton()->localize_path(p_path) );
 	loader.open(f);
 
-	err = loader.load();
+	if (p_path.find("::") != -1) {
+		// A single sub-resource, the rest of the file is left alone.
+		loader.use_sub_threads = false;
+		err = loader.load_sub_resource(p_path.get_slice("::", 1).to_int());
+	} else {
+		err = loader.load();
+	}
 
 	if (r_error) {
 		*r_error = err;
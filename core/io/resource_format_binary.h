@@ -58,6 +58,7 @@ class ResourceLoaderBinary {
 		String path;
 		String type;
 		RES cache;
+		bool load_failed = false; //already reported, not tried again for every reference
 	};
 
 	bool use_sub_threads = false;
@@ -70,6 +71,7 @@ class ResourceLoaderBinary {
 	};
 
 	Vector<IntResource> internal_resources;
+	Map<int, int> internal_resource_subindices; //subindex to position in internal_resources
 	Map<String, RES> internal_index_cache;
 
 	String get_unicode_string();
@@ -84,12 +86,17 @@ class ResourceLoaderBinary {
 
 	Error parse_variant(Variant &r_v);
 
+	void _resolve_external_paths();
+	Error _load_external_resource(int p_index);
+	Error _load_internal_resource(int p_index, RES &r_res);
+
 	Map<String, RES> dependency_cache;
 
 public:
 	void set_local_path(const String &p_local_path);
 	Ref<Resource> get_resource();
 	Error load();
+	Error load_sub_resource(int p_subindex);
 	void set_translation_remapped(bool p_remapped);
 
 	void set_remaps(const Map<String, String> &p_remaps) { remaps = p_remaps; }
@@ -107,6 +114,7 @@ public:
 	virtual void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const;
 	virtual void get_recognized_extensions(List<String> *p_extensions) const;
 	virtual bool handles_type(const String &p_type) const;
+	virtual bool handles_sub_resources() const { return true; }
 	virtual String get_resource_type(const String &p_path) const;
 	virtual void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types = false);
 	virtual Error rename_dependencies(const String &p_path, const Map<String, String> &p_map);
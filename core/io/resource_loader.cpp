@@ -181,9 +181,16 @@ void ResourceFormatLoader::_bind_methods() {
 RES ResourceLoader::_load(const String &p_path, const String &p_original_path, const String &p_type_hint, bool p_no_cache, Error *r_error, bool p_use_sub_threads, float *r_progress) {
 	bool found = false;
 
+	// Sub-resources ("path::subindex") are recognized by the file they are stored in.
+	bool sub_resource = p_path.find("::") != -1;
+	String file_path = p_path.get_slice("::", 0);
+
 	// Try all loaders and pick the first match for the type hint
 	for (int i = 0; i < loader_count; i++) {
-		if (!loader[i]->recognize_path(p_path, p_type_hint)) {
+		if (!loader[i]->recognize_path(file_path, p_type_hint)) {
+			continue;
+		}
+		if (sub_resource && !loader[i]->handles_sub_resources()) {
 			continue;
 		}
 		found = true;
@@ -504,6 +511,155 @@ RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
 	return resource;
 }
 
+uint64_t ResourceLoader::_prefetch_estimate_size(const String &p_local_path) {
+	//file size on disk is used as an estimate of the memory the resource will take
+	String path = import_remap(_path_remap(p_local_path));
+	FileAccess *f = FileAccess::open(path, FileAccess::READ);
+	if (!f) {
+		return 0;
+	}
+	uint64_t len = f->get_len();
+	memdelete(f);
+	return len;
+}
+
+void ResourceLoader::_prefetch_harvest(PrefetchSet &p_set) {
+	Set<String>::Element *E = p_set.requested.front();
+	while (E) {
+		Set<String>::Element *N = E->next();
+
+		ThreadLoadStatus status = load_threaded_get_status(E->get());
+		if (status != THREAD_LOAD_IN_PROGRESS) {
+			//done, so this will not block
+			RES res = load_threaded_get(E->get());
+			if (res.is_valid()) {
+				p_set.resources[E->get()] = res;
+			}
+			p_set.requested.erase(E);
+		}
+		E = N;
+	}
+}
+
+Error ResourceLoader::prefetch_request(const String &p_path, uint64_t p_memory_budget) {
+	String local_path;
+	if (p_path.is_rel_path()) {
+		local_path = "res://" + p_path;
+	} else {
+		local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+	}
+
+	ERR_FAIL_COND_V_MSG(!exists(local_path), ERR_FILE_NOT_FOUND, "Resource file not found: " + local_path + ".");
+
+	//only the direct dependencies get their own request, the deeper ones are loaded along with them
+	List<String> dependencies;
+	get_dependencies(local_path, &dependencies, true);
+	//the scene itself goes last, so its own load picks up the dependencies already in flight
+	dependencies.push_back(local_path);
+
+	MutexLock lock(*thread_load_mutex);
+
+	if (prefetch_sets.has(local_path)) {
+		return OK;
+	}
+
+	PrefetchSet &set = prefetch_sets[local_path];
+	int skipped = 0;
+
+	for (List<String>::Element *E = dependencies.front(); E; E = E->next()) {
+		String path = E->get().get_slice("::", 0);
+		String type_hint = E->get().get_slice("::", 1);
+		if (set.resources.has(path) || set.requested.has(path)) {
+			continue;
+		}
+
+		//already cached, just hold a reference so it is not freed before use
+		RES cached = ResourceCache::get(path);
+		if (cached.is_valid()) {
+			set.resources[path] = cached;
+			set.total++;
+			continue;
+		}
+
+		//what does not fit in the budget is left to be loaded on demand
+		uint64_t size = _prefetch_estimate_size(path);
+		if (p_memory_budget > 0 && set.memory_used + size > p_memory_budget) {
+			skipped++;
+			continue;
+		}
+
+		if (load_threaded_request(path, type_hint) == OK) {
+			set.memory_used += size;
+			set.requested.insert(path);
+			set.total++;
+		}
+	}
+
+	print_verbose("Prefetching " + itos(set.total) + " resources for: " + local_path + " (" + itos(skipped) + " over budget).");
+
+	return OK;
+}
+
+ResourceLoader::ThreadLoadStatus ResourceLoader::prefetch_get_status(const String &p_path, float *r_progress) {
+	String local_path;
+	if (p_path.is_rel_path()) {
+		local_path = "res://" + p_path;
+	} else {
+		local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+	}
+
+	MutexLock lock(*thread_load_mutex);
+
+	PrefetchSet *set = prefetch_sets.getptr(local_path);
+	if (!set) {
+		return THREAD_LOAD_INVALID_RESOURCE;
+	}
+
+	_prefetch_harvest(*set);
+
+	if (r_progress) {
+		int done = set->total - set->requested.size();
+		*r_progress = set->total > 0 ? float(done) / float(set->total) : 1.0;
+	}
+
+	return set->requested.empty() ? THREAD_LOAD_LOADED : THREAD_LOAD_IN_PROGRESS;
+}
+
+void ResourceLoader::prefetch_release(const String &p_path) {
+	String local_path;
+	if (p_path.is_rel_path()) {
+		local_path = "res://" + p_path;
+	} else {
+		local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+	}
+
+	thread_load_mutex->lock();
+	PrefetchSet *set = prefetch_sets.getptr(local_path);
+	if (!set) {
+		thread_load_mutex->unlock();
+		ERR_FAIL_MSG("There is no prefetch in progress for '" + local_path + "'.");
+	}
+	Set<String> requested = set->requested;
+	prefetch_sets.erase(local_path);
+	thread_load_mutex->unlock();
+
+	//requests must be balanced, this may block until the in-flight loads finish
+	for (Set<String>::Element *E = requested.front(); E; E = E->next()) {
+		load_threaded_get(E->get());
+	}
+}
+
+void ResourceLoader::clear_prefetch_sets() {
+	thread_load_mutex->lock();
+	List<String> prefetched;
+	prefetch_sets.get_key_list(&prefetched);
+	thread_load_mutex->unlock();
+
+	for (List<String>::Element *E = prefetched.front(); E; E = E->next()) {
+		prefetch_release(E->get());
+	}
+}
+
 RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p_no_cache, Error *r_error) {
 	if (r_error) {
 		*r_error = ERR_CANT_OPEN;
@@ -1135,6 +1291,8 @@ int ResourceLoader::thread_waiting_count = 0;
 int ResourceLoader::thread_suspended_count = 0;
 int ResourceLoader::thread_load_max = 0;
 
+HashMap<String, ResourceLoader::PrefetchSet> ResourceLoader::prefetch_sets;
+
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
 HashMap<String, String> ResourceLoader::path_remaps;
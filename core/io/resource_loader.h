@@ -48,6 +48,7 @@ public:
 	virtual void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const;
 	virtual bool recognize_path(const String &p_path, const String &p_for_type = String()) const;
 	virtual bool handles_type(const String &p_type) const;
+	virtual bool handles_sub_resources() const { return false; } // Can load "path::subindex" alone.
 	virtual String get_resource_type(const String &p_path) const;
 	virtual void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types = false);
 	virtual Error rename_dependencies(const String &p_path, const Map<String, String> &p_map);
@@ -135,11 +136,28 @@ private:
 
 	static float _dependency_get_progress(const String &p_path);
 
+	struct PrefetchSet {
+		uint64_t memory_used = 0;
+		int total = 0;
+		Set<String> requested; //requested via load_threaded_request, not harvested yet
+		Map<String, RES> resources; //held so they remain in ResourceCache
+	};
+
+	static HashMap<String, PrefetchSet> prefetch_sets;
+
+	static uint64_t _prefetch_estimate_size(const String &p_local_path);
+	static void _prefetch_harvest(PrefetchSet &p_set);
+
 public:
 	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, const String &p_source_resource = String());
 	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = nullptr);
 	static RES load_threaded_get(const String &p_path, Error *r_error = nullptr);
 
+	static Error prefetch_request(const String &p_path, uint64_t p_memory_budget = 0);
+	static ThreadLoadStatus prefetch_get_status(const String &p_path, float *r_progress = nullptr);
+	static void prefetch_release(const String &p_path);
+	static void clear_prefetch_sets();
+
 	static RES load(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = nullptr);
 	static bool exists(const String &p_path, const String &p_type_hint = "");
 
@@ -69,6 +69,7 @@ void AStar::add_point(int p_id, const Vector3 &p_pos, real_t p_weight_scale) {
 		pt->closed_pass = 0;
 		pt->enabled = true;
 		points.set(p_id, pt);
+		compact_connections_dirty = true;
 	} else {
 		found_pt->pos = p_pos;
 		found_pt->weight_scale = p_weight_scale;
@@ -132,6 +133,7 @@ void AStar::remove_point(int p_id) {
 	memdelete(p);
 	points.remove(p_id);
 	last_free_id = p_id;
+	compact_connections_dirty = true;
 }
 
 void AStar::connect_points(int p_id, int p_with_id, bool bidirectional) {
@@ -146,6 +148,7 @@ void AStar::connect_points(int p_id, int p_with_id, bool bidirectional) {
 	ERR_FAIL_COND(!to_exists);
 
 	a->neighbours.set(b->id, b);
+	compact_connections_dirty = true;
 
 	if (bidirectional) {
 		b->neighbours.set(a->id, a);
@@ -191,6 +194,7 @@ void AStar::disconnect_points(int p_id, int p_with_id, bool bidirectional) {
 		s.direction = (element->get().direction & ~remove_direction);
 
 		a->neighbours.remove(b->id);
+		compact_connections_dirty = true;
 		if (bidirectional) {
 			b->neighbours.remove(a->id);
 			if (element->get().direction != Segment::BIDIRECTIONAL) {
@@ -255,6 +259,8 @@ void AStar::clear() {
 	}
 	segments.clear();
 	points.clear();
+	compact_neighbours.clear();
+	compact_connections_dirty = true;
 }
 
 int AStar::get_point_count() const {
@@ -271,6 +277,18 @@ void AStar::reserve_space(int p_num_nodes) {
 	points.reserve(p_num_nodes);
 }
 
+void AStar::set_compact_connections_enabled(bool p_enabled) {
+	compact_connections_enabled = p_enabled;
+	if (!compact_connections_enabled) {
+		compact_neighbours.reset();
+		compact_connections_dirty = true;
+	}
+}
+
+bool AStar::is_compact_connections_enabled() const {
+	return compact_connections_enabled;
+}
+
 int AStar::get_closest_point(const Vector3 &p_point, bool p_include_disabled) const {
 	int closest_id = -1;
 	real_t closest_dist = 1e20;
@@ -325,6 +343,108 @@ Vector3 AStar::get_closest_position_in_segment(const Vector3 &p_point) const {
 	return closest_point;
 }
 
+void AStar::OpenList::_move_up(uint32_t p_index, Point *p_point) {
+	SortPoints compare;
+	while (p_index > 0) {
+		uint32_t parent = (p_index - 1) / 2;
+		if (!compare(heap[parent], p_point)) {
+			break;
+		}
+		heap[p_index] = heap[parent];
+		heap[p_index]->open_list_index = p_index;
+		p_index = parent;
+	}
+	heap[p_index] = p_point;
+	p_point->open_list_index = p_index;
+}
+
+void AStar::OpenList::_move_down(uint32_t p_index, Point *p_point) {
+	SortPoints compare;
+	const uint32_t size = heap.size();
+	while (true) {
+		uint32_t child = p_index * 2 + 1;
+		if (child >= size) {
+			break;
+		}
+		if (child + 1 < size && compare(heap[child], heap[child + 1])) {
+			child++;
+		}
+		if (!compare(p_point, heap[child])) {
+			break;
+		}
+		heap[p_index] = heap[child];
+		heap[p_index]->open_list_index = p_index;
+		p_index = child;
+	}
+	heap[p_index] = p_point;
+	p_point->open_list_index = p_index;
+}
+
+void AStar::OpenList::push(Point *p_point) {
+	heap.push_back(p_point);
+	_move_up(heap.size() - 1, p_point);
+}
+
+void AStar::OpenList::pop() {
+	Point *last = heap[heap.size() - 1];
+	heap.resize(heap.size() - 1);
+	if (heap.size() > 0) {
+		_move_down(0, last);
+	}
+}
+
+void AStar::OpenList::decrease_key(Point *p_point) {
+	_move_up(p_point->open_list_index, p_point);
+}
+
+void AStar::_update_compact_connections() {
+	uint32_t neighbour_count = 0;
+	for (OAHashMap<int, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
+		neighbour_count += (*it.value)->neighbours.get_num_elements();
+	}
+
+	compact_neighbours.resize(neighbour_count);
+
+	uint32_t offset = 0;
+	for (OAHashMap<int, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
+		Point *p = *(it.value);
+		p->compact_neighbours_offset = offset;
+		for (OAHashMap<int, Point *>::Iterator n_it = p->neighbours.iter(); n_it.valid; n_it = p->neighbours.next_iter(n_it)) {
+			compact_neighbours[offset++] = *(n_it.value);
+		}
+		p->compact_neighbours_count = offset - p->compact_neighbours_offset;
+	}
+
+	compact_connections_dirty = false;
+}
+
+void AStar::_visit_neighbour(Point *p_point, Point *p_neighbour, Point *p_end_point) {
+	if (!p_neighbour->enabled || p_neighbour->closed_pass == pass) {
+		return;
+	}
+
+	real_t tentative_g_score = p_point->g_score + _compute_cost(p_point->id, p_neighbour->id) * p_neighbour->weight_scale;
+
+	bool new_point = false;
+
+	if (p_neighbour->open_pass != pass) { // The point wasn't inside the open list.
+		p_neighbour->open_pass = pass;
+		new_point = true;
+	} else if (tentative_g_score >= p_neighbour->g_score) { // The new path is worse than the previous.
+		return;
+	}
+
+	p_neighbour->prev_point = p_point;
+	p_neighbour->g_score = tentative_g_score;
+	p_neighbour->f_score = p_neighbour->g_score + _estimate_cost(p_neighbour->id, p_end_point->id);
+
+	if (new_point) {
+		open_list.push(p_neighbour);
+	} else {
+		open_list.decrease_key(p_neighbour);
+	}
+}
+
 bool AStar::_solve(Point *begin_point, Point *end_point) {
 	pass++;
 
@@ -334,52 +454,37 @@ bool AStar::_solve(Point *begin_point, Point *end_point) {
 
 	bool found_route = false;
 
-	Vector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	if (compact_connections_enabled && compact_connections_dirty) {
+		_update_compact_connections();
+	}
+
+	open_list.clear();
 
 	begin_point->g_score = 0;
 	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
+	begin_point->open_pass = pass;
+	open_list.push(begin_point);
 
-	while (!open_list.empty()) {
-		Point *p = open_list[0]; // The currently processed point
+	while (!open_list.is_empty()) {
+		Point *p = open_list.get_top(); // The currently processed point
 
 		if (p == end_point) {
 			found_route = true;
 			break;
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptrw()); // Remove the current point from the open list
-		open_list.remove(open_list.size() - 1);
+		open_list.pop(); // Remove the current point from the open list
 		p->closed_pass = pass; // Mark the point as closed
 
-		for (OAHashMap<int, Point *>::Iterator it = p->neighbours.iter(); it.valid; it = p->neighbours.next_iter(it)) {
-			Point *e = *(it.value); // The neighbour point
-
-			if (!e->enabled || e->closed_pass == pass) {
-				continue;
+		// Without compact connections, walk the hash map in place rather than copying it for every expanded point.
+		if (compact_connections_enabled) {
+			Point *const *neighbours = compact_neighbours.ptr() + p->compact_neighbours_offset;
+			for (uint32_t i = 0; i < p->compact_neighbours_count; i++) {
+				_visit_neighbour(p, neighbours[i], end_point);
 			}
-
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
-
-			bool new_point = false;
-
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
-				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
-				continue;
-			}
-
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptrw());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptrw());
+		} else {
+			for (OAHashMap<int, Point *>::Iterator it = p->neighbours.iter(); it.valid; it = p->neighbours.next_iter(it)) {
+				_visit_neighbour(p, *(it.value), end_point);
 			}
 		}
 	}
@@ -557,6 +662,9 @@ void AStar::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("reserve_space", "num_nodes"), &AStar::reserve_space);
 	ClassDB::bind_method(D_METHOD("clear"), &AStar::clear);
 
+	ClassDB::bind_method(D_METHOD("set_compact_connections_enabled", "enabled"), &AStar::set_compact_connections_enabled);
+	ClassDB::bind_method(D_METHOD("is_compact_connections_enabled"), &AStar::is_compact_connections_enabled);
+
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_position", "include_disabled"), &AStar::get_closest_point, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_closest_position_in_segment", "to_position"), &AStar::get_closest_position_in_segment);
 
@@ -650,6 +758,14 @@ void AStar2D::reserve_space(int p_num_nodes) {
 	astar.reserve_space(p_num_nodes);
 }
 
+void AStar2D::set_compact_connections_enabled(bool p_enabled) {
+	astar.set_compact_connections_enabled(p_enabled);
+}
+
+bool AStar2D::is_compact_connections_enabled() const {
+	return astar.is_compact_connections_enabled();
+}
+
 int AStar2D::get_closest_point(const Vector2 &p_point, bool p_include_disabled) const {
 	return astar.get_closest_point(Vector3(p_point.x, p_point.y, 0), p_include_disabled);
 }
@@ -789,6 +905,33 @@ Vector<int> AStar2D::get_id_path(int p_from_id, int p_to_id) {
 	return path;
 }
 
+void AStar2D::_visit_neighbour(AStar::Point *p_point, AStar::Point *p_neighbour, AStar::Point *p_end_point) {
+	if (!p_neighbour->enabled || p_neighbour->closed_pass == astar.pass) {
+		return;
+	}
+
+	real_t tentative_g_score = p_point->g_score + _compute_cost(p_point->id, p_neighbour->id) * p_neighbour->weight_scale;
+
+	bool new_point = false;
+
+	if (p_neighbour->open_pass != astar.pass) { // The point wasn't inside the open list.
+		p_neighbour->open_pass = astar.pass;
+		new_point = true;
+	} else if (tentative_g_score >= p_neighbour->g_score) { // The new path is worse than the previous.
+		return;
+	}
+
+	p_neighbour->prev_point = p_point;
+	p_neighbour->g_score = tentative_g_score;
+	p_neighbour->f_score = p_neighbour->g_score + _estimate_cost(p_neighbour->id, p_end_point->id);
+
+	if (new_point) {
+		astar.open_list.push(p_neighbour);
+	} else {
+		astar.open_list.decrease_key(p_neighbour);
+	}
+}
+
 bool AStar2D::_solve(AStar::Point *begin_point, AStar::Point *end_point) {
 	astar.pass++;
 
@@ -798,52 +941,37 @@ bool AStar2D::_solve(AStar::Point *begin_point, AStar::Point *end_point) {
 
 	bool found_route = false;
 
-	Vector<AStar::Point *> open_list;
-	SortArray<AStar::Point *, AStar::SortPoints> sorter;
+	if (astar.compact_connections_enabled && astar.compact_connections_dirty) {
+		astar._update_compact_connections();
+	}
+
+	astar.open_list.clear();
 
 	begin_point->g_score = 0;
 	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
+	begin_point->open_pass = astar.pass;
+	astar.open_list.push(begin_point);
 
-	while (!open_list.empty()) {
-		AStar::Point *p = open_list[0]; // The currently processed point
+	while (!astar.open_list.is_empty()) {
+		AStar::Point *p = astar.open_list.get_top(); // The currently processed point
 
 		if (p == end_point) {
 			found_route = true;
 			break;
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptrw()); // Remove the current point from the open list
-		open_list.remove(open_list.size() - 1);
+		astar.open_list.pop(); // Remove the current point from the open list
 		p->closed_pass = astar.pass; // Mark the point as closed
 
-		for (OAHashMap<int, AStar::Point *>::Iterator it = p->neighbours.iter(); it.valid; it = p->neighbours.next_iter(it)) {
-			AStar::Point *e = *(it.value); // The neighbour point
-
-			if (!e->enabled || e->closed_pass == astar.pass) {
-				continue;
-			}
-
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
-
-			bool new_point = false;
-
-			if (e->open_pass != astar.pass) { // The point wasn't inside the open list.
-				e->open_pass = astar.pass;
-				open_list.push_back(e);
-				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
-				continue;
+		// Without compact connections, walk the hash map in place rather than copying it for every expanded point.
+		if (astar.compact_connections_enabled) {
+			AStar::Point *const *neighbours = astar.compact_neighbours.ptr() + p->compact_neighbours_offset;
+			for (uint32_t i = 0; i < p->compact_neighbours_count; i++) {
+				_visit_neighbour(p, neighbours[i], end_point);
 			}
-
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptrw());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptrw());
+		} else {
+			for (OAHashMap<int, AStar::Point *>::Iterator it = p->neighbours.iter(); it.valid; it = p->neighbours.next_iter(it)) {
+				_visit_neighbour(p, *(it.value), end_point);
 			}
 		}
 	}
@@ -875,6 +1003,9 @@ void AStar2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("reserve_space", "num_nodes"), &AStar2D::reserve_space);
 	ClassDB::bind_method(D_METHOD("clear"), &AStar2D::clear);
 
+	ClassDB::bind_method(D_METHOD("set_compact_connections_enabled", "enabled"), &AStar2D::set_compact_connections_enabled);
+	ClassDB::bind_method(D_METHOD("is_compact_connections_enabled"), &AStar2D::is_compact_connections_enabled);
+
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_position", "include_disabled"), &AStar2D::get_closest_point, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_closest_position_in_segment", "to_position"), &AStar2D::get_closest_position_in_segment);
 
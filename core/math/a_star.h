@@ -32,6 +32,7 @@
 #define A_STAR_H
 
 #include "core/object/reference.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
 
 /**
@@ -61,6 +62,11 @@ class AStar : public Reference {
 		real_t f_score = 0;
 		uint64_t open_pass = 0;
 		uint64_t closed_pass = 0;
+		uint32_t open_list_index = 0;
+
+		// Range of the neighbours in the compact connections.
+		uint32_t compact_neighbours_offset = 0;
+		uint32_t compact_neighbours_count = 0;
 	};
 
 	struct SortPoints {
@@ -75,6 +81,23 @@ class AStar : public Reference {
 		}
 	};
 
+	// Binary heap keeping the position of each point, so a point whose score
+	// improved is moved up in O(log n) instead of being searched for.
+	struct OpenList {
+		LocalVector<Point *> heap;
+
+		void _move_up(uint32_t p_index, Point *p_point);
+		void _move_down(uint32_t p_index, Point *p_point);
+
+		_FORCE_INLINE_ bool is_empty() const { return heap.size() == 0; }
+		_FORCE_INLINE_ Point *get_top() const { return heap[0]; }
+		_FORCE_INLINE_ void clear() { heap.clear(); }
+
+		void push(Point *p_point);
+		void pop();
+		void decrease_key(Point *p_point);
+	};
+
 	struct Segment {
 		union {
 			struct {
@@ -114,6 +137,17 @@ class AStar : public Reference {
 	OAHashMap<int, Point *> points;
 	Set<Segment> segments;
 
+	OpenList open_list;
+
+	// All the neighbours stored contiguously, point after point, used instead
+	// of the per point hash maps when the graph doesn't change between queries.
+	bool compact_connections_enabled = false;
+	bool compact_connections_dirty = true;
+	LocalVector<Point *> compact_neighbours;
+
+	void _update_compact_connections();
+	_FORCE_INLINE_ void _visit_neighbour(Point *p_point, Point *p_neighbour, Point *p_end_point);
+
 	bool _solve(Point *begin_point, Point *end_point);
 
 protected:
@@ -147,6 +181,9 @@ public:
 	void reserve_space(int p_num_nodes);
 	void clear();
 
+	void set_compact_connections_enabled(bool p_enabled);
+	bool is_compact_connections_enabled() const;
+
 	int get_closest_point(const Vector3 &p_point, bool p_include_disabled = false) const;
 	Vector3 get_closest_position_in_segment(const Vector3 &p_point) const;
 
@@ -161,6 +198,7 @@ class AStar2D : public Reference {
 	GDCLASS(AStar2D, Reference);
 	AStar astar;
 
+	_FORCE_INLINE_ void _visit_neighbour(AStar::Point *p_point, AStar::Point *p_neighbour, AStar::Point *p_end_point);
 	bool _solve(AStar::Point *begin_point, AStar::Point *end_point);
 
 protected:
@@ -194,6 +232,9 @@ public:
 	void reserve_space(int p_num_nodes);
 	void clear();
 
+	void set_compact_connections_enabled(bool p_enabled);
+	bool is_compact_connections_enabled() const;
+
 	int get_closest_point(const Vector2 &p_point, bool p_include_disabled = false) const;
 	Vector2 get_closest_position_in_segment(const Vector2 &p_point) const;
 
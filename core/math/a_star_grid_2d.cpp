@@ -0,0 +1,678 @@
+/*************************************************************************/
+/*  a_star_grid_2d.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "a_star_grid_2d.h"
+
+static const real_t SQRT2 = Math_SQRT2;
+
+void AStarGrid2D::set_size(const Size2i &p_size) {
+	ERR_FAIL_COND(p_size.x < 0 || p_size.y < 0);
+	size = p_size;
+
+	// Resizing discards the solid points, as their cells don't map to the same coordinates anymore.
+	const uint32_t cell_count = size.x * size.y;
+	solid_mask.resize((cell_count + 31) / 32);
+	for (uint32_t i = 0; i < solid_mask.size(); i++) {
+		solid_mask[i] = 0;
+	}
+
+	g_scores.reset();
+	f_scores.reset();
+	prev_cells.reset();
+	open_passes.reset();
+	closed_passes.reset();
+	open_list_indices.reset();
+	open_list.reset();
+}
+
+Size2i AStarGrid2D::get_size() const {
+	return size;
+}
+
+void AStarGrid2D::set_offset(const Vector2 &p_offset) {
+	offset = p_offset;
+}
+
+Vector2 AStarGrid2D::get_offset() const {
+	return offset;
+}
+
+void AStarGrid2D::set_cell_size(const Size2 &p_cell_size) {
+	cell_size = p_cell_size;
+}
+
+Size2 AStarGrid2D::get_cell_size() const {
+	return cell_size;
+}
+
+void AStarGrid2D::set_diagonal_mode(DiagonalMode p_diagonal_mode) {
+	ERR_FAIL_INDEX((int)p_diagonal_mode, (int)DIAGONAL_MODE_MAX);
+	diagonal_mode = p_diagonal_mode;
+}
+
+AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
+	return diagonal_mode;
+}
+
+void AStarGrid2D::set_jumping_enabled(bool p_enabled) {
+	jumping_enabled = p_enabled;
+}
+
+bool AStarGrid2D::is_jumping_enabled() const {
+	return jumping_enabled;
+}
+
+bool AStarGrid2D::is_in_bounds(int p_x, int p_y) const {
+	return p_x >= 0 && p_x < size.x && p_y >= 0 && p_y < size.y;
+}
+
+bool AStarGrid2D::is_in_boundsv(const Vector2i &p_id) const {
+	return is_in_bounds(p_id.x, p_id.y);
+}
+
+void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
+	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set if point is solid. Point out of bounds (%s/%s, %s/%s).", p_id.x, size.x, p_id.y, size.y));
+	const uint32_t cell = _get_cell(p_id.x, p_id.y);
+	if (p_solid) {
+		solid_mask[cell >> 5] |= 1u << (cell & 31);
+	} else {
+		solid_mask[cell >> 5] &= ~(1u << (cell & 31));
+	}
+}
+
+bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), false, vformat("Can't get if point is solid. Point out of bounds (%s/%s, %s/%s).", p_id.x, size.x, p_id.y, size.y));
+	return !_is_walkable(p_id.x, p_id.y);
+}
+
+Vector2 AStarGrid2D::get_point_position(const Vector2i &p_id) const {
+	return offset + Vector2(p_id.x, p_id.y) * cell_size;
+}
+
+void AStarGrid2D::clear() {
+	set_size(Size2i());
+}
+
+bool AStarGrid2D::_can_move_diagonally(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const {
+	switch (diagonal_mode) {
+		case DIAGONAL_MODE_ALWAYS:
+			return true;
+		case DIAGONAL_MODE_NEVER:
+			return false;
+		case DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE:
+			return _is_walkable(p_x + p_dx, p_y) || _is_walkable(p_x, p_y + p_dy);
+		case DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES:
+			return _is_walkable(p_x + p_dx, p_y) && _is_walkable(p_x, p_y + p_dy);
+		default:
+			return false;
+	}
+}
+
+real_t AStarGrid2D::_get_cost(int32_t p_from_x, int32_t p_from_y, int32_t p_to_x, int32_t p_to_y) const {
+	// Exact along straight and diagonal lines, which are the only moves between
+	// two consecutive points of a path (jump points included), and admissible
+	// as a heuristic otherwise.
+	const int32_t dx = ABS(p_to_x - p_from_x);
+	const int32_t dy = ABS(p_to_y - p_from_y);
+	if (diagonal_mode == DIAGONAL_MODE_NEVER) {
+		return dx + dy;
+	}
+	return MIN(dx, dy) * SQRT2 + ABS(dx - dy);
+}
+
+bool AStarGrid2D::_is_cell_better(uint32_t p_cell, uint32_t p_than_cell) const {
+	if (f_scores[p_cell] < f_scores[p_than_cell]) {
+		return true;
+	} else if (f_scores[p_cell] > f_scores[p_than_cell]) {
+		return false;
+	} else {
+		return g_scores[p_cell] > g_scores[p_than_cell]; // If the f_costs are the same then prioritize the points that are further away from the start.
+	}
+}
+
+void AStarGrid2D::_open_list_move_up(uint32_t p_index, uint32_t p_cell) {
+	while (p_index > 0) {
+		uint32_t parent = (p_index - 1) / 2;
+		if (!_is_cell_better(p_cell, open_list[parent])) {
+			break;
+		}
+		open_list[p_index] = open_list[parent];
+		open_list_indices[open_list[p_index]] = p_index;
+		p_index = parent;
+	}
+	open_list[p_index] = p_cell;
+	open_list_indices[p_cell] = p_index;
+}
+
+void AStarGrid2D::_open_list_move_down(uint32_t p_index, uint32_t p_cell) {
+	const uint32_t open_size = open_list.size();
+	while (true) {
+		uint32_t child = p_index * 2 + 1;
+		if (child >= open_size) {
+			break;
+		}
+		if (child + 1 < open_size && _is_cell_better(open_list[child + 1], open_list[child])) {
+			child++;
+		}
+		if (!_is_cell_better(open_list[child], p_cell)) {
+			break;
+		}
+		open_list[p_index] = open_list[child];
+		open_list_indices[open_list[p_index]] = p_index;
+		p_index = child;
+	}
+	open_list[p_index] = p_cell;
+	open_list_indices[p_cell] = p_index;
+}
+
+void AStarGrid2D::_open_list_push(uint32_t p_cell) {
+	open_list.push_back(p_cell);
+	_open_list_move_up(open_list.size() - 1, p_cell);
+}
+
+void AStarGrid2D::_open_list_pop() {
+	const uint32_t last = open_list[open_list.size() - 1];
+	open_list.resize(open_list.size() - 1);
+	if (open_list.size() > 0) {
+		_open_list_move_down(0, last);
+	}
+}
+
+int AStarGrid2D::_get_neighbours(int32_t p_x, int32_t p_y, Vector2i *r_neighbours) const {
+	static const int32_t directions[8][2] = {
+		{ 1, 0 },
+		{ 0, 1 },
+		{ -1, 0 },
+		{ 0, -1 },
+		{ 1, 1 },
+		{ -1, 1 },
+		{ -1, -1 },
+		{ 1, -1 },
+	};
+
+	int count = 0;
+	for (int i = 0; i < 8; i++) {
+		const int32_t dx = directions[i][0];
+		const int32_t dy = directions[i][1];
+		if (!_is_walkable(p_x + dx, p_y + dy)) {
+			continue;
+		}
+		if (dx != 0 && dy != 0 && !_can_move_diagonally(p_x, p_y, dx, dy)) {
+			continue;
+		}
+		r_neighbours[count++] = Vector2i(p_x + dx, p_y + dy);
+	}
+	return count;
+}
+
+int AStarGrid2D::_get_jump_neighbours(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, Vector2i *r_neighbours) const {
+	// Only the neighbours which can't be reached more cheaply without passing
+	// through this point, given the direction it was reached from. The cells
+	// aren't required to be walkable, _jump() rejects the solid ones.
+	int count = 0;
+
+#define PUSH_NEIGHBOUR(m_x, m_y) r_neighbours[count++] = Vector2i(m_x, m_y)
+
+	switch (diagonal_mode) {
+		case DIAGONAL_MODE_ALWAYS: {
+			if (p_dx != 0 && p_dy != 0) {
+				PUSH_NEIGHBOUR(p_x, p_y + p_dy);
+				PUSH_NEIGHBOUR(p_x + p_dx, p_y);
+				PUSH_NEIGHBOUR(p_x + p_dx, p_y + p_dy);
+				if (!_is_walkable(p_x - p_dx, p_y)) {
+					PUSH_NEIGHBOUR(p_x - p_dx, p_y + p_dy);
+				}
+				if (!_is_walkable(p_x, p_y - p_dy)) {
+					PUSH_NEIGHBOUR(p_x + p_dx, p_y - p_dy);
+				}
+			} else if (p_dx != 0) {
+				PUSH_NEIGHBOUR(p_x + p_dx, p_y);
+				if (!_is_walkable(p_x, p_y + 1)) {
+					PUSH_NEIGHBOUR(p_x + p_dx, p_y + 1);
+				}
+				if (!_is_walkable(p_x, p_y - 1)) {
+					PUSH_NEIGHBOUR(p_x + p_dx, p_y - 1);
+				}
+			} else {
+				PUSH_NEIGHBOUR(p_x, p_y + p_dy);
+				if (!_is_walkable(p_x + 1, p_y)) {
+					PUSH_NEIGHBOUR(p_x + 1, p_y + p_dy);
+				}
+				if (!_is_walkable(p_x - 1, p_y)) {
+					PUSH_NEIGHBOUR(p_x - 1, p_y + p_dy);
+				}
+			}
+		} break;
+		case DIAGONAL_MODE_NEVER: {
+			if (p_dx != 0) {
+				PUSH_NEIGHBOUR(p_x + p_dx, p_y);
+				PUSH_NEIGHBOUR(p_x, p_y + 1);
+				PUSH_NEIGHBOUR(p_x, p_y - 1);
+			} else {
+				PUSH_NEIGHBOUR(p_x, p_y + p_dy);
+				PUSH_NEIGHBOUR(p_x + 1, p_y);
+				PUSH_NEIGHBOUR(p_x - 1, p_y);
+			}
+		} break;
+		case DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE: {
+			if (p_dx != 0 && p_dy != 0) {
+				const bool next_y_walkable = _is_walkable(p_x, p_y + p_dy);
+				const bool next_x_walkable = _is_walkable(p_x + p_dx, p_y);
+				PUSH_NEIGHBOUR(p_x, p_y + p_dy);
+				PUSH_NEIGHBOUR(p_x + p_dx, p_y);
+				if (next_x_walkable || next_y_walkable) {
+					PUSH_NEIGHBOUR(p_x + p_dx, p_y + p_dy);
+				}
+				if (next_y_walkable && !_is_walkable(p_x - p_dx, p_y)) {
+					PUSH_NEIGHBOUR(p_x - p_dx, p_y + p_dy);
+				}
+				if (next_x_walkable && !_is_walkable(p_x, p_y - p_dy)) {
+					PUSH_NEIGHBOUR(p_x + p_dx, p_y - p_dy);
+				}
+			} else if (p_dx != 0) {
+				if (_is_walkable(p_x + p_dx, p_y)) {
+					PUSH_NEIGHBOUR(p_x + p_dx, p_y);
+					if (!_is_walkable(p_x, p_y + 1)) {
+						PUSH_NEIGHBOUR(p_x + p_dx, p_y + 1);
+					}
+					if (!_is_walkable(p_x, p_y - 1)) {
+						PUSH_NEIGHBOUR(p_x + p_dx, p_y - 1);
+					}
+				}
+			} else {
+				if (_is_walkable(p_x, p_y + p_dy)) {
+					PUSH_NEIGHBOUR(p_x, p_y + p_dy);
+					if (!_is_walkable(p_x + 1, p_y)) {
+						PUSH_NEIGHBOUR(p_x + 1, p_y + p_dy);
+					}
+					if (!_is_walkable(p_x - 1, p_y)) {
+						PUSH_NEIGHBOUR(p_x - 1, p_y + p_dy);
+					}
+				}
+			}
+		} break;
+		case DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES: {
+			if (p_dx != 0 && p_dy != 0) {
+				const bool next_y_walkable = _is_walkable(p_x, p_y + p_dy);
+				const bool next_x_walkable = _is_walkable(p_x + p_dx, p_y);
+				PUSH_NEIGHBOUR(p_x, p_y + p_dy);
+				PUSH_NEIGHBOUR(p_x + p_dx, p_y);
+				if (next_x_walkable && next_y_walkable) {
+					PUSH_NEIGHBOUR(p_x + p_dx, p_y + p_dy);
+				}
+			} else if (p_dx != 0) {
+				const bool next_walkable = _is_walkable(p_x + p_dx, p_y);
+				const bool top_walkable = _is_walkable(p_x, p_y + 1);
+				const bool bottom_walkable = _is_walkable(p_x, p_y - 1);
+				if (next_walkable) {
+					PUSH_NEIGHBOUR(p_x + p_dx, p_y);
+					if (top_walkable) {
+						PUSH_NEIGHBOUR(p_x + p_dx, p_y + 1);
+					}
+					if (bottom_walkable) {
+						PUSH_NEIGHBOUR(p_x + p_dx, p_y - 1);
+					}
+				}
+				PUSH_NEIGHBOUR(p_x, p_y + 1);
+				PUSH_NEIGHBOUR(p_x, p_y - 1);
+			} else {
+				const bool next_walkable = _is_walkable(p_x, p_y + p_dy);
+				const bool right_walkable = _is_walkable(p_x + 1, p_y);
+				const bool left_walkable = _is_walkable(p_x - 1, p_y);
+				if (next_walkable) {
+					PUSH_NEIGHBOUR(p_x, p_y + p_dy);
+					if (right_walkable) {
+						PUSH_NEIGHBOUR(p_x + 1, p_y + p_dy);
+					}
+					if (left_walkable) {
+						PUSH_NEIGHBOUR(p_x - 1, p_y + p_dy);
+					}
+				}
+				PUSH_NEIGHBOUR(p_x + 1, p_y);
+				PUSH_NEIGHBOUR(p_x - 1, p_y);
+			}
+		} break;
+		default:
+			break;
+	}
+
+#undef PUSH_NEIGHBOUR
+
+	return count;
+}
+
+int32_t AStarGrid2D::_jump_horizontally(int32_t p_x, int32_t p_y, int32_t p_dx, const Vector2i &p_end) {
+	// Every cell scanned before reaching the jump point (or an obstacle) leads to
+	// the same result, so it's stored for all of them and later scans stop at the
+	// first cell already visited during this pass. Otherwise, the scans done at
+	// each step of a vertical jump would cost up to the width of the grid.
+	const uint32_t side = p_dx > 0 ? 0 : 1;
+	int32_t x = p_x;
+	int32_t jump_x = -1;
+
+	while (_is_walkable(x, p_y)) {
+		const uint32_t index = _get_cell(x, p_y) * 2 + side;
+		if (horizontal_jump_passes[index] == pass) {
+			jump_x = horizontal_jumps[index];
+			break;
+		}
+		if ((x == p_end.x && p_y == p_end.y) ||
+				(_is_walkable(x, p_y - 1) && !_is_walkable(x - p_dx, p_y - 1)) ||
+				(_is_walkable(x, p_y + 1) && !_is_walkable(x - p_dx, p_y + 1))) {
+			jump_x = x;
+			break;
+		}
+		x += p_dx;
+	}
+
+	for (int32_t i = p_x; i != x; i += p_dx) {
+		const uint32_t index = _get_cell(i, p_y) * 2 + side;
+		horizontal_jumps[index] = jump_x;
+		horizontal_jump_passes[index] = pass;
+	}
+
+	return jump_x;
+}
+
+bool AStarGrid2D::_jump(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, const Vector2i &p_end, Vector2i &r_jump_point) {
+	// Walks from (p_x, p_y) in the given direction until reaching a point with
+	// a forced neighbour, the end or an obstacle. When moving diagonally, the
+	// straight directions are scanned at each step too.
+	if (diagonal_mode == DIAGONAL_MODE_NEVER && p_dy == 0) {
+		const int32_t jump_x = _jump_horizontally(p_x, p_y, p_dx, p_end);
+		if (jump_x < 0) {
+			return false;
+		}
+		r_jump_point = Vector2i(jump_x, p_y);
+		return true;
+	}
+
+	int32_t x = p_x;
+	int32_t y = p_y;
+	Vector2i unused;
+
+	while (true) {
+		if (!_is_walkable(x, y)) {
+			return false;
+		}
+		if (x == p_end.x && y == p_end.y) {
+			r_jump_point = Vector2i(x, y);
+			return true;
+		}
+
+		bool forced = false;
+		if (p_dx != 0 && p_dy != 0) {
+			if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
+				forced = (_is_walkable(x - p_dx, y + p_dy) && !_is_walkable(x - p_dx, y)) ||
+						 (_is_walkable(x + p_dx, y - p_dy) && !_is_walkable(x, y - p_dy));
+			}
+			forced = forced || _jump(x + p_dx, y, p_dx, 0, p_end, unused) || _jump(x, y + p_dy, 0, p_dy, p_end, unused);
+		} else if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
+			if (p_dx != 0) {
+				forced = (_is_walkable(x + p_dx, y + 1) && !_is_walkable(x, y + 1)) ||
+						 (_is_walkable(x + p_dx, y - 1) && !_is_walkable(x, y - 1));
+			} else {
+				forced = (_is_walkable(x + 1, y + p_dy) && !_is_walkable(x + 1, y)) ||
+						 (_is_walkable(x - 1, y + p_dy) && !_is_walkable(x - 1, y));
+			}
+		} else {
+			if (p_dx != 0) {
+				forced = (_is_walkable(x, y - 1) && !_is_walkable(x - p_dx, y - 1)) ||
+						 (_is_walkable(x, y + 1) && !_is_walkable(x - p_dx, y + 1));
+			} else {
+				forced = (_is_walkable(x - 1, y) && !_is_walkable(x - 1, y - p_dy)) ||
+						 (_is_walkable(x + 1, y) && !_is_walkable(x + 1, y - p_dy));
+				if (diagonal_mode == DIAGONAL_MODE_NEVER) {
+					// Without diagonals, turning happens only at jump points, so horizontal
+					// jump points must be looked for while moving vertically.
+					forced = forced || _jump_horizontally(x + 1, y, 1, p_end) >= 0 || _jump_horizontally(x - 1, y, -1, p_end) >= 0;
+				}
+			}
+		}
+
+		if (forced) {
+			r_jump_point = Vector2i(x, y);
+			return true;
+		}
+
+		if (p_dx != 0 && p_dy != 0 && !_can_move_diagonally(x, y, p_dx, p_dy)) {
+			return false;
+		}
+
+		x += p_dx;
+		y += p_dy;
+	}
+}
+
+bool AStarGrid2D::_solve(const Vector2i &p_from, const Vector2i &p_to) {
+	if (!_is_walkable(p_to.x, p_to.y)) {
+		return false;
+	}
+
+	const uint32_t cell_count = size.x * size.y;
+	if (g_scores.size() != cell_count) {
+		g_scores.resize(cell_count);
+		f_scores.resize(cell_count);
+		prev_cells.resize(cell_count);
+		open_passes.resize(cell_count);
+		closed_passes.resize(cell_count);
+		open_list_indices.resize(cell_count);
+		pass = UINT32_MAX; // Forces the passes to be cleared below.
+	}
+
+	if (jumping_enabled && diagonal_mode == DIAGONAL_MODE_NEVER && horizontal_jumps.size() != cell_count * 2) {
+		horizontal_jumps.resize(cell_count * 2);
+		horizontal_jump_passes.resize(cell_count * 2);
+		for (uint32_t i = 0; i < cell_count * 2; i++) {
+			horizontal_jump_passes[i] = 0;
+		}
+	}
+
+	pass++;
+	if (pass == 0 || pass == UINT32_MAX) {
+		for (uint32_t i = 0; i < cell_count; i++) {
+			open_passes[i] = 0;
+			closed_passes[i] = 0;
+		}
+		for (uint32_t i = 0; i < horizontal_jump_passes.size(); i++) {
+			horizontal_jump_passes[i] = 0;
+		}
+		pass = 1;
+	}
+
+	open_list.clear();
+
+	const uint32_t begin_cell = _get_cell(p_from.x, p_from.y);
+	const uint32_t end_cell = _get_cell(p_to.x, p_to.y);
+
+	g_scores[begin_cell] = 0;
+	f_scores[begin_cell] = _get_cost(p_from.x, p_from.y, p_to.x, p_to.y);
+	prev_cells[begin_cell] = -1;
+	open_passes[begin_cell] = pass;
+	_open_list_push(begin_cell);
+
+	Vector2i neighbours[8];
+
+	while (open_list.size() > 0) {
+		const uint32_t cell = open_list[0]; // The currently processed point
+
+		if (cell == end_cell) {
+			return true;
+		}
+
+		_open_list_pop(); // Remove the current point from the open list
+		closed_passes[cell] = pass; // Mark the point as closed
+
+		const int32_t x = cell % size.x;
+		const int32_t y = cell / size.x;
+
+		int neighbour_count;
+		if (jumping_enabled && prev_cells[cell] >= 0) {
+			const int32_t prev_x = prev_cells[cell] % size.x;
+			const int32_t prev_y = prev_cells[cell] / size.x;
+			neighbour_count = _get_jump_neighbours(x, y, SGN(x - prev_x), SGN(y - prev_y), neighbours);
+		} else {
+			neighbour_count = _get_neighbours(x, y, neighbours);
+		}
+
+		for (int i = 0; i < neighbour_count; i++) {
+			Vector2i e = neighbours[i]; // The neighbour point
+
+			if (jumping_enabled && !_jump(e.x, e.y, e.x - x, e.y - y, p_to, e)) {
+				continue;
+			}
+
+			const uint32_t e_cell = _get_cell(e.x, e.y);
+			if (closed_passes[e_cell] == pass) {
+				continue;
+			}
+
+			const real_t tentative_g_score = g_scores[cell] + _get_cost(x, y, e.x, e.y);
+
+			const bool new_point = open_passes[e_cell] != pass;
+			if (!new_point && tentative_g_score >= g_scores[e_cell]) { // The new path is worse than the previous.
+				continue;
+			}
+
+			prev_cells[e_cell] = cell;
+			g_scores[e_cell] = tentative_g_score;
+			f_scores[e_cell] = tentative_g_score + _get_cost(e.x, e.y, p_to.x, p_to.y);
+
+			if (new_point) {
+				open_passes[e_cell] = pass;
+				_open_list_push(e_cell);
+			} else {
+				_open_list_move_up(open_list_indices[e_cell], e_cell);
+			}
+		}
+	}
+
+	return false;
+}
+
+Vector<Vector2i> AStarGrid2D::_get_cell_path(const Vector2i &p_from, const Vector2i &p_to) {
+	Vector<Vector2i> path;
+
+	if (p_from == p_to) {
+		path.push_back(p_from);
+		return path;
+	}
+
+	if (!_solve(p_from, p_to)) {
+		return path;
+	}
+
+	// Consecutive points are on a straight or diagonal line, which is filled
+	// in when the points were found by jumping.
+	const int32_t begin_cell = _get_cell(p_from.x, p_from.y);
+	int32_t cell = _get_cell(p_to.x, p_to.y);
+	while (cell != begin_cell) {
+		const int32_t prev_cell = prev_cells[cell];
+		const Vector2i to(cell % size.x, cell / size.x);
+		const Vector2i from(prev_cell % size.x, prev_cell / size.x);
+		const Vector2i step(SGN(from.x - to.x), SGN(from.y - to.y));
+		for (Vector2i p = to; p != from; p += step) {
+			path.push_back(p);
+		}
+		cell = prev_cell;
+	}
+	path.push_back(p_from);
+	path.invert();
+
+	return path;
+}
+
+Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from, const Vector2i &p_to) {
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from), Vector<Vector2>(), vformat("Can't get point path. Point out of bounds (%s/%s, %s/%s).", p_from.x, size.x, p_from.y, size.y));
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to), Vector<Vector2>(), vformat("Can't get point path. Point out of bounds (%s/%s, %s/%s).", p_to.x, size.x, p_to.y, size.y));
+
+	Vector<Vector2i> cell_path = _get_cell_path(p_from, p_to);
+
+	Vector<Vector2> path;
+	path.resize(cell_path.size());
+	{
+		Vector2 *w = path.ptrw();
+		for (int i = 0; i < cell_path.size(); i++) {
+			w[i] = get_point_position(cell_path[i]);
+		}
+	}
+
+	return path;
+}
+
+TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from, const Vector2i &p_to) {
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from), TypedArray<Vector2i>(), vformat("Can't get id path. Point out of bounds (%s/%s, %s/%s).", p_from.x, size.x, p_from.y, size.y));
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to), TypedArray<Vector2i>(), vformat("Can't get id path. Point out of bounds (%s/%s, %s/%s).", p_to.x, size.x, p_to.y, size.y));
+
+	Vector<Vector2i> cell_path = _get_cell_path(p_from, p_to);
+
+	TypedArray<Vector2i> path;
+	path.resize(cell_path.size());
+	for (int i = 0; i < cell_path.size(); i++) {
+		path[i] = cell_path[i];
+	}
+
+	return path;
+}
+
+void AStarGrid2D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_size", "size"), &AStarGrid2D::set_size);
+	ClassDB::bind_method(D_METHOD("get_size"), &AStarGrid2D::get_size);
+	ClassDB::bind_method(D_METHOD("set_offset", "offset"), &AStarGrid2D::set_offset);
+	ClassDB::bind_method(D_METHOD("get_offset"), &AStarGrid2D::get_offset);
+	ClassDB::bind_method(D_METHOD("set_cell_size", "cell_size"), &AStarGrid2D::set_cell_size);
+	ClassDB::bind_method(D_METHOD("get_cell_size"), &AStarGrid2D::get_cell_size);
+	ClassDB::bind_method(D_METHOD("set_diagonal_mode", "mode"), &AStarGrid2D::set_diagonal_mode);
+	ClassDB::bind_method(D_METHOD("get_diagonal_mode"), &AStarGrid2D::get_diagonal_mode);
+	ClassDB::bind_method(D_METHOD("set_jumping_enabled", "enabled"), &AStarGrid2D::set_jumping_enabled);
+	ClassDB::bind_method(D_METHOD("is_jumping_enabled"), &AStarGrid2D::is_jumping_enabled);
+
+	ClassDB::bind_method(D_METHOD("is_in_bounds", "x", "y"), &AStarGrid2D::is_in_bounds);
+	ClassDB::bind_method(D_METHOD("is_in_boundsv", "id"), &AStarGrid2D::is_in_boundsv);
+	ClassDB::bind_method(D_METHOD("set_point_solid", "id", "solid"), &AStarGrid2D::set_point_solid, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("is_point_solid", "id"), &AStarGrid2D::is_point_solid);
+	ClassDB::bind_method(D_METHOD("get_point_position", "id"), &AStarGrid2D::get_point_position);
+	ClassDB::bind_method(D_METHOD("clear"), &AStarGrid2D::clear);
+
+	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStarGrid2D::get_point_path);
+	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStarGrid2D::get_id_path);
+
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2I, "size"), "set_size", "get_size");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "offset"), "set_offset", "get_offset");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "cell_size"), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "jumping_enabled"), "set_jumping_enabled", "is_jumping_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "diagonal_mode", PROPERTY_HINT_ENUM, "Always,Never,At Least One Walkable,Only If No Obstacles"), "set_diagonal_mode", "get_diagonal_mode");
+
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_ALWAYS);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_NEVER);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_MAX);
+}
@@ -0,0 +1,144 @@
+/*************************************************************************/
+/*  a_star_grid_2d.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef A_STAR_GRID_2D_H
+#define A_STAR_GRID_2D_H
+
+#include "core/object/reference.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/typed_array.h"
+
+/**
+	A* pathfinding specialized for uniform 2D grids, with optional jump point search.
+
+	Cells are addressed by their coordinates, walkability is kept in a bitset and
+	the search state lives in flat arrays indexed by cell, so no per-point
+	allocation or hash lookup is needed.
+*/
+
+class AStarGrid2D : public Reference {
+	GDCLASS(AStarGrid2D, Reference);
+
+public:
+	enum DiagonalMode {
+		DIAGONAL_MODE_ALWAYS,
+		DIAGONAL_MODE_NEVER,
+		DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE,
+		DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES,
+		DIAGONAL_MODE_MAX,
+	};
+
+private:
+	Size2i size;
+	Vector2 offset;
+	Size2 cell_size = Size2(1, 1);
+	DiagonalMode diagonal_mode = DIAGONAL_MODE_ALWAYS;
+	bool jumping_enabled = false;
+
+	LocalVector<uint32_t> solid_mask;
+
+	// Used for pathfinding, indexed by cell.
+	LocalVector<real_t> g_scores;
+	LocalVector<real_t> f_scores;
+	LocalVector<int32_t> prev_cells;
+	LocalVector<uint32_t> open_passes;
+	LocalVector<uint32_t> closed_passes;
+	LocalVector<uint32_t> open_list_indices;
+	LocalVector<uint32_t> open_list;
+	uint32_t pass = 0;
+
+	// Jump point found scanning each cell's row rightwards and leftwards (-1 if
+	// none) during the pass stored alongside, only used without diagonals.
+	LocalVector<int32_t> horizontal_jumps;
+	LocalVector<uint32_t> horizontal_jump_passes;
+
+	_FORCE_INLINE_ int32_t _get_cell(int32_t p_x, int32_t p_y) const { return p_y * size.x + p_x; }
+	_FORCE_INLINE_ bool _is_walkable(int32_t p_x, int32_t p_y) const {
+		if (p_x < 0 || p_y < 0 || p_x >= size.x || p_y >= size.y) {
+			return false;
+		}
+		const uint32_t cell = _get_cell(p_x, p_y);
+		return !(solid_mask[cell >> 5] & (1u << (cell & 31)));
+	}
+
+	bool _can_move_diagonally(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const;
+	real_t _get_cost(int32_t p_from_x, int32_t p_from_y, int32_t p_to_x, int32_t p_to_y) const;
+
+	bool _is_cell_better(uint32_t p_cell, uint32_t p_than_cell) const;
+	void _open_list_move_up(uint32_t p_index, uint32_t p_cell);
+	void _open_list_move_down(uint32_t p_index, uint32_t p_cell);
+	void _open_list_push(uint32_t p_cell);
+	void _open_list_pop();
+
+	int _get_neighbours(int32_t p_x, int32_t p_y, Vector2i *r_neighbours) const;
+	int _get_jump_neighbours(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, Vector2i *r_neighbours) const;
+	int32_t _jump_horizontally(int32_t p_x, int32_t p_y, int32_t p_dx, const Vector2i &p_end);
+	bool _jump(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, const Vector2i &p_end, Vector2i &r_jump_point);
+
+	bool _solve(const Vector2i &p_from, const Vector2i &p_to);
+	Vector<Vector2i> _get_cell_path(const Vector2i &p_from, const Vector2i &p_to);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_size(const Size2i &p_size);
+	Size2i get_size() const;
+
+	void set_offset(const Vector2 &p_offset);
+	Vector2 get_offset() const;
+
+	void set_cell_size(const Size2 &p_cell_size);
+	Size2 get_cell_size() const;
+
+	void set_diagonal_mode(DiagonalMode p_diagonal_mode);
+	DiagonalMode get_diagonal_mode() const;
+
+	void set_jumping_enabled(bool p_enabled);
+	bool is_jumping_enabled() const;
+
+	bool is_in_bounds(int p_x, int p_y) const;
+	bool is_in_boundsv(const Vector2i &p_id) const;
+
+	void set_point_solid(const Vector2i &p_id, bool p_solid = true);
+	bool is_point_solid(const Vector2i &p_id) const;
+	Vector2 get_point_position(const Vector2i &p_id) const;
+
+	void clear();
+
+	Vector<Vector2> get_point_path(const Vector2i &p_from, const Vector2i &p_to);
+	TypedArray<Vector2i> get_id_path(const Vector2i &p_from, const Vector2i &p_to);
+
+	AStarGrid2D() {}
+};
+
+VARIANT_ENUM_CAST(AStarGrid2D::DiagonalMode);
+
+#endif // A_STAR_GRID_2D_H
@@ -110,6 +110,7 @@ public:
 	virtual real_t get_real() const;
 
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const; ///< get an array of bytes
+	virtual const uint8_t *get_buffer_ptr(int p_length) const { return nullptr; } ///< get a read-only pointer to the next p_length bytes and advance past them, or nullptr if the file is not memory mapped (use get_buffer instead)
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -146,6 +147,8 @@ public:
 
 	virtual bool file_exists(const String &p_name) = 0; ///< return true if a file exists
 
+	virtual const uint8_t *map_read_only() { return nullptr; } ///< map the whole file read-only, valid until the file is closed; nullptr if not supported
+
 	virtual Error reopen(const String &p_path, int p_mode_flags); ///< does not change the AccessType
 
 	static FileAccess *create(AccessType p_access); /// Create a file access (for the current platform) this is the only portable way of accessing files.
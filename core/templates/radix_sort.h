@@ -0,0 +1,119 @@
+/*************************************************************************/
+/*  radix_sort.h                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include "core/typedefs.h"
+
+#include <string.h>
+
+template <class T>
+struct _DefaultRadixKey {
+	_FORCE_INLINE_ uint64_t operator()(const T &p_value) const { return uint64_t(p_value); }
+};
+
+// Stable LSD radix sort on unsigned integer keys of up to 64 bits, one byte per pass.
+// Histograms for all bytes are gathered in a single read, and passes where every key
+// shares the same byte are skipped, so narrow or mostly uniform keys sort in few passes.
+template <class T, class KeyGetter = _DefaultRadixKey<T>>
+class RadixSort {
+	enum {
+		RADIX_BITS = 8,
+		RADIX_SIZE = 1 << RADIX_BITS,
+		RADIX_MASK = RADIX_SIZE - 1,
+		MAX_PASSES = 64 / RADIX_BITS,
+	};
+
+public:
+	KeyGetter get_key;
+
+	// Sorts p_array in ascending key order. p_temp must have room for p_len elements and
+	// is used as the ping-pong buffer, so it can be allocated once and reused between sorts.
+	void sort(T *p_array, T *p_temp, uint32_t p_len, uint32_t p_key_bits = 64) const {
+		if (p_len < 2) {
+			return;
+		}
+
+		uint32_t passes = MIN((p_key_bits + RADIX_BITS - 1) / RADIX_BITS, (uint32_t)MAX_PASSES);
+		uint32_t histograms[MAX_PASSES][RADIX_SIZE];
+		memset(histograms, 0, sizeof(uint32_t) * RADIX_SIZE * passes);
+
+		for (uint32_t i = 0; i < p_len; i++) {
+			uint64_t key = get_key(p_array[i]);
+			for (uint32_t j = 0; j < passes; j++) {
+				histograms[j][(key >> (j * RADIX_BITS)) & RADIX_MASK]++;
+			}
+		}
+
+		T *src = p_array;
+		T *dst = p_temp;
+
+		for (uint32_t j = 0; j < passes; j++) {
+			uint32_t shift = j * RADIX_BITS;
+			uint32_t *histogram = histograms[j];
+
+			if (histogram[(get_key(src[0]) >> shift) & RADIX_MASK] == p_len) {
+				continue; // All keys share this byte, order would not change.
+			}
+
+			uint32_t offset = 0;
+			for (uint32_t k = 0; k < RADIX_SIZE; k++) {
+				uint32_t count = histogram[k];
+				histogram[k] = offset;
+				offset += count;
+			}
+
+			for (uint32_t i = 0; i < p_len; i++) {
+				dst[histogram[(get_key(src[i]) >> shift) & RADIX_MASK]++] = src[i];
+			}
+
+			SWAP(src, dst);
+		}
+
+		if (src != p_array) {
+			for (uint32_t i = 0; i < p_len; i++) {
+				p_array[i] = src[i];
+			}
+		}
+	}
+
+	// Maps a float to an unsigned key that sorts in the same order as the float value.
+	static _FORCE_INLINE_ uint32_t float_key(float p_value) {
+		union {
+			float f;
+			uint32_t i;
+		} u;
+		u.f = p_value;
+		return (u.i & 0x80000000) ? ~u.i : (u.i | 0x80000000);
+	}
+};
+
+#endif // RADIX_SORT_H
@@ -965,6 +965,8 @@ public:
 
 	void draw_window_margins(int *p_margins, RID *p_margin_textures) override {}
 
+	int get_render_info(RS::RenderInfo p_info) override { return 0; }
+
 	bool free(RID p_rid) override { return true; }
 	void update() override {}
 
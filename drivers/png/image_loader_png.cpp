@@ -38,6 +38,15 @@
 
 Error ImageLoaderPNG::load_image(Ref<Image> p_image, FileAccess *f, bool p_force_linear, float p_scale) {
 	const size_t buffer_size = f->get_len();
+
+	// decode straight from memory mapped files, skipping the copy
+	const uint8_t *mapped = f->get_buffer_ptr(buffer_size);
+	if (mapped) {
+		Error err = PNGDriverCommon::png_to_image(mapped, buffer_size, p_force_linear, p_image);
+		f->close();
+		return err;
+	}
+
 	Vector<uint8_t> file_buffer;
 	Error err = file_buffer.resize(buffer_size);
 	if (err) {
@@ -41,6 +41,7 @@
 #include <errno.h>
 
 #if defined(UNIX_ENABLED)
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -153,6 +154,14 @@ void FileAccessUnix::close() {
 		return;
 	}
 
+#if defined(UNIX_ENABLED)
+	if (mapped) {
+		munmap(mapped, mapped_len);
+		mapped = nullptr;
+		mapped_len = 0;
+	}
+#endif
+
 	fclose(f);
 	f = nullptr;
 
@@ -297,6 +306,33 @@ bool FileAccessUnix::file_exists(const String &p_path) {
 	}
 }
 
+const uint8_t *FileAccessUnix::map_read_only() {
+	ERR_FAIL_COND_V_MSG(!f, nullptr, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(flags != READ, nullptr, "Only files opened for reading can be mapped.");
+
+#if defined(UNIX_ENABLED)
+	if (mapped) {
+		return mapped;
+	}
+
+	size_t len = get_len();
+	if (len == 0) {
+		return nullptr;
+	}
+
+	void *ptr = mmap(nullptr, len, PROT_READ, MAP_SHARED, fileno(f), 0);
+	if (ptr == MAP_FAILED) {
+		return nullptr;
+	}
+
+	mapped = (uint8_t *)ptr;
+	mapped_len = len;
+	return mapped;
+#else
+	return nullptr;
+#endif
+}
+
 uint64_t FileAccessUnix::_get_modified_time(const String &p_file) {
 	String file = fix_path(p_file);
 	struct stat flags;
@@ -49,6 +49,9 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	uint8_t *mapped = nullptr;
+	size_t mapped_len = 0;
+
 	static FileAccess *create_libc();
 
 public:
@@ -79,6 +82,8 @@ public:
 
 	virtual bool file_exists(const String &p_path); ///< return true if a file exists
 
+	virtual const uint8_t *map_read_only(); ///< map the whole file read-only
+
 	virtual uint64_t _get_modified_time(const String &p_file);
 	virtual uint32_t _get_unix_permissions(const String &p_file);
 	virtual Error _set_unix_permissions(const String &p_file, uint32_t p_permissions);
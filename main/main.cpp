@@ -2612,6 +2612,7 @@ void Main::cleanup() {
 
 	ResourceLoader::clear_translation_remaps();
 	ResourceLoader::clear_path_remaps();
+	ResourceLoader::clear_prefetch_sets();
 
 	ScriptServer::finish_languages();
 
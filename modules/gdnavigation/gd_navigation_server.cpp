@@ -31,6 +31,9 @@
 #include "gd_navigation_server.h"
 
 #include "core/os/mutex.h"
+#include "core/os/threaded_array_processor.h"
+
+#include <algorithm>
 
 #ifndef _3D_DISABLED
 #include "navigation_mesh_generator.h"
@@ -207,6 +210,49 @@ Vector<Vector3> GdNavigationServer::map_get_path(RID p_map, Vector3 p_origin, Ve
 	return map->get_path(p_origin, p_destination, p_optimize);
 }
 
+RID GdNavigationServer::map_query_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, Object *p_receiver, StringName p_method, Variant p_udata) const {
+	ERR_FAIL_COND_V(!map_owner.owns(p_map), RID());
+
+	PathQuery *query = memnew(PathQuery);
+	query->map = p_map;
+	query->origin = p_origin;
+	query->destination = p_destination;
+	query->optimize = p_optimize;
+	query->receiver = p_receiver == nullptr ? ObjectID() : p_receiver->get_instance_id();
+	query->method = p_method;
+	query->udata = p_udata;
+
+	RID rid = path_query_owner.make_rid(query);
+	query->self = rid;
+
+	auto mut_this = const_cast<GdNavigationServer *>(this);
+	MutexLock lock(mut_this->path_queries_mutex);
+	mut_this->pending_path_queries.push_back(query);
+
+	return rid;
+}
+
+bool GdNavigationServer::path_query_is_done(RID p_query) const {
+	// Looked up under the lock, so `free` can't delete the query meanwhile.
+	auto mut_this = const_cast<GdNavigationServer *>(this);
+	MutexLock lock(mut_this->path_queries_mutex);
+
+	const PathQuery *query = path_query_owner.getornull(p_query);
+	ERR_FAIL_COND_V(query == nullptr, false);
+
+	return query->done;
+}
+
+Vector<Vector3> GdNavigationServer::path_query_get_path(RID p_query) const {
+	auto mut_this = const_cast<GdNavigationServer *>(this);
+	MutexLock lock(mut_this->path_queries_mutex);
+
+	const PathQuery *query = path_query_owner.getornull(p_query);
+	ERR_FAIL_COND_V(query == nullptr, Vector<Vector3>());
+
+	return query->done ? query->path : Vector<Vector3>();
+}
+
 Vector3 GdNavigationServer::map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
 	const NavMap *map = map_owner.getornull(p_map);
 	ERR_FAIL_COND_V(map == nullptr, Vector3());
@@ -457,6 +503,22 @@ COMMAND_1(free, RID, p_object) {
 		agent_owner.free(p_object);
 		memdelete(agent);
 
+	} else if (path_query_owner.owns(p_object)) {
+		// Commands run under `operations_mutex`, like `process`, so the query
+		// is never being solved here. It may still be polled from other
+		// threads, which only access it under `path_queries_mutex`.
+		MutexLock lock(path_queries_mutex);
+		PathQuery *query = path_query_owner.getornull(p_object);
+
+		// Drops the query if it's not yet solved
+		std::vector<PathQuery *>::iterator it = std::find(pending_path_queries.begin(), pending_path_queries.end(), query);
+		if (it != pending_path_queries.end()) {
+			pending_path_queries.erase(it);
+		}
+
+		path_query_owner.free(p_object);
+		memdelete(query);
+
 	} else {
 		ERR_FAIL_COND("Invalid ID.");
 	}
@@ -495,6 +557,65 @@ void GdNavigationServer::process(real_t p_delta_time) {
 		active_maps[i]->step(p_delta_time);
 		active_maps[i]->dispatch_callbacks();
 	}
+
+	process_path_queries();
+}
+
+void GdNavigationServer::solve_path_query(uint32_t p_index, PathQuery **p_queries) {
+	PathQuery *query = p_queries[p_index];
+
+	// The maps are synced and not modified until the next `process`, so
+	// many queries can safely read the same map at once.
+	const NavMap *map = map_owner.getornull(query->map);
+	if (map != nullptr) {
+		query->path = map->get_path(query->origin, query->destination, query->optimize);
+	}
+}
+
+void GdNavigationServer::process_path_queries() {
+	std::vector<PathQuery *> queries;
+	{
+		MutexLock lock(path_queries_mutex);
+		queries.swap(pending_path_queries);
+	}
+
+	if (queries.size() == 0) {
+		return;
+	}
+
+	thread_process_array(
+			queries.size(),
+			this,
+			&GdNavigationServer::solve_path_query,
+			queries.data());
+
+	{
+		MutexLock lock(path_queries_mutex);
+		for (size_t i(0); i < queries.size(); i++) {
+			queries[i]->done = true;
+		}
+	}
+
+	// Dispatch the callbacks
+	for (size_t i(0); i < queries.size(); i++) {
+		PathQuery *query = queries[i];
+		if (query->receiver.is_null()) {
+			continue;
+		}
+
+		Object *obj = ObjectDB::get_instance(query->receiver);
+		if (obj == nullptr) {
+			continue;
+		}
+
+		Callable::CallError call_error;
+		const Variant rid = query->self;
+		const Variant path = query->path;
+		const Variant *vp[3] = { &rid, &path, &query->udata };
+		int argc = (query->udata.get_type() == Variant::NIL) ? 2 : 3;
+		obj->call(query->method, vp, argc, call_error);
+		ERR_CONTINUE_MSG(call_error.error != Callable::CallError::CALL_OK, "Error calling path query callback: " + Variant::get_call_error_text(obj, query->method, vp, argc, call_error) + ".");
+	}
 }
 
 #undef COMMAND_1
@@ -67,16 +67,39 @@ struct SetCommand {
 	virtual void exec(GdNavigationServer *server) = 0;
 };
 
+/// A path request solved asynchronously during `process`.
+struct PathQuery {
+	RID self;
+	RID map;
+	Vector3 origin;
+	Vector3 destination;
+	bool optimize = false;
+
+	ObjectID receiver;
+	StringName method;
+	Variant udata;
+
+	/// Set on the main thread once `path` is written.
+	bool done = false;
+	Vector<Vector3> path;
+};
+
 class GdNavigationServer : public NavigationServer3D {
 	Mutex commands_mutex;
 	/// Mutex used to make any operation threadsafe.
 	Mutex operations_mutex;
+	/// Mutex used to queue and poll the path queries.
+	Mutex path_queries_mutex;
 
 	std::vector<SetCommand *> commands;
 
 	mutable RID_PtrOwner<NavMap> map_owner;
 	mutable RID_PtrOwner<NavRegion> region_owner;
 	mutable RID_PtrOwner<RvoAgent> agent_owner;
+	mutable RID_PtrOwner<PathQuery, true> path_query_owner;
+
+	/// Queries waiting for the next `process`.
+	std::vector<PathQuery *> pending_path_queries;
 
 	bool active = true;
 	Vector<NavMap *> active_maps;
@@ -102,6 +125,10 @@ public:
 
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize) const;
 
+	virtual RID map_query_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, Object *p_receiver = nullptr, StringName p_method = StringName(), Variant p_udata = Variant()) const;
+	virtual bool path_query_is_done(RID p_query) const;
+	virtual Vector<Vector3> path_query_get_path(RID p_query) const;
+
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const;
 	virtual Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const;
 	virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const;
@@ -133,6 +160,10 @@ public:
 
 	void flush_queries();
 	virtual void process(real_t p_delta_time);
+
+private:
+	void solve_path_query(uint32_t p_index, PathQuery **p_queries);
+	void process_path_queries();
 };
 
 #undef COMMAND_1
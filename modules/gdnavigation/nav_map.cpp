@@ -42,6 +42,16 @@
 
 #define USE_ENTRY_POINT
 
+#define LEN_TOLLERANCE 0.1
+#define DIR_TOLLERANCE 0.9
+// In front of tolerance
+#define IFO_TOLLERANCE 0.5
+
+/// Returns the index of the polygon in the map, used by the path search.
+static _FORCE_INLINE_ uint32_t _get_polygon_id(const gd::Polygon *p_poly) {
+	return p_poly->owner->get_polygons_offset() + p_poly->id;
+}
+
 void NavMap::set_up(Vector3 p_up) {
 	up = p_up;
 	regenerate_polygons = true;
@@ -71,37 +81,13 @@ gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 }
 
 Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize) const {
-	const gd::Polygon *begin_poly = nullptr;
-	const gd::Polygon *end_poly = nullptr;
 	Vector3 begin_point;
 	Vector3 end_point;
-	float begin_d = 1e20;
 	float end_d = 1e20;
 
 	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each point cast a face and check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 spoint = f.get_closest_point_to(p_origin);
-			float dpoint = spoint.distance_to(p_origin);
-			if (dpoint < begin_d) {
-				begin_d = dpoint;
-				begin_poly = &p;
-				begin_point = spoint;
-			}
-
-			spoint = f.get_closest_point_to(p_destination);
-			dpoint = spoint.distance_to(p_destination);
-			if (dpoint < end_d) {
-				end_d = dpoint;
-				end_poly = &p;
-				end_point = spoint;
-			}
-		}
-	}
+	const gd::Polygon *begin_poly = _get_closest_polygon(p_origin, &begin_point);
+	const gd::Polygon *end_poly = _get_closest_polygon(p_destination, &end_point);
 
 	if (!begin_poly || !end_poly) {
 		// No path
@@ -116,24 +102,20 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
-	std::vector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
+	// Search state of every polygon, indexed by the polygon id.
+	std::vector<gd::NavigationPoly> navigation_polys(polygon_count);
+	gd::NavigationPolyHeap open_list(navigation_polys);
 
-	// The elements indices in the `navigation_polys`.
-	int least_cost_id(-1);
-	List<uint32_t> open_list;
+	int least_cost_id = _get_polygon_id(begin_poly);
 	bool found_route = false;
 
-	navigation_polys.push_back(gd::NavigationPoly(begin_poly));
 	{
-		least_cost_id = 0;
-		gd::NavigationPoly *least_cost_poly = &navigation_polys[least_cost_id];
-		least_cost_poly->self_id = least_cost_id;
-		least_cost_poly->entry = begin_point;
+		gd::NavigationPoly *begin_navigation_poly = &navigation_polys[least_cost_id];
+		begin_navigation_poly->poly = begin_poly;
+		begin_navigation_poly->self_id = least_cost_id;
+		begin_navigation_poly->entry = begin_point;
 	}
 
-	open_list.push_back(0);
-
 	const gd::Polygon *reachable_end = nullptr;
 	float reachable_d = 1e30;
 	bool is_reachable = true;
@@ -161,43 +143,44 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				const float new_distance = least_cost_poly->poly->center.distance_to(edge.other_polygon->center) + least_cost_poly->traveled_distance;
 #endif
 
-				auto it = std::find(
-						navigation_polys.begin(),
-						navigation_polys.end(),
-						gd::NavigationPoly(edge.other_polygon));
+				gd::NavigationPoly *np = &navigation_polys[_get_polygon_id(edge.other_polygon)];
 
-				if (it != navigation_polys.end()) {
+				if (np->poly != nullptr) {
 					// Oh this was visited already, can we win the cost?
-					if (it->traveled_distance > new_distance) {
-						it->prev_navigation_poly_id = least_cost_id;
-						it->back_navigation_edge = edge.other_edge;
-						it->traveled_distance = new_distance;
+					if (np->traveled_distance > new_distance) {
+						np->prev_navigation_poly_id = least_cost_id;
+						np->back_navigation_edge = edge.other_edge;
+						np->traveled_distance = new_distance;
 #ifdef USE_ENTRY_POINT
-						it->entry = new_entry;
+						np->entry = new_entry;
+						np->cost = new_distance + new_entry.distance_to(end_point);
+#else
+						np->cost = new_distance + np->poly->center.distance_to(end_point);
 #endif
+						if (np->heap_index != -1) {
+							open_list.update(np->self_id);
+						}
 					}
 				} else {
 					// Add to open neighbours
 
-					navigation_polys.push_back(gd::NavigationPoly(edge.other_polygon));
-					gd::NavigationPoly *np = &navigation_polys[navigation_polys.size() - 1];
-
-					np->self_id = navigation_polys.size() - 1;
+					np->poly = edge.other_polygon;
+					np->self_id = _get_polygon_id(edge.other_polygon);
 					np->prev_navigation_poly_id = least_cost_id;
 					np->back_navigation_edge = edge.other_edge;
 					np->traveled_distance = new_distance;
 #ifdef USE_ENTRY_POINT
 					np->entry = new_entry;
+					np->cost = new_distance + new_entry.distance_to(end_point);
+#else
+					np->cost = new_distance + np->poly->center.distance_to(end_point);
 #endif
-					open_list.push_back(navigation_polys.size() - 1);
+					open_list.push(np->self_id);
 				}
 			}
 		}
 
-		// Removes the least cost polygon from the open list so we can advance.
-		open_list.erase(least_cost_id);
-
-		if (open_list.size() == 0) {
+		if (open_list.empty()) {
 			// When the open list is empty at this point the End Polygon is not reachable
 			// so use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
@@ -220,12 +203,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				}
 			}
 
-			// Reset open and navigation_polys
-			gd::NavigationPoly np = navigation_polys[0];
-			navigation_polys.clear();
-			navigation_polys.push_back(np);
-			open_list.clear();
-			open_list.push_back(0);
+			// Reset the search, keeping only the begin poly.
+			least_cost_id = _get_polygon_id(begin_poly);
+			gd::NavigationPoly np = navigation_polys[least_cost_id];
+			std::fill(navigation_polys.begin(), navigation_polys.end(), gd::NavigationPoly());
+			navigation_polys[least_cost_id] = np;
 
 			reachable_end = nullptr;
 
@@ -233,22 +215,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		}
 
 		// Now take the new least_cost_poly from the open list.
-		least_cost_id = -1;
-		float least_cost = 1e30;
-
-		for (auto element = open_list.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
-			float cost = np->traveled_distance;
-#ifdef USE_ENTRY_POINT
-			cost += np->entry.distance_to(end_point);
-#else
-			cost += np->poly->center.distance_to(end_point);
-#endif
-			if (cost < least_cost) {
-				least_cost_id = np->self_id;
-				least_cost = cost;
-			}
-		}
+		least_cost_id = open_list.pop();
 
 		// Stores the further reachable end polygon, in case our goal is not reachable.
 		if (is_reachable) {
@@ -259,8 +226,6 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			}
 		}
 
-		ERR_BREAK(least_cost_id == -1);
-
 		// Check if we reached the end
 		if (navigation_polys[least_cost_id].poly == end_poly) {
 			// Yep, done!!
@@ -389,42 +354,44 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 	real_t closest_point_d = 1e20;
 
 	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each point cast a face and check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 inters;
-			if (f.intersects_segment(p_from, p_to, &inters)) {
-				const real_t d = closest_point_d = p_from.distance_to(inters);
-				if (use_collision == false) {
-					closest_point = inters;
-					use_collision = true;
-					closest_point_d = d;
-				} else if (closest_point_d > d) {
-					closest_point = inters;
-					closest_point_d = d;
+	for (size_t r(0); r < regions.size(); r++) {
+		for (size_t i(0); i < regions[r]->get_polygons().size(); i++) {
+			const gd::Polygon &p = regions[r]->get_polygons()[i];
+
+			// For each point cast a face and check the distance to the segment
+			for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+				const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+				Vector3 inters;
+				if (f.intersects_segment(p_from, p_to, &inters)) {
+					const real_t d = closest_point_d = p_from.distance_to(inters);
+					if (use_collision == false) {
+						closest_point = inters;
+						use_collision = true;
+						closest_point_d = d;
+					} else if (closest_point_d > d) {
+						closest_point = inters;
+						closest_point_d = d;
+					}
 				}
 			}
-		}
 
-		if (use_collision == false) {
-			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
-				Vector3 a, b;
-
-				Geometry3D::get_closest_points_between_segments(
-						p_from,
-						p_to,
-						p.points[point_id].pos,
-						p.points[(point_id + 1) % p.points.size()].pos,
-						a,
-						b);
-
-				const real_t d = a.distance_to(b);
-				if (d < closest_point_d) {
-					closest_point_d = d;
-					closest_point = b;
+			if (use_collision == false) {
+				for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
+					Vector3 a, b;
+
+					Geometry3D::get_closest_points_between_segments(
+							p_from,
+							p_to,
+							p.points[point_id].pos,
+							p.points[(point_id + 1) % p.points.size()].pos,
+							a,
+							b);
+
+					const real_t d = a.distance_to(b);
+					if (d < closest_point_d) {
+						closest_point_d = d;
+						closest_point = b;
+					}
 				}
 			}
 		}
@@ -434,94 +401,40 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 }
 
 Vector3 NavMap::get_closest_point(const Vector3 &p_point) const {
-	// TODO this is really not optimal, please redesign the API to directly return all this data
-
 	Vector3 closest_point;
-	real_t closest_point_d = 1e20;
-
-	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each point cast a face and check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t d = inters.distance_to(p_point);
-			if (d < closest_point_d) {
-				closest_point = inters;
-				closest_point_d = d;
-			}
-		}
-	}
-
+	_get_closest_polygon(p_point, &closest_point);
 	return closest_point;
 }
 
 Vector3 NavMap::get_closest_point_normal(const Vector3 &p_point) const {
-	// TODO this is really not optimal, please redesign the API to directly return all this data
-
 	Vector3 closest_point;
 	Vector3 closest_point_normal;
-	real_t closest_point_d = 1e20;
-
-	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each point cast a face and check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t d = inters.distance_to(p_point);
-			if (d < closest_point_d) {
-				closest_point = inters;
-				closest_point_normal = f.get_plane().normal;
-				closest_point_d = d;
-			}
-		}
-	}
-
+	_get_closest_polygon(p_point, &closest_point, &closest_point_normal);
 	return closest_point_normal;
 }
 
 RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
-	// TODO this is really not optimal, please redesign the API to directly return all this data
-
 	Vector3 closest_point;
-	RID closest_point_owner;
-	real_t closest_point_d = 1e20;
-
-	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each point cast a face and check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t d = inters.distance_to(p_point);
-			if (d < closest_point_d) {
-				closest_point = inters;
-				closest_point_owner = p.owner->get_self();
-				closest_point_d = d;
-			}
-		}
-	}
-
-	return closest_point_owner;
+	const gd::Polygon *closest_poly = _get_closest_polygon(p_point, &closest_point);
+	return closest_poly ? closest_poly->owner->get_self() : RID();
 }
 
 void NavMap::add_region(NavRegion *p_region) {
 	regions.push_back(p_region);
-	regenerate_links = true;
+	links_dirty = true;
 }
 
 void NavMap::remove_region(NavRegion *p_region) {
 	std::vector<NavRegion *>::iterator it = std::find(regions.begin(), regions.end(), p_region);
 	if (it != regions.end()) {
+		_disconnect_region(p_region);
 		regions.erase(it);
-		regenerate_links = true;
+		links_dirty = true;
+
+		it = std::find(regions_to_link.begin(), regions_to_link.end(), p_region);
+		if (it != regions_to_link.end()) {
+			regions_to_link.erase(it);
+		}
 	}
 }
 
@@ -532,7 +445,6 @@ bool NavMap::has_agent(RvoAgent *agent) const {
 void NavMap::add_agent(RvoAgent *agent) {
 	if (!has_agent(agent)) {
 		agents.push_back(agent);
-		agents_dirty = true;
 	}
 }
 
@@ -541,7 +453,6 @@ void NavMap::remove_agent(RvoAgent *agent) {
 	auto it = std::find(agents.begin(), agents.end(), agent);
 	if (it != agents.end()) {
 		agents.erase(it);
-		agents_dirty = true;
 	}
 }
 
@@ -568,170 +479,344 @@ void NavMap::sync() {
 		regenerate_links = true;
 	}
 
-	for (size_t r(0); r < regions.size(); r++) {
-		if (regions[r]->sync()) {
-			regenerate_links = true;
+	if (regenerate_links) {
+		// Drops all the connections, every region is connected from scratch.
+		edge_connections.clear();
+		regions_to_link.clear();
+		for (size_t r(0); r < regions.size(); r++) {
+			std::vector<gd::Polygon> &region_polygons = regions[r]->get_polygons();
+			for (size_t poly_id(0); poly_id < region_polygons.size(); poly_id++) {
+				std::fill(region_polygons[poly_id].edges.begin(), region_polygons[poly_id].edges.end(), gd::Edge());
+			}
+			regions[r]->sync();
+			_connect_region(regions[r]);
 		}
-	}
+		links_dirty = true;
 
-	if (regenerate_links) {
-		// Copy all region polygons in the map.
-		int count = 0;
+	} else {
+		// Only the changed regions, and the ones connected to them, are updated.
 		for (size_t r(0); r < regions.size(); r++) {
-			count += regions[r]->get_polygons().size();
+			if (regions[r]->is_polygons_dirty()) {
+				_disconnect_region(regions[r]);
+				regions[r]->sync();
+				_connect_region(regions[r]);
+				links_dirty = true;
+			}
 		}
+	}
 
-		polygons.resize(count);
-		count = 0;
+	// Find the compatible near edges.
+	for (size_t r(0); r < regions_to_link.size(); r++) {
+		_link_free_edges(regions_to_link[r]);
+	}
+	regions_to_link.clear();
 
+	if (links_dirty) {
+		polygon_count = 0;
 		for (size_t r(0); r < regions.size(); r++) {
-			std::copy(
-					regions[r]->get_polygons().data(),
-					regions[r]->get_polygons().data() + regions[r]->get_polygons().size(),
-					polygons.begin() + count);
-
-			count += regions[r]->get_polygons().size();
+			regions[r]->set_polygons_offset(polygon_count);
+			polygon_count += regions[r]->get_polygons().size();
 		}
 
-		// Connects the `Edges` of all the `Polygons` of all `Regions` each other.
-		Map<gd::EdgeKey, gd::Connection> connections;
+		map_update_id = (map_update_id + 1) % 9999999;
+	}
 
-		for (size_t poly_id(0); poly_id < polygons.size(); poly_id++) {
-			gd::Polygon &poly(polygons[poly_id]);
+	regenerate_polygons = false;
+	regenerate_links = false;
+	links_dirty = false;
+}
 
-			for (size_t p(0); p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+void NavMap::_connect_region(NavRegion *p_region) {
+	std::vector<gd::Polygon> &region_polygons = p_region->get_polygons();
+
+	// Connects the `Edges` of the region `Polygons` with the ones that share the same edge.
+	for (size_t poly_id(0); poly_id < region_polygons.size(); poly_id++) {
+		gd::Polygon &poly(region_polygons[poly_id]);
+
+		for (size_t p(0); p < poly.points.size(); p++) {
+			int next_point = (p + 1) % poly.points.size();
+			gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			gd::Connection *connection = edge_connections.getptr(ek);
+			if (!connection) {
+				// Nothing yet
+				gd::Connection c;
+				c.A = &poly;
+				c.A_edge = p;
+				c.B = nullptr;
+				c.B_edge = -1;
+				edge_connections.set(ek, c);
+
+			} else if (connection->B == nullptr) {
+				CRASH_COND(connection->A == nullptr); // Unreachable
+
+				// Connect the two Polygons by this edge
+				connection->B = &poly;
+				connection->B_edge = p;
+
+				gd::Edge &a_edge = connection->A->edges[connection->A_edge];
+				if (a_edge.other_polygon) {
+					// The edge was linked to a near edge, that is free again.
+					a_edge.other_polygon->edges[a_edge.other_edge] = gd::Edge();
+					_queue_region_link(a_edge.other_polygon->owner);
+				}
 
-				Map<gd::EdgeKey, gd::Connection>::Element *connection = connections.find(ek);
-				if (!connection) {
-					// Nothing yet
-					gd::Connection c;
-					c.A = &poly;
-					c.A_edge = p;
-					c.B = nullptr;
-					c.B_edge = -1;
-					connections[ek] = c;
+				a_edge.this_edge = connection->A_edge;
+				a_edge.other_polygon = connection->B;
+				a_edge.other_edge = connection->B_edge;
 
-				} else if (connection->get().B == nullptr) {
-					CRASH_COND(connection->get().A == nullptr); // Unreachable
+				connection->B->edges[connection->B_edge].this_edge = connection->B_edge;
+				connection->B->edges[connection->B_edge].other_polygon = connection->A;
+				connection->B->edges[connection->B_edge].other_edge = connection->A_edge;
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT("Attempted to merge a navigation mesh triangle edge with another already-merged edge. This happens when the Navigation3D's `cell_size` is different from the one used to generate the navigation mesh. This will cause navigation problem.");
+			}
+		}
+	}
 
-					// Connect the two Polygons by this edge
-					connection->get().B = &poly;
-					connection->get().B_edge = p;
+	_queue_region_link(p_region);
+}
 
-					connection->get().A->edges[connection->get().A_edge].this_edge = connection->get().A_edge;
-					connection->get().A->edges[connection->get().A_edge].other_polygon = connection->get().B;
-					connection->get().A->edges[connection->get().A_edge].other_edge = connection->get().B_edge;
+void NavMap::_disconnect_region(NavRegion *p_region) {
+	std::vector<gd::Polygon> &region_polygons = p_region->get_polygons();
+
+	for (size_t poly_id(0); poly_id < region_polygons.size(); poly_id++) {
+		gd::Polygon &poly(region_polygons[poly_id]);
+
+		for (size_t p(0); p < poly.points.size(); p++) {
+			int next_point = (p + 1) % poly.points.size();
+			gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			gd::Connection *connection = edge_connections.getptr(ek);
+			if (connection) {
+				if (connection->A == &poly && connection->A_edge == int(p)) {
+					connection->A = connection->B;
+					connection->A_edge = connection->B_edge;
+					connection->B = nullptr;
+					connection->B_edge = -1;
+				} else if (connection->B == &poly && connection->B_edge == int(p)) {
+					connection->B = nullptr;
+					connection->B_edge = -1;
+				}
 
-					connection->get().B->edges[connection->get().B_edge].this_edge = connection->get().B_edge;
-					connection->get().B->edges[connection->get().B_edge].other_polygon = connection->get().A;
-					connection->get().B->edges[connection->get().B_edge].other_edge = connection->get().A_edge;
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT("Attempted to merge a navigation mesh triangle edge with another already-merged edge. This happens when the Navigation3D's `cell_size` is different from the one used to generate the navigation mesh. This will cause navigation problem.");
+				if (connection->A == nullptr) {
+					edge_connections.erase(ek);
 				}
 			}
+
+			// Frees the other side of this edge, so it can be connected again.
+			gd::Edge &edge = poly.edges[p];
+			if (edge.other_polygon && edge.other_polygon->owner != p_region) {
+				edge.other_polygon->edges[edge.other_edge] = gd::Edge();
+				_queue_region_link(edge.other_polygon->owner);
+			}
+			edge = gd::Edge();
 		}
+	}
+}
+
+void NavMap::_queue_region_link(NavRegion *p_region) {
+	if (std::find(regions_to_link.begin(), regions_to_link.end(), p_region) == regions_to_link.end()) {
+		regions_to_link.push_back(p_region);
+	}
+}
+
+static void _get_free_edges(NavRegion *p_region, std::vector<gd::FreeEdge> &r_free_edges) {
+	std::vector<gd::Polygon> &region_polygons = p_region->get_polygons();
+
+	for (size_t poly_id(0); poly_id < region_polygons.size(); poly_id++) {
+		gd::Polygon &poly(region_polygons[poly_id]);
 
-		// Takes all the free edges.
-		std::vector<gd::FreeEdge> free_edges;
-		free_edges.reserve(connections.size());
-
-		for (auto connection_element = connections.front(); connection_element; connection_element = connection_element->next()) {
-			if (connection_element->get().B == nullptr) {
-				CRASH_COND(connection_element->get().A == nullptr); // Unreachable
-				CRASH_COND(connection_element->get().A_edge < 0); // Unreachable
-
-				// This is a free edge
-				uint32_t id(free_edges.size());
-				free_edges.push_back(gd::FreeEdge());
-				free_edges[id].is_free = true;
-				free_edges[id].poly = connection_element->get().A;
-				free_edges[id].edge_id = connection_element->get().A_edge;
-				uint32_t point_0(free_edges[id].edge_id);
-				uint32_t point_1((free_edges[id].edge_id + 1) % free_edges[id].poly->points.size());
-				Vector3 pos_0 = free_edges[id].poly->points[point_0].pos;
-				Vector3 pos_1 = free_edges[id].poly->points[point_1].pos;
-				Vector3 relative = pos_1 - pos_0;
-				free_edges[id].edge_center = (pos_0 + pos_1) / 2.0;
-				free_edges[id].edge_dir = relative.normalized();
-				free_edges[id].edge_len_squared = relative.length_squared();
+		for (size_t p(0); p < poly.edges.size(); p++) {
+			if (poly.edges[p].other_polygon) {
+				continue;
 			}
+
+			// This is a free edge
+			uint32_t id(r_free_edges.size());
+			r_free_edges.push_back(gd::FreeEdge());
+			r_free_edges[id].is_free = true;
+			r_free_edges[id].poly = &poly;
+			r_free_edges[id].edge_id = p;
+			Vector3 pos_0 = poly.points[p].pos;
+			Vector3 pos_1 = poly.points[(p + 1) % poly.points.size()].pos;
+			Vector3 relative = pos_1 - pos_0;
+			r_free_edges[id].edge_center = (pos_0 + pos_1) / 2.0;
+			r_free_edges[id].edge_dir = relative.normalized();
+			r_free_edges[id].edge_len_squared = relative.length_squared();
 		}
+	}
+}
 
-		const float ecm_squared(edge_connection_margin * edge_connection_margin);
-#define LEN_TOLLERANCE 0.1
-#define DIR_TOLLERANCE 0.9
-		// In front of tolerance
-#define IFO_TOLLERANCE 0.5
+void NavMap::_link_free_edges(NavRegion *p_region) {
+	// Takes the free edges of the region and of the regions near it.
+	std::vector<gd::FreeEdge> free_edges;
+	_get_free_edges(p_region, free_edges);
+	if (free_edges.size() == 0) {
+		return;
+	}
+
+	std::vector<gd::FreeEdge> other_free_edges;
+	const AABB region_aabb = p_region->get_aabb().grow(edge_connection_margin);
+	for (size_t r(0); r < regions.size(); r++) {
+		if (regions[r] != p_region && region_aabb.intersects_inclusive(regions[r]->get_aabb())) {
+			_get_free_edges(regions[r], other_free_edges);
+		}
+	}
 
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		for (size_t i(0); i < free_edges.size(); i++) {
-			if (!free_edges[i].is_free) {
+	const float ecm_squared(edge_connection_margin * edge_connection_margin);
+
+	// Find the compatible near edges.
+	//
+	// Note:
+	// Considering that the edges must be compatible (for obvious reasons)
+	// to be connected, create new polygons to remove that small gap is
+	// not really useful and would result in wasteful computation during
+	// connection, integration and path finding.
+	for (size_t i(0); i < free_edges.size(); i++) {
+		gd::FreeEdge &edge = free_edges[i];
+		for (size_t y(0); y < other_free_edges.size(); y++) {
+			gd::FreeEdge &other_edge = other_free_edges[y];
+			if (!other_edge.is_free) {
 				continue;
 			}
-			gd::FreeEdge &edge = free_edges[i];
-			for (size_t y(0); y < free_edges.size(); y++) {
-				gd::FreeEdge &other_edge = free_edges[y];
-				if (i == y || !other_edge.is_free || edge.poly->owner == other_edge.poly->owner) {
-					continue;
-				}
 
-				Vector3 rel_centers = other_edge.edge_center - edge.edge_center;
-				if (ecm_squared > rel_centers.length_squared() // Are enough closer?
-						&& ABS(edge.edge_len_squared - other_edge.edge_len_squared) < LEN_TOLLERANCE // Are the same length?
-						&& ABS(edge.edge_dir.dot(other_edge.edge_dir)) > DIR_TOLLERANCE // Are aligned?
-						&& ABS(rel_centers.normalized().dot(edge.edge_dir)) < IFO_TOLLERANCE // Are one in front the other?
-				) {
-					// The edges can be connected
-					edge.is_free = false;
-					other_edge.is_free = false;
-
-					edge.poly->edges[edge.edge_id].this_edge = edge.edge_id;
-					edge.poly->edges[edge.edge_id].other_edge = other_edge.edge_id;
-					edge.poly->edges[edge.edge_id].other_polygon = other_edge.poly;
-
-					other_edge.poly->edges[other_edge.edge_id].this_edge = other_edge.edge_id;
-					other_edge.poly->edges[other_edge.edge_id].other_edge = edge.edge_id;
-					other_edge.poly->edges[other_edge.edge_id].other_polygon = edge.poly;
-				}
+			Vector3 rel_centers = other_edge.edge_center - edge.edge_center;
+			if (ecm_squared > rel_centers.length_squared() // Are enough closer?
+					&& ABS(edge.edge_len_squared - other_edge.edge_len_squared) < LEN_TOLLERANCE // Are the same length?
+					&& ABS(edge.edge_dir.dot(other_edge.edge_dir)) > DIR_TOLLERANCE // Are aligned?
+					&& ABS(rel_centers.normalized().dot(edge.edge_dir)) < IFO_TOLLERANCE // Are one in front the other?
+			) {
+				// The edges can be connected
+				edge.is_free = false;
+				other_edge.is_free = false;
+
+				edge.poly->edges[edge.edge_id].this_edge = edge.edge_id;
+				edge.poly->edges[edge.edge_id].other_edge = other_edge.edge_id;
+				edge.poly->edges[edge.edge_id].other_polygon = other_edge.poly;
+
+				other_edge.poly->edges[other_edge.edge_id].this_edge = other_edge.edge_id;
+				other_edge.poly->edges[other_edge.edge_id].other_edge = edge.edge_id;
+				other_edge.poly->edges[other_edge.edge_id].other_polygon = edge.poly;
+
+				links_dirty = true;
+				break;
 			}
 		}
 	}
+}
 
-	if (regenerate_links) {
-		map_update_id = (map_update_id + 1) % 9999999;
-	}
+const gd::Polygon *NavMap::_get_closest_polygon(const Vector3 &p_point, Vector3 *r_point, Vector3 *r_normal) const {
+	const gd::Polygon *closest_poly = nullptr;
+	real_t closest_point_d = 1e20;
 
-	if (agents_dirty) {
-		std::vector<RVO::Agent *> raw_agents;
-		raw_agents.reserve(agents.size());
-		for (size_t i(0); i < agents.size(); i++) {
-			raw_agents.push_back(agents[i]->get_agent());
+	for (size_t r(0); r < regions.size(); r++) {
+		const gd::Polygon *poly = regions[r]->get_closest_polygon(p_point, closest_point_d, r_point, r_normal);
+		if (poly) {
+			closest_poly = poly;
 		}
-		rvo.buildAgentTree(raw_agents);
 	}
 
-	regenerate_polygons = false;
-	regenerate_links = false;
-	agents_dirty = false;
+	return closest_poly;
+}
+
+void NavMap::_build_agent_grid() {
+	const uint32_t agent_count = agents.size();
+
+	// The cells are as big as the widest neighbor distance, so the neighbors
+	// of any agent are always in the 3x3 cells around it. They are never
+	// smaller than a map cell or an agent, so positions divided by the cell
+	// size stay in range when no agent looks for neighbors.
+	agent_grid_cell_size = cell_size;
+	for (uint32_t i(0); i < agent_count; i++) {
+		const RVO::Agent *agent = agents[i]->get_agent();
+		agent_grid_cell_size = MAX(agent_grid_cell_size, MAX(agent->neighborDist_, agent->radius_));
+	}
+	if (agent_grid_cell_size < CMP_EPSILON) {
+		agent_grid_cell_size = 1.0;
+	}
+
+	const uint32_t bucket_count = next_power_of_2(MAX(agent_count, 1u));
+	agent_grid_bucket_mask = bucket_count - 1;
+	agent_grid_offsets.assign(bucket_count + 1, 0);
+	agent_grid_buckets.resize(agent_count);
+
+	for (uint32_t i(0); i < agent_count; i++) {
+		const RVO::Vector3 &pos = agents[i]->get_agent()->position_;
+		const uint32_t bucket = _get_agent_grid_bucket(
+				int(Math::floor(pos.x() / agent_grid_cell_size)),
+				int(Math::floor(pos.z() / agent_grid_cell_size)));
+		agent_grid_buckets[i] = bucket;
+		agent_grid_offsets[bucket + 1]++;
+	}
+
+	for (uint32_t b(0); b < bucket_count; b++) {
+		agent_grid_offsets[b + 1] += agent_grid_offsets[b];
+	}
+
+	agent_grid_agents.resize(agent_count);
+	agent_grid_x.resize(agent_count);
+	agent_grid_y.resize(agent_count);
+	agent_grid_z.resize(agent_count);
+
+	std::vector<uint32_t> cursors(agent_grid_offsets.begin(), agent_grid_offsets.end() - 1);
+	for (uint32_t i(0); i < agent_count; i++) {
+		const uint32_t slot = cursors[agent_grid_buckets[i]]++;
+		RVO::Agent *agent = agents[i]->get_agent();
+		agent_grid_agents[slot] = agent;
+		agent_grid_x[slot] = agent->position_.x();
+		agent_grid_y[slot] = agent->position_.y();
+		agent_grid_z[slot] = agent->position_.z();
+	}
+}
+
+void NavMap::_compute_agent_neighbors(RVO::Agent *p_agent) const {
+	p_agent->agentNeighbors_.clear();
+	if (p_agent->maxNeighbors_ == 0) {
+		return;
+	}
+
+	float range_sq = p_agent->neighborDist_ * p_agent->neighborDist_;
+	const float x = p_agent->position_.x();
+	const float y = p_agent->position_.y();
+	const float z = p_agent->position_.z();
+	const int cell_x = int(Math::floor(x / agent_grid_cell_size));
+	const int cell_z = int(Math::floor(z / agent_grid_cell_size));
+
+	// Near cells may share a bucket, each bucket is visited once.
+	uint32_t visited[9];
+	int visited_count = 0;
+
+	for (int dz = -1; dz <= 1; dz++) {
+		for (int dx = -1; dx <= 1; dx++) {
+			const uint32_t bucket = _get_agent_grid_bucket(cell_x + dx, cell_z + dz);
+			if (std::find(visited, visited + visited_count, bucket) != visited + visited_count) {
+				continue;
+			}
+			visited[visited_count++] = bucket;
+
+			for (uint32_t i = agent_grid_offsets[bucket]; i < agent_grid_offsets[bucket + 1]; i++) {
+				const float dist_sq = (agent_grid_x[i] - x) * (agent_grid_x[i] - x) + (agent_grid_y[i] - y) * (agent_grid_y[i] - y) + (agent_grid_z[i] - z) * (agent_grid_z[i] - z);
+				if (dist_sq < range_sq) {
+					p_agent->insertAgentNeighbor(agent_grid_agents[i], range_sq);
+				}
+			}
+		}
+	}
 }
 
 void NavMap::compute_single_step(uint32_t index, RvoAgent **agent) {
-	(*(agent + index))->get_agent()->computeNeighbors(&rvo);
+	_compute_agent_neighbors((*(agent + index))->get_agent());
 	(*(agent + index))->get_agent()->computeNewVelocity(deltatime);
 }
 
 void NavMap::step(real_t p_deltatime) {
 	deltatime = p_deltatime;
 	if (controlled_agents.size() > 0) {
+		// The agents moved since the last step.
+		_build_agent_grid();
+
 		thread_process_array(
 				controlled_agents.size(),
 				this,
@@ -34,8 +34,9 @@
 #include "nav_rid.h"
 
 #include "core/math/math_defs.h"
+#include "core/templates/hash_map.h"
 #include "nav_utils.h"
-#include <KdTree.h>
+#include <Agent.h>
 
 /**
 	@author AndreaCatania
@@ -59,16 +60,34 @@ class NavMap : public NavRid {
 	bool regenerate_polygons = true;
 	bool regenerate_links = true;
 
-	std::vector<NavRegion *> regions;
-
-	/// Map polygons
-	std::vector<gd::Polygon> polygons;
+	/// Set when the polygons or their connections changed since the last sync.
+	bool links_dirty = false;
 
-	/// Rvo world
-	RVO::KdTree rvo;
+	std::vector<NavRegion *> regions;
 
-	/// Is agent array modified?
-	bool agents_dirty = false;
+	/// Total number of polygons of all the regions.
+	uint32_t polygon_count = 0;
+
+	/// Connections between the polygons that share an edge, by edge key.
+	HashMap<gd::EdgeKey, gd::Connection, gd::EdgeKeyHasher> edge_connections;
+
+	/// Regions with free edges to connect to the near regions on the next sync.
+	std::vector<NavRegion *> regions_to_link;
+
+	/// Uniform grid over the agents positions on the XZ plane, rebuilt every
+	/// step to find the agents neighbors. The cells are hashed into buckets.
+	real_t agent_grid_cell_size = 1.0;
+	uint32_t agent_grid_bucket_mask = 0;
+	/// The agents of the bucket `i` are in the range [offsets[i], offsets[i + 1]).
+	std::vector<uint32_t> agent_grid_offsets;
+	/// The agents sorted by bucket, with their positions stored per component
+	/// so the neighbor queries scan contiguous memory.
+	std::vector<RVO::Agent *> agent_grid_agents;
+	std::vector<float> agent_grid_x;
+	std::vector<float> agent_grid_y;
+	std::vector<float> agent_grid_z;
+	/// Bucket of each agent, in `agents` order.
+	std::vector<uint32_t> agent_grid_buckets;
 
 	/// All the Agents (even the controlled one)
 	std::vector<RvoAgent *> agents;
@@ -133,6 +152,19 @@ public:
 	void dispatch_callbacks();
 
 private:
+	void _connect_region(NavRegion *p_region);
+	void _disconnect_region(NavRegion *p_region);
+	void _link_free_edges(NavRegion *p_region);
+	void _queue_region_link(NavRegion *p_region);
+
+	const gd::Polygon *_get_closest_polygon(const Vector3 &p_point, Vector3 *r_point, Vector3 *r_normal = nullptr) const;
+
+	uint32_t _get_agent_grid_bucket(int p_x, int p_z) const {
+		return (uint32_t(p_x) * 73856093u ^ uint32_t(p_z) * 19349663u) & agent_grid_bucket_mask;
+	}
+	void _build_agent_grid();
+	void _compute_agent_neighbors(RVO::Agent *p_agent) const;
+
 	void compute_single_step(uint32_t index, RvoAgent **agent);
 	void clip_path(const std::vector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly) const;
 };
@@ -32,6 +32,8 @@
 
 #include "nav_map.h"
 
+#include <algorithm>
+
 /**
 	@author AndreaCatania
 */
@@ -64,6 +66,8 @@ void NavRegion::update_polygons() {
 		return;
 	}
 	polygons.clear();
+	polygons_bvh.clear();
+	polygons_bvh_root = -1;
 	polygons_dirty = false;
 
 	if (map == nullptr) {
@@ -88,6 +92,7 @@ void NavRegion::update_polygons() {
 	for (size_t i(0); i < polygons.size(); i++) {
 		gd::Polygon &p = polygons[i];
 		p.owner = this;
+		p.id = i;
 
 		Vector<int> mesh_poly = mesh->get_polygon(i);
 		const int *indices = mesh_poly.ptr();
@@ -128,4 +133,144 @@ void NavRegion::update_polygons() {
 			p.center = center / float(mesh_poly.size());
 		}
 	}
+
+	build_polygons_bvh();
+}
+
+AABB NavRegion::get_aabb() const {
+	if (polygons_bvh_root == -1) {
+		return AABB();
+	}
+	return polygons_bvh[polygons_bvh_root].aabb;
+}
+
+void NavRegion::build_polygons_bvh() {
+	std::vector<int> nodes;
+	nodes.reserve(polygons.size());
+	polygons_bvh.reserve(polygons.size() * 2);
+
+	for (size_t poly_id(0); poly_id < polygons.size(); poly_id++) {
+		const gd::Polygon &p = polygons[poly_id];
+		if (p.points.size() < 3) {
+			// No faces to query.
+			continue;
+		}
+
+		PolygonBVH leaf;
+		leaf.aabb.position = p.points[0].pos;
+		for (size_t point_id = 1; point_id < p.points.size(); point_id++) {
+			leaf.aabb.expand_to(p.points[point_id].pos);
+		}
+		leaf.poly_id = poly_id;
+
+		nodes.push_back(polygons_bvh.size());
+		polygons_bvh.push_back(leaf);
+	}
+
+	if (nodes.size()) {
+		polygons_bvh_root = create_polygons_bvh(nodes, 0, nodes.size());
+	}
+}
+
+int NavRegion::create_polygons_bvh(std::vector<int> &p_nodes, int p_from, int p_size) {
+	if (p_size == 1) {
+		return p_nodes[p_from];
+	}
+
+	AABB aabb = polygons_bvh[p_nodes[p_from]].aabb;
+	for (int i = 1; i < p_size; i++) {
+		aabb.merge_with(polygons_bvh[p_nodes[p_from + i]].aabb);
+	}
+
+	// Split at the median along the longest axis.
+	const int axis = aabb.get_longest_axis_index();
+	std::nth_element(
+			p_nodes.begin() + p_from,
+			p_nodes.begin() + p_from + p_size / 2,
+			p_nodes.begin() + p_from + p_size,
+			[this, axis](int p_a, int p_b) {
+				const AABB &a = polygons_bvh[p_a].aabb;
+				const AABB &b = polygons_bvh[p_b].aabb;
+				return a.position[axis] + a.size[axis] * 0.5 < b.position[axis] + b.size[axis] * 0.5;
+			});
+
+	const int left = create_polygons_bvh(p_nodes, p_from, p_size / 2);
+	const int right = create_polygons_bvh(p_nodes, p_from + p_size / 2, p_size - p_size / 2);
+
+	PolygonBVH node;
+	node.aabb = aabb;
+	node.left = left;
+	node.right = right;
+
+	polygons_bvh.push_back(node);
+	return polygons_bvh.size() - 1;
+}
+
+static _FORCE_INLINE_ real_t _aabb_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+	real_t d = 0.0;
+	for (int i = 0; i < 3; i++) {
+		const real_t min = p_aabb.position[i];
+		const real_t max = min + p_aabb.size[i];
+		if (p_point[i] < min) {
+			d += (min - p_point[i]) * (min - p_point[i]);
+		} else if (p_point[i] > max) {
+			d += (p_point[i] - max) * (p_point[i] - max);
+		}
+	}
+	return d;
+}
+
+const gd::Polygon *NavRegion::get_closest_polygon(const Vector3 &p_point, real_t &r_closest_d, Vector3 *r_point, Vector3 *r_normal) const {
+	const gd::Polygon *closest_poly = nullptr;
+
+	if (polygons_bvh_root == -1) {
+		return nullptr;
+	}
+
+	// The tree is balanced, so its depth is bounded by log2 of the polygon count.
+	int stack[64];
+	int stack_size = 0;
+	stack[stack_size++] = polygons_bvh_root;
+
+	while (stack_size) {
+		const PolygonBVH &node = polygons_bvh[stack[--stack_size]];
+		if (_aabb_distance_squared(node.aabb, p_point) >= r_closest_d) {
+			continue;
+		}
+
+		if (node.poly_id != -1) {
+			const gd::Polygon &p = polygons[node.poly_id];
+
+			// For each point cast a face and check the distance to the point
+			for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
+				const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+				const Vector3 inters = f.get_closest_point_to(p_point);
+				const real_t d = inters.distance_squared_to(p_point);
+				if (d < r_closest_d) {
+					closest_poly = &p;
+					r_closest_d = d;
+					*r_point = inters;
+					if (r_normal) {
+						*r_normal = f.get_plane().normal;
+					}
+				}
+			}
+			continue;
+		}
+
+		ERR_CONTINUE(stack_size + 2 > 64);
+
+		// Visit the nearest child first, so the farthest one can be discarded early.
+		const real_t left_d = _aabb_distance_squared(polygons_bvh[node.left].aabb, p_point);
+		const real_t right_d = _aabb_distance_squared(polygons_bvh[node.right].aabb, p_point);
+		if (left_d < right_d) {
+			stack[stack_size++] = node.right;
+			stack[stack_size++] = node.left;
+		} else {
+			stack[stack_size++] = node.left;
+			stack[stack_size++] = node.right;
+		}
+	}
+
+	return closest_poly;
 }
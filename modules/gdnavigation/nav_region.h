@@ -54,6 +54,21 @@ class NavRegion : public NavRid {
 	/// Cache
 	std::vector<gd::Polygon> polygons;
 
+	/// The id of the first polygon of this region in the map.
+	uint32_t polygons_offset = 0;
+
+	/// Bounding volume hierarchy over the polygons, used by the closest
+	/// point queries. Rebuilt together with the polygons.
+	struct PolygonBVH {
+		AABB aabb;
+		int left = -1;
+		int right = -1;
+		int poly_id = -1;
+	};
+
+	std::vector<PolygonBVH> polygons_bvh;
+	int polygons_bvh_root = -1;
+
 public:
 	NavRegion() {}
 
@@ -61,6 +76,10 @@ public:
 		polygons_dirty = true;
 	}
 
+	bool is_polygons_dirty() const {
+		return polygons_dirty;
+	}
+
 	void set_map(NavMap *p_map);
 	NavMap *get_map() const {
 		return map;
@@ -80,10 +99,30 @@ public:
 		return polygons;
 	}
 
+	std::vector<gd::Polygon> &get_polygons() {
+		return polygons;
+	}
+
+	void set_polygons_offset(uint32_t p_offset) {
+		polygons_offset = p_offset;
+	}
+	uint32_t get_polygons_offset() const {
+		return polygons_offset;
+	}
+
+	/// Returns the bounds of all the polygons.
+	AABB get_aabb() const;
+
+	/// Returns the polygon with the face closest to the point, if that face
+	/// is closer than `r_closest_d` (squared distance), updating it.
+	const gd::Polygon *get_closest_polygon(const Vector3 &p_point, real_t &r_closest_d, Vector3 *r_point, Vector3 *r_normal) const;
+
 	bool sync();
 
 private:
 	void update_polygons();
+	void build_polygons_bvh();
+	int create_polygons_bvh(std::vector<int> &p_nodes, int p_from, int p_size);
 };
 
 #endif // NAV_REGION_H
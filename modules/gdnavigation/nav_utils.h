@@ -32,6 +32,7 @@
 #define NAV_UTILS_H
 
 #include "core/math/vector3.h"
+#include "core/templates/hashfuncs.h"
 
 #include <vector>
 
@@ -63,6 +64,10 @@ struct EdgeKey {
 		return (a.key == p_key.a.key) ? (b.key < p_key.b.key) : (a.key < p_key.a.key);
 	}
 
+	bool operator==(const EdgeKey &p_key) const {
+		return a.key == p_key.a.key && b.key == p_key.b.key;
+	}
+
 	EdgeKey(const PointKey &p_a = PointKey(), const PointKey &p_b = PointKey()) :
 			a(p_a),
 			b(p_b) {
@@ -72,6 +77,12 @@ struct EdgeKey {
 	}
 };
 
+struct EdgeKeyHasher {
+	static _FORCE_INLINE_ uint32_t hash(const EdgeKey &p_key) {
+		return hash_djb2_one_32(hash_one_uint64(p_key.b.key), hash_one_uint64(p_key.a.key));
+	}
+};
+
 struct Point {
 	Vector3 pos;
 	PointKey key;
@@ -93,6 +104,9 @@ struct Edge {
 struct Polygon {
 	NavRegion *owner;
 
+	/// The index of this `Polygon` in the owner region polygons.
+	uint32_t id = 0;
+
 	/// The points of this `Polygon`
 	std::vector<Point> points;
 
@@ -127,8 +141,12 @@ struct NavigationPoly {
 	Vector3 entry;
 	/// The distance to the destination.
 	float traveled_distance = 0.0;
+	/// The traveled distance plus the estimate to the destination, the open list is ordered by it.
+	float cost = 0.0;
+	/// The position in the open list, -1 when not in it.
+	int heap_index = -1;
 
-	NavigationPoly(const Polygon *p_poly) :
+	NavigationPoly(const Polygon *p_poly = nullptr) :
 			poly(p_poly) {}
 
 	bool operator==(const NavigationPoly &other) const {
@@ -140,6 +158,93 @@ struct NavigationPoly {
 	}
 };
 
+/// Binary min heap of `NavigationPoly` ids ordered by cost, used as the open list
+/// of the path search. It keeps `NavigationPoly::heap_index` updated so the cost
+/// of a poly already in the list can be lowered in place.
+class NavigationPolyHeap {
+	std::vector<NavigationPoly> &navigation_polys;
+	std::vector<uint32_t> heap;
+
+	void set(uint32_t p_pos, uint32_t p_id) {
+		heap[p_pos] = p_id;
+		navigation_polys[p_id].heap_index = p_pos;
+	}
+
+	void shift_up(uint32_t p_pos) {
+		const uint32_t id = heap[p_pos];
+		const float cost = navigation_polys[id].cost;
+		while (p_pos > 0) {
+			const uint32_t parent = (p_pos - 1) / 2;
+			if (navigation_polys[heap[parent]].cost <= cost) {
+				break;
+			}
+			set(p_pos, heap[parent]);
+			p_pos = parent;
+		}
+		set(p_pos, id);
+	}
+
+	void shift_down(uint32_t p_pos) {
+		const uint32_t id = heap[p_pos];
+		const float cost = navigation_polys[id].cost;
+		const uint32_t size = heap.size();
+		while (true) {
+			uint32_t child = p_pos * 2 + 1;
+			if (child >= size) {
+				break;
+			}
+			if (child + 1 < size && navigation_polys[heap[child + 1]].cost < navigation_polys[heap[child]].cost) {
+				child++;
+			}
+			if (cost <= navigation_polys[heap[child]].cost) {
+				break;
+			}
+			set(p_pos, heap[child]);
+			p_pos = child;
+		}
+		set(p_pos, id);
+	}
+
+public:
+	bool empty() const {
+		return heap.empty();
+	}
+
+	void push(uint32_t p_id) {
+		heap.push_back(p_id);
+		shift_up(heap.size() - 1);
+	}
+
+	/// Removes and returns the id with the least cost.
+	uint32_t pop() {
+		const uint32_t id = heap[0];
+		navigation_polys[id].heap_index = -1;
+		const uint32_t last = heap.back();
+		heap.pop_back();
+		if (!heap.empty()) {
+			heap[0] = last;
+			shift_down(0);
+		}
+		return id;
+	}
+
+	/// To call after changing the cost of an id in the list.
+	void update(uint32_t p_id) {
+		shift_up(navigation_polys[p_id].heap_index);
+		shift_down(navigation_polys[p_id].heap_index);
+	}
+
+	void clear() {
+		for (size_t i = 0; i < heap.size(); i++) {
+			navigation_polys[heap[i]].heap_index = -1;
+		}
+		heap.clear();
+	}
+
+	NavigationPolyHeap(std::vector<NavigationPoly> &p_navigation_polys) :
+			navigation_polys(p_navigation_polys) {}
+};
+
 struct FreeEdge {
 	bool is_free;
 	Polygon *poly;
@@ -34,6 +34,7 @@
 
 #include "core/math/quick_hull.h"
 #include "core/os/thread.h"
+#include "core/os/threaded_array_processor.h"
 #include "scene/3d/collision_shape_3d.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/physics_body_3d.h"
@@ -273,6 +274,42 @@ void NavigationMeshGenerator::_parse_geometry(Transform p_accumulated_transform,
 	}
 }
 
+void NavigationMeshGenerator::_parse_navigation_mesh_geometry(Ref<NavigationMesh> p_nav_mesh, Node *p_node, Vector<float> &p_verticies, Vector<int> &p_indices) {
+	List<Node *> parse_nodes;
+
+	if (p_nav_mesh->get_source_geometry_mode() == NavigationMesh::SOURCE_GEOMETRY_NAVMESH_CHILDREN) {
+		parse_nodes.push_back(p_node);
+	} else {
+		p_node->get_tree()->get_nodes_in_group(p_nav_mesh->get_source_group_name(), &parse_nodes);
+	}
+
+	Transform navmesh_xform = Object::cast_to<Node3D>(p_node)->get_transform().affine_inverse();
+	for (const List<Node *>::Element *E = parse_nodes.front(); E; E = E->next()) {
+		int geometry_type = p_nav_mesh->get_parsed_geometry_type();
+		uint32_t collision_mask = p_nav_mesh->get_collision_mask();
+		bool recurse_children = p_nav_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
+		_parse_geometry(navmesh_xform, E->get(), p_verticies, p_indices, geometry_type, collision_mask, recurse_children);
+	}
+}
+
+void NavigationMeshGenerator::_setup_recast_config(Ref<NavigationMesh> p_nav_mesh, rcConfig &r_cfg) {
+	memset(&r_cfg, 0, sizeof(r_cfg));
+
+	r_cfg.cs = p_nav_mesh->get_cell_size();
+	r_cfg.ch = p_nav_mesh->get_cell_height();
+	r_cfg.walkableSlopeAngle = p_nav_mesh->get_agent_max_slope();
+	r_cfg.walkableHeight = (int)Math::ceil(p_nav_mesh->get_agent_height() / r_cfg.ch);
+	r_cfg.walkableClimb = (int)Math::floor(p_nav_mesh->get_agent_max_climb() / r_cfg.ch);
+	r_cfg.walkableRadius = (int)Math::ceil(p_nav_mesh->get_agent_radius() / r_cfg.cs);
+	r_cfg.maxEdgeLen = (int)(p_nav_mesh->get_edge_max_length() / p_nav_mesh->get_cell_size());
+	r_cfg.maxSimplificationError = p_nav_mesh->get_edge_max_error();
+	r_cfg.minRegionArea = (int)(p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size());
+	r_cfg.mergeRegionArea = (int)(p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size());
+	r_cfg.maxVertsPerPoly = (int)p_nav_mesh->get_verts_per_poly();
+	r_cfg.detailSampleDist = p_nav_mesh->get_detail_sample_distance() < 0.9f ? 0 : p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance();
+	r_cfg.detailSampleMaxError = p_nav_mesh->get_cell_height() * p_nav_mesh->get_detail_sample_max_error();
+}
+
 void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh) {
 	Vector<Vector3> nav_vertices;
 
@@ -329,21 +366,7 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 	rcCalcBounds(verts, nverts, bmin, bmax);
 
 	rcConfig cfg;
-	memset(&cfg, 0, sizeof(cfg));
-
-	cfg.cs = p_nav_mesh->get_cell_size();
-	cfg.ch = p_nav_mesh->get_cell_height();
-	cfg.walkableSlopeAngle = p_nav_mesh->get_agent_max_slope();
-	cfg.walkableHeight = (int)Math::ceil(p_nav_mesh->get_agent_height() / cfg.ch);
-	cfg.walkableClimb = (int)Math::floor(p_nav_mesh->get_agent_max_climb() / cfg.ch);
-	cfg.walkableRadius = (int)Math::ceil(p_nav_mesh->get_agent_radius() / cfg.cs);
-	cfg.maxEdgeLen = (int)(p_nav_mesh->get_edge_max_length() / p_nav_mesh->get_cell_size());
-	cfg.maxSimplificationError = p_nav_mesh->get_edge_max_error();
-	cfg.minRegionArea = (int)(p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size());
-	cfg.mergeRegionArea = (int)(p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size());
-	cfg.maxVertsPerPoly = (int)p_nav_mesh->get_verts_per_poly();
-	cfg.detailSampleDist = p_nav_mesh->get_detail_sample_distance() < 0.9f ? 0 : p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance();
-	cfg.detailSampleMaxError = p_nav_mesh->get_cell_height() * p_nav_mesh->get_detail_sample_max_error();
+	_setup_recast_config(p_nav_mesh, cfg);
 
 	cfg.bmin[0] = bmin[0];
 	cfg.bmin[1] = bmin[1];
@@ -477,6 +500,286 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 	detail_mesh = nullptr;
 }
 
+/// Owns the Recast intermediate data of a tile, freed when the tile is done.
+struct RecastTileData {
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+
+	~RecastTileData() {
+		rcFreeHeightField(hf);
+		rcFreeCompactHeightfield(chf);
+		rcFreeContourSet(cset);
+		rcFreePolyMesh(poly_mesh);
+		rcFreePolyMeshDetail(detail_mesh);
+	}
+};
+
+void NavigationMeshGenerator::_get_tiles_in_bounds(Ref<NavigationMesh> p_nav_mesh, const Vector3 &p_from, const Vector3 &p_to, Vector<BakeTile> &r_tiles) {
+	const float tile_width = p_nav_mesh->get_tile_size() * p_nav_mesh->get_cell_size();
+	const int from_x = (int)Math::floor(p_from.x / tile_width);
+	const int from_z = (int)Math::floor(p_from.z / tile_width);
+	const int to_x = (int)Math::floor(p_to.x / tile_width);
+	const int to_z = (int)Math::floor(p_to.z / tile_width);
+
+	r_tiles.resize((to_x - from_x + 1) * (to_z - from_z + 1));
+	int tile_id = 0;
+	for (int z = from_z; z <= to_z; z++) {
+		for (int x = from_x; x <= to_x; x++) {
+			r_tiles.write[tile_id].x = x;
+			r_tiles.write[tile_id].z = z;
+			tile_id++;
+		}
+	}
+}
+
+void NavigationMeshGenerator::_get_tile_bounds(const rcConfig &p_cfg, int p_x, int p_z, float *r_bmin, float *r_bmax) {
+	// The tile is enlarged by a border, so the polygons on its sides match
+	// the ones of the nearby tiles.
+	const float tile_width = p_cfg.tileSize * p_cfg.cs;
+	const float border_width = p_cfg.borderSize * p_cfg.cs;
+	r_bmin[0] = p_x * tile_width - border_width;
+	r_bmin[2] = p_z * tile_width - border_width;
+	r_bmax[0] = (p_x + 1) * tile_width + border_width;
+	r_bmax[2] = (p_z + 1) * tile_width + border_width;
+}
+
+void NavigationMeshGenerator::TiledBake::bake_tile(uint32_t p_index, void *p_userdata) {
+	NavigationMeshGenerator::_bake_tile(this, p_index);
+}
+
+void NavigationMeshGenerator::_bake_tile(TiledBake *p_bake, uint32_t p_index) {
+	BakeTile &tile = p_bake->tiles[p_index];
+
+	rcConfig cfg = p_bake->cfg;
+	_get_tile_bounds(cfg, tile.x, tile.z, cfg.bmin, cfg.bmax);
+
+	// Only the triangles overlapping the tile are rasterized.
+	const int tris_begin = p_bake->tile_tri_offsets[p_index];
+	const int ntris = p_bake->tile_tri_offsets[p_index + 1] - tris_begin;
+	if (ntris == 0) {
+		return;
+	}
+
+	Vector<int> tris;
+	tris.resize(ntris * 3);
+	int *tris_w = tris.ptrw();
+	for (int i = 0; i < ntris; i++) {
+		const int tri = p_bake->tile_tris[tris_begin + i];
+		tris_w[i * 3 + 0] = p_bake->tris[tri * 3 + 0];
+		tris_w[i * 3 + 1] = p_bake->tris[tri * 3 + 1];
+		tris_w[i * 3 + 2] = p_bake->tris[tri * 3 + 2];
+	}
+
+	rcContext ctx;
+	RecastTileData data;
+
+	data.hf = rcAllocHeightfield();
+	ERR_FAIL_COND(!data.hf);
+	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *data.hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+
+	{
+		Vector<unsigned char> tri_areas;
+		tri_areas.resize(ntris);
+		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, p_bake->verts, p_bake->nverts, tris.ptr(), ntris, tri_areas.ptrw());
+
+		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, p_bake->verts, p_bake->nverts, tris.ptr(), tri_areas.ptr(), ntris, *data.hf, cfg.walkableClimb));
+	}
+
+	if (p_bake->filter_low_hanging_obstacles) {
+		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *data.hf);
+	}
+	if (p_bake->filter_ledge_spans) {
+		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *data.hf);
+	}
+	if (p_bake->filter_walkable_low_height_spans) {
+		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *data.hf);
+	}
+
+	data.chf = rcAllocCompactHeightfield();
+	ERR_FAIL_COND(!data.chf);
+	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *data.hf, *data.chf));
+
+	rcFreeHeightField(data.hf);
+	data.hf = nullptr;
+
+	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *data.chf));
+
+	if (p_bake->partition_type == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
+		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *data.chf));
+		ERR_FAIL_COND(!rcBuildRegions(&ctx, *data.chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+	} else if (p_bake->partition_type == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
+		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *data.chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+	} else {
+		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *data.chf, cfg.borderSize, cfg.minRegionArea));
+	}
+
+	data.cset = rcAllocContourSet();
+	ERR_FAIL_COND(!data.cset);
+	ERR_FAIL_COND(!rcBuildContours(&ctx, *data.chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *data.cset));
+
+	data.poly_mesh = rcAllocPolyMesh();
+	ERR_FAIL_COND(!data.poly_mesh);
+	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *data.cset, cfg.maxVertsPerPoly, *data.poly_mesh));
+
+	data.detail_mesh = rcAllocPolyMeshDetail();
+	ERR_FAIL_COND(!data.detail_mesh);
+	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *data.poly_mesh, *data.chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *data.detail_mesh));
+
+	const rcPolyMeshDetail *detail_mesh = data.detail_mesh;
+	tile.vertices.resize(detail_mesh->nverts);
+	for (int i = 0; i < detail_mesh->nverts; i++) {
+		const float *v = &detail_mesh->verts[i * 3];
+		tile.vertices.write[i] = Vector3(v[0], v[1], v[2]);
+	}
+
+	for (int i = 0; i < detail_mesh->nmeshes; i++) {
+		const unsigned int *m = &detail_mesh->meshes[i * 4];
+		const unsigned int bverts = m[0];
+		const unsigned int btris = m[2];
+		const unsigned int detail_ntris = m[3];
+		const unsigned char *detail_tris = &detail_mesh->tris[btris * 4];
+		for (unsigned int j = 0; j < detail_ntris; j++) {
+			Vector<int> nav_indices;
+			nav_indices.resize(3);
+			// Polygon order in recast is opposite than godot's
+			nav_indices.write[0] = ((int)(bverts + detail_tris[j * 4 + 0]));
+			nav_indices.write[1] = ((int)(bverts + detail_tris[j * 4 + 2]));
+			nav_indices.write[2] = ((int)(bverts + detail_tris[j * 4 + 1]));
+			tile.polygons.push_back(nav_indices);
+		}
+	}
+}
+
+void NavigationMeshGenerator::_bake_tiles(Ref<NavigationMesh> p_nav_mesh, Vector<float> &p_vertices, Vector<int> &p_indices, Vector<BakeTile> &r_tiles) {
+	if (r_tiles.size() == 0) {
+		return;
+	}
+
+	TiledBake bake;
+	bake.verts = p_vertices.ptr();
+	bake.nverts = p_vertices.size() / 3;
+	bake.tris = p_indices.ptr();
+	bake.ntris = p_indices.size() / 3;
+	bake.partition_type = p_nav_mesh->get_sample_partition_type();
+	bake.filter_low_hanging_obstacles = p_nav_mesh->get_filter_low_hanging_obstacles();
+	bake.filter_ledge_spans = p_nav_mesh->get_filter_ledge_spans();
+	bake.filter_walkable_low_height_spans = p_nav_mesh->get_filter_walkable_low_height_spans();
+
+	float bmin[3], bmax[3];
+	rcCalcBounds(bake.verts, bake.nverts, bmin, bmax);
+
+	_setup_recast_config(p_nav_mesh, bake.cfg);
+	bake.cfg.tileSize = p_nav_mesh->get_tile_size();
+	bake.cfg.borderSize = bake.cfg.walkableRadius + 3;
+	bake.cfg.width = bake.cfg.tileSize + bake.cfg.borderSize * 2;
+	bake.cfg.height = bake.cfg.tileSize + bake.cfg.borderSize * 2;
+	bake.cfg.bmin[1] = bmin[1];
+	bake.cfg.bmax[1] = bmax[1];
+
+	bake.tri_bounds.resize(bake.ntris * 4);
+	float *tri_bounds = bake.tri_bounds.ptrw();
+	for (int i = 0; i < bake.ntris; i++) {
+		const float *a = &bake.verts[bake.tris[i * 3 + 0] * 3];
+		const float *b = &bake.verts[bake.tris[i * 3 + 1] * 3];
+		const float *c = &bake.verts[bake.tris[i * 3 + 2] * 3];
+		tri_bounds[i * 4 + 0] = MIN(a[0], MIN(b[0], c[0]));
+		tri_bounds[i * 4 + 1] = MIN(a[2], MIN(b[2], c[2]));
+		tri_bounds[i * 4 + 2] = MAX(a[0], MAX(b[0], c[0]));
+		tri_bounds[i * 4 + 3] = MAX(a[2], MAX(b[2], c[2]));
+	}
+
+	// Buckets the triangles by the tiles they overlap, once, instead of
+	// testing every triangle against every tile. The tiles are a row major
+	// rectangle, as made by `_get_tiles_in_bounds`.
+	const int from_x = r_tiles[0].x;
+	const int from_z = r_tiles[0].z;
+	const int to_x = r_tiles[r_tiles.size() - 1].x;
+	const int to_z = r_tiles[r_tiles.size() - 1].z;
+	const int tiles_per_row = to_x - from_x + 1;
+	ERR_FAIL_COND(tiles_per_row * (to_z - from_z + 1) != r_tiles.size());
+
+	const float tile_width = bake.cfg.tileSize * bake.cfg.cs;
+	const float border_width = bake.cfg.borderSize * bake.cfg.cs;
+
+	bake.tile_tri_offsets.resize(r_tiles.size() + 1);
+	int *tile_tri_offsets = bake.tile_tri_offsets.ptrw();
+	memset(tile_tri_offsets, 0, bake.tile_tri_offsets.size() * sizeof(int));
+	int *tile_tris = nullptr;
+
+	// First counts the triangles of each tile, then fills them in.
+	for (int pass = 0; pass < 2; pass++) {
+		for (int i = 0; i < bake.ntris; i++) {
+			const float *b = &tri_bounds[i * 4];
+			// One tile more on each side, the exact test below decides.
+			const int tri_from_x = MAX(from_x, (int)Math::floor((b[0] - border_width) / tile_width) - 1);
+			const int tri_from_z = MAX(from_z, (int)Math::floor((b[1] - border_width) / tile_width) - 1);
+			const int tri_to_x = MIN(to_x, (int)Math::floor((b[2] + border_width) / tile_width) + 1);
+			const int tri_to_z = MIN(to_z, (int)Math::floor((b[3] + border_width) / tile_width) + 1);
+
+			for (int z = tri_from_z; z <= tri_to_z; z++) {
+				for (int x = tri_from_x; x <= tri_to_x; x++) {
+					float tile_bmin[3], tile_bmax[3];
+					_get_tile_bounds(bake.cfg, x, z, tile_bmin, tile_bmax);
+					if (b[0] > tile_bmax[0] || b[2] < tile_bmin[0] || b[1] > tile_bmax[2] || b[3] < tile_bmin[2]) {
+						continue;
+					}
+
+					const int tile_id = (z - from_z) * tiles_per_row + (x - from_x);
+					if (pass == 0) {
+						tile_tri_offsets[tile_id + 1]++;
+					} else {
+						tile_tris[tile_tri_offsets[tile_id + 1]++] = i;
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			for (int t = 0; t < r_tiles.size(); t++) {
+				tile_tri_offsets[t + 1] += tile_tri_offsets[t];
+			}
+			bake.tile_tris.resize(tile_tri_offsets[r_tiles.size()]);
+			tile_tris = bake.tile_tris.ptrw();
+			// The tile `i` is filled from `tile_tri_offsets[i + 1]`, which
+			// ends up at its end, and so at the start of the next tile.
+			for (int t = r_tiles.size(); t > 0; t--) {
+				tile_tri_offsets[t] = tile_tri_offsets[t - 1];
+			}
+			tile_tri_offsets[0] = 0;
+		}
+	}
+
+	bake.tiles = r_tiles.ptrw();
+	thread_process_array(r_tiles.size(), &bake, &TiledBake::bake_tile, (void *)nullptr);
+}
+
+void NavigationMeshGenerator::_add_tiles_to_navigation_mesh(Ref<NavigationMesh> p_nav_mesh, const Vector<BakeTile> &p_tiles, Vector<Vector3> &p_vertices, Vector<Vector<int>> &p_polygons) {
+	for (int i = 0; i < p_tiles.size(); i++) {
+		const BakeTile &tile = p_tiles[i];
+		const int offset = p_vertices.size();
+		p_vertices.append_array(tile.vertices);
+
+		for (int j = 0; j < tile.polygons.size(); j++) {
+			Vector<int> polygon = tile.polygons[j];
+			int *w = polygon.ptrw();
+			for (int k = 0; k < polygon.size(); k++) {
+				w[k] += offset;
+			}
+			p_polygons.push_back(polygon);
+		}
+	}
+
+	p_nav_mesh->set_vertices(p_vertices);
+	p_nav_mesh->clear_polygons();
+	for (int i = 0; i < p_polygons.size(); i++) {
+		p_nav_mesh->add_polygon(p_polygons[i]);
+	}
+}
+
 NavigationMeshGenerator *NavigationMeshGenerator::get_singleton() {
 	return singleton;
 }
@@ -505,23 +808,17 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 	Vector<float> vertices;
 	Vector<int> indices;
 
-	List<Node *> parse_nodes;
-
-	if (p_nav_mesh->get_source_geometry_mode() == NavigationMesh::SOURCE_GEOMETRY_NAVMESH_CHILDREN) {
-		parse_nodes.push_back(p_node);
-	} else {
-		p_node->get_tree()->get_nodes_in_group(p_nav_mesh->get_source_group_name(), &parse_nodes);
-	}
+	_parse_navigation_mesh_geometry(p_nav_mesh, p_node, vertices, indices);
 
-	Transform navmesh_xform = Object::cast_to<Node3D>(p_node)->get_transform().affine_inverse();
-	for (const List<Node *>::Element *E = parse_nodes.front(); E; E = E->next()) {
-		int geometry_type = p_nav_mesh->get_parsed_geometry_type();
-		uint32_t collision_mask = p_nav_mesh->get_collision_mask();
-		bool recurse_children = p_nav_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
-		_parse_geometry(navmesh_xform, E->get(), vertices, indices, geometry_type, collision_mask, recurse_children);
-	}
+	if (vertices.size() > 0 && indices.size() > 0 && p_nav_mesh->get_tile_size() > 0) {
+#ifdef TOOLS_ENABLED
+		if (ep) {
+			ep->step(TTR("Baking tiles..."), 1);
+		}
+#endif
+		_bake_navigation_mesh_tiles(p_nav_mesh, vertices, indices);
 
-	if (vertices.size() > 0 && indices.size() > 0) {
+	} else if (vertices.size() > 0 && indices.size() > 0) {
 		rcHeightfield *hf = nullptr;
 		rcCompactHeightfield *chf = nullptr;
 		rcContourSet *cset = nullptr;
@@ -568,6 +865,94 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 #endif
 }
 
+void NavigationMeshGenerator::rebake_tiles(Ref<NavigationMesh> p_nav_mesh, Node *p_node, const AABB &p_aabb) {
+	ERR_FAIL_COND(!p_nav_mesh.is_valid());
+	ERR_FAIL_COND_MSG(p_nav_mesh->get_tile_size() <= 0, "Only a navigation mesh baked in tiles can be partially rebaked.");
+	ERR_FAIL_COND_MSG(p_aabb.size.x <= 0 || p_aabb.size.z <= 0, "The AABB of the tiles to rebake must have a positive width and depth.");
+
+	Vector<float> vertices;
+	Vector<int> indices;
+
+	_parse_navigation_mesh_geometry(p_nav_mesh, p_node, vertices, indices);
+
+	_rebake_navigation_mesh_tiles(p_nav_mesh, vertices, indices, p_aabb);
+}
+
+void NavigationMeshGenerator::_bake_navigation_mesh_tiles(Ref<NavigationMesh> p_nav_mesh, Vector<float> &p_vertices, Vector<int> &p_indices) {
+	float bmin[3], bmax[3];
+	rcCalcBounds(p_vertices.ptr(), p_vertices.size() / 3, bmin, bmax);
+
+	Vector<BakeTile> tiles;
+	_get_tiles_in_bounds(p_nav_mesh, Vector3(bmin[0], bmin[1], bmin[2]), Vector3(bmax[0], bmax[1], bmax[2]), tiles);
+
+	_bake_tiles(p_nav_mesh, p_vertices, p_indices, tiles);
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	_add_tiles_to_navigation_mesh(p_nav_mesh, tiles, nav_vertices, nav_polygons);
+}
+
+void NavigationMeshGenerator::_rebake_navigation_mesh_tiles(Ref<NavigationMesh> p_nav_mesh, Vector<float> &p_vertices, Vector<int> &p_indices, const AABB &p_aabb) {
+	Vector<BakeTile> tiles;
+	_get_tiles_in_bounds(p_nav_mesh, p_aabb.position, p_aabb.position + p_aabb.size, tiles);
+	ERR_FAIL_COND(tiles.size() == 0);
+
+	// Keeps the polygons of the other tiles. Each polygon lies inside the
+	// tile that generated it, so its center tells the tile.
+	const float tile_width = p_nav_mesh->get_tile_size() * p_nav_mesh->get_cell_size();
+	const int from_x = tiles[0].x;
+	const int from_z = tiles[0].z;
+	const int to_x = tiles[tiles.size() - 1].x;
+	const int to_z = tiles[tiles.size() - 1].z;
+
+	const Vector<Vector3> old_vertices = p_nav_mesh->get_vertices();
+	Vector<int> vertex_remap;
+	vertex_remap.resize(old_vertices.size());
+	for (int i = 0; i < vertex_remap.size(); i++) {
+		vertex_remap.write[i] = -1;
+	}
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	for (int i = 0; i < p_nav_mesh->get_polygon_count(); i++) {
+		Vector<int> polygon = p_nav_mesh->get_polygon(i);
+		if (polygon.size() == 0) {
+			continue;
+		}
+
+		Vector3 center;
+		for (int j = 0; j < polygon.size(); j++) {
+			ERR_FAIL_INDEX(polygon[j], old_vertices.size());
+			center += old_vertices[polygon[j]];
+		}
+		center /= polygon.size();
+
+		const int x = (int)Math::floor(center.x / tile_width);
+		const int z = (int)Math::floor(center.z / tile_width);
+		if (x >= from_x && x <= to_x && z >= from_z && z <= to_z) {
+			continue;
+		}
+
+		int *w = polygon.ptrw();
+		for (int j = 0; j < polygon.size(); j++) {
+			if (vertex_remap[w[j]] == -1) {
+				vertex_remap.write[w[j]] = nav_vertices.size();
+				nav_vertices.push_back(old_vertices[w[j]]);
+			}
+			w[j] = vertex_remap[w[j]];
+		}
+		nav_polygons.push_back(polygon);
+	}
+
+	if (p_vertices.size() > 0 && p_indices.size() > 0) {
+		_bake_tiles(p_nav_mesh, p_vertices, p_indices, tiles);
+	} else {
+		tiles.clear();
+	}
+
+	_add_tiles_to_navigation_mesh(p_nav_mesh, tiles, nav_vertices, nav_polygons);
+}
+
 void NavigationMeshGenerator::clear(Ref<NavigationMesh> p_nav_mesh) {
 	if (p_nav_mesh.is_valid()) {
 		p_nav_mesh->clear_polygons();
@@ -577,6 +962,7 @@ void NavigationMeshGenerator::clear(Ref<NavigationMesh> p_nav_mesh) {
 
 void NavigationMeshGenerator::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("bake", "nav_mesh", "root_node"), &NavigationMeshGenerator::bake);
+	ClassDB::bind_method(D_METHOD("rebake_tiles", "nav_mesh", "root_node", "aabb"), &NavigationMeshGenerator::rebake_tiles);
 	ClassDB::bind_method(D_METHOD("clear", "nav_mesh"), &NavigationMeshGenerator::clear);
 }
 
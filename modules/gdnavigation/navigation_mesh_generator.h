@@ -46,6 +46,38 @@ class NavigationMeshGenerator : public Object {
 
 	static NavigationMeshGenerator *singleton;
 
+	/// The output of a single tile of a tiled bake.
+	struct BakeTile {
+		int x = 0;
+		int z = 0;
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+	};
+
+	/// Read only data shared by the tiles baked in parallel.
+	struct TiledBake {
+		rcConfig cfg;
+		int partition_type = 0;
+		bool filter_low_hanging_obstacles = false;
+		bool filter_ledge_spans = false;
+		bool filter_walkable_low_height_spans = false;
+
+		const float *verts = nullptr;
+		int nverts = 0;
+		const int *tris = nullptr;
+		int ntris = 0;
+		/// The XZ bounds of each triangle: min x, min z, max x, max z.
+		Vector<float> tri_bounds;
+		/// The triangles overlapping the tile `i`, border included, are
+		/// `tile_tris[tile_tri_offsets[i]]` to `tile_tris[tile_tri_offsets[i + 1] - 1]`.
+		Vector<int> tile_tri_offsets;
+		Vector<int> tile_tris;
+
+		BakeTile *tiles = nullptr;
+
+		void bake_tile(uint32_t p_index, void *p_userdata);
+	};
+
 protected:
 	static void _bind_methods();
 
@@ -54,6 +86,9 @@ protected:
 	static void _add_faces(const PackedVector3Array &p_faces, const Transform &p_xform, Vector<float> &p_verticies, Vector<int> &p_indices);
 	static void _parse_geometry(Transform p_accumulated_transform, Node *p_node, Vector<float> &p_verticies, Vector<int> &p_indices, int p_generate_from, uint32_t p_collision_mask, bool p_recurse_children);
 
+	static void _parse_navigation_mesh_geometry(Ref<NavigationMesh> p_nav_mesh, Node *p_node, Vector<float> &p_verticies, Vector<int> &p_indices);
+	static void _setup_recast_config(Ref<NavigationMesh> p_nav_mesh, rcConfig &r_cfg);
+
 	static void _convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh);
 	static void _build_recast_navigation_mesh(
 			Ref<NavigationMesh> p_nav_mesh,
@@ -68,6 +103,16 @@ protected:
 			Vector<float> &vertices,
 			Vector<int> &indices);
 
+	static void _get_tiles_in_bounds(Ref<NavigationMesh> p_nav_mesh, const Vector3 &p_from, const Vector3 &p_to, Vector<BakeTile> &r_tiles);
+	static void _get_tile_bounds(const rcConfig &p_cfg, int p_x, int p_z, float *r_bmin, float *r_bmax);
+	static void _bake_tile(TiledBake *p_bake, uint32_t p_index);
+	static void _bake_tiles(Ref<NavigationMesh> p_nav_mesh, Vector<float> &p_vertices, Vector<int> &p_indices, Vector<BakeTile> &r_tiles);
+	static void _add_tiles_to_navigation_mesh(Ref<NavigationMesh> p_nav_mesh, const Vector<BakeTile> &p_tiles, Vector<Vector3> &p_vertices, Vector<Vector<int>> &p_polygons);
+
+	/// Tiled bake and partial rebake from already parsed geometry.
+	static void _bake_navigation_mesh_tiles(Ref<NavigationMesh> p_nav_mesh, Vector<float> &p_vertices, Vector<int> &p_indices);
+	static void _rebake_navigation_mesh_tiles(Ref<NavigationMesh> p_nav_mesh, Vector<float> &p_vertices, Vector<int> &p_indices, const AABB &p_aabb);
+
 public:
 	static NavigationMeshGenerator *get_singleton();
 
@@ -75,6 +120,7 @@ public:
 	~NavigationMeshGenerator();
 
 	void bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node);
+	void rebake_tiles(Ref<NavigationMesh> p_nav_mesh, Node *p_node, const AABB &p_aabb);
 	void clear(Ref<NavigationMesh> p_nav_mesh);
 };
 
@@ -42,6 +42,16 @@
 #include "navigation_mesh_editor_plugin.h"
 #endif
 
+#ifdef TESTS_ENABLED
+#include "tests/test_macros.h"
+
+namespace TestNavigation {
+// Defined in tests/test_navigation.cpp, steps a crowd of agents walking
+// across each other and prints the time spent by the avoidance.
+void benchmark_avoidance();
+} // namespace TestNavigation
+#endif
+
 /**
 	@author AndreaCatania
 */
@@ -80,3 +90,11 @@ void unregister_gdnavigation_types() {
 	}
 #endif
 }
+
+#ifdef TESTS_ENABLED
+void test_avoidance() {
+	TestNavigation::benchmark_avoidance();
+}
+
+REGISTER_TEST_COMMAND("navigation-avoidance", &test_avoidance);
+#endif
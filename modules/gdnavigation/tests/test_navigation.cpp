@@ -0,0 +1,644 @@
+/*************************************************************************/
+/*  test_navigation.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_navigation.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+#include "modules/gdnavigation/gd_navigation_server.h"
+#include "modules/gdnavigation/nav_map.h"
+#include "modules/gdnavigation/nav_region.h"
+#include "modules/gdnavigation/navigation_mesh_generator.h"
+#include "modules/gdnavigation/rvo_agent.h"
+#include "scene/resources/navigation_mesh.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavigation {
+
+void benchmark_avoidance() {
+	List<String> cmdline_args = OS::get_singleton()->get_cmdline_args();
+
+	// Usage: --test navigation-avoidance [agent count] [step count]
+	int agent_count = 10000;
+	int step_count = 120;
+	const List<String>::Element *E = cmdline_args.find("navigation-avoidance");
+	if (E && E->next() && E->next()->get().is_valid_integer()) {
+		E = E->next();
+		agent_count = E->get().to_int();
+		if (E->next() && E->next()->get().is_valid_integer()) {
+			step_count = E->next()->get().to_int();
+		}
+	}
+
+	ERR_FAIL_COND(agent_count <= 0);
+	ERR_FAIL_COND(step_count <= 0);
+
+	const real_t delta = 1.0 / 60.0;
+	const real_t spacing = 1.5;
+
+	NavMap *map = memnew(NavMap);
+	Vector<RvoAgent *> agents;
+
+	// The agents are placed on a circle and walk to the opposite side.
+	const real_t radius = Math::sqrt(real_t(agent_count)) * spacing;
+	for (int i = 0; i < agent_count; i++) {
+		RvoAgent *agent = memnew(RvoAgent);
+		agent->set_map(map);
+		map->add_agent(agent);
+		map->set_agent_as_controlled(agent);
+
+		const real_t angle = Math_TAU * i / agent_count;
+		const real_t ring = radius * (1.0 - 0.5 * (i % 4) / 4.0);
+		RVO::Agent *rvo_agent = agent->get_agent();
+		rvo_agent->position_ = RVO::Vector3(Math::cos(angle) * ring, 0.0, Math::sin(angle) * ring);
+		rvo_agent->neighborDist_ = 5.0;
+		rvo_agent->maxNeighbors_ = 10;
+		rvo_agent->timeHorizon_ = 1.0;
+		rvo_agent->radius_ = 0.5;
+		rvo_agent->maxSpeed_ = 2.0;
+		rvo_agent->ignore_y_ = true;
+
+		agents.push_back(agent);
+	}
+
+	print_line(vformat("Stepping %d agents for %d steps...", agent_count, step_count));
+
+	uint64_t step_usec = 0;
+	uint64_t max_step_usec = 0;
+	for (int s = 0; s < step_count; s++) {
+		for (int i = 0; i < agents.size(); i++) {
+			RVO::Agent *rvo_agent = agents[i]->get_agent();
+			const RVO::Vector3 target = -RVO::Vector3(Math::cos(Math_TAU * i / agent_count), 0.0, Math::sin(Math_TAU * i / agent_count)) * radius;
+			const RVO::Vector3 to_target = target - rvo_agent->position_;
+			const float dist = RVO::abs(to_target);
+			rvo_agent->prefVelocity_ = dist > rvo_agent->maxSpeed_ ? to_target * (rvo_agent->maxSpeed_ / dist) : to_target;
+		}
+
+		map->sync();
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		map->step(delta);
+		const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+		step_usec += elapsed;
+		max_step_usec = MAX(max_step_usec, elapsed);
+
+		for (int i = 0; i < agents.size(); i++) {
+			RVO::Agent *rvo_agent = agents[i]->get_agent();
+			rvo_agent->velocity_ = rvo_agent->newVelocity_;
+			rvo_agent->position_ += rvo_agent->velocity_ * delta;
+		}
+	}
+
+	print_line(vformat("Average step: %.3f ms, slowest step: %.3f ms.", step_usec / 1000.0 / step_count, max_step_usec / 1000.0));
+
+	for (int i = 0; i < agents.size(); i++) {
+		map->remove_agent(agents[i]);
+		memdelete(agents[i]);
+	}
+	memdelete(map);
+}
+
+class PathQueryReceiver : public Object {
+	GDCLASS(PathQueryReceiver, Object);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("path_found", "query", "path", "udata"), &PathQueryReceiver::path_found);
+	}
+
+public:
+	int calls = 0;
+	RID query;
+	Vector<Vector3> path;
+	Variant udata;
+
+	void path_found(RID p_query, const Vector<Vector3> &p_path, const Variant &p_udata) {
+		calls++;
+		query = p_query;
+		path = p_path;
+		udata = p_udata;
+	}
+};
+
+static Ref<NavigationMesh> create_strip_navmesh() {
+	// Two quads sharing the edge at x = 10.
+	Vector<Vector3> vertices;
+	vertices.push_back(Vector3(0, 0, 0));
+	vertices.push_back(Vector3(0, 0, 10));
+	vertices.push_back(Vector3(10, 0, 10));
+	vertices.push_back(Vector3(10, 0, 0));
+	vertices.push_back(Vector3(20, 0, 10));
+	vertices.push_back(Vector3(20, 0, 0));
+
+	Ref<NavigationMesh> navmesh;
+	navmesh.instance();
+	navmesh->set_vertices(vertices);
+
+	Vector<int> polygon;
+	polygon.push_back(0);
+	polygon.push_back(1);
+	polygon.push_back(2);
+	polygon.push_back(3);
+	navmesh->add_polygon(polygon);
+
+	polygon.write[0] = 3;
+	polygon.write[1] = 2;
+	polygon.write[2] = 4;
+	polygon.write[3] = 5;
+	navmesh->add_polygon(polygon);
+
+	return navmesh;
+}
+
+void path_query_test() {
+	GdNavigationServer *server = memnew(GdNavigationServer);
+	PathQueryReceiver *receiver = memnew(PathQueryReceiver);
+
+	RID map = server->map_create();
+	server->map_set_active(map, true);
+	RID region = server->region_create();
+	server->region_set_map(region, map);
+	server->region_set_navmesh(region, create_strip_navmesh());
+	server->process(0.0);
+
+	const Vector3 origin(1, 0, 1);
+	const Vector3 destination(19, 0, 9);
+	const Vector<Vector3> expected_path = server->map_get_path(map, origin, destination, true);
+	REQUIRE(expected_path.size() >= 2);
+
+	RID query = server->map_query_path(map, origin, destination, true, receiver, "path_found", 42);
+	CHECK_MESSAGE(!server->path_query_is_done(query), "The query should only be solved by process().");
+	CHECK(server->path_query_get_path(query).empty());
+
+	// A query freed before being solved is dropped without calling back.
+	RID dropped = server->map_query_path(map, origin, destination, true, receiver, "path_found");
+	server->free(dropped);
+
+	server->process(0.0);
+
+	CHECK(server->path_query_is_done(query));
+	CHECK_MESSAGE(
+			server->path_query_get_path(query) == expected_path,
+			"The queued query should find the same path as map_get_path().");
+	CHECK(receiver->calls == 1);
+	CHECK(receiver->query == query);
+	CHECK(receiver->path == expected_path);
+	CHECK(int(receiver->udata) == 42);
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(!server->path_query_is_done(dropped), "A freed query should be invalid.");
+	CHECK(server->path_query_get_path(dropped).empty());
+
+	// Callbacks that can't be called are reported and don't stop the others.
+	RID bad_query = server->map_query_path(map, origin, destination, true, receiver, "no_such_method");
+	RID good_query = server->map_query_path(map, origin, destination, true, receiver, "path_found", 7);
+	server->process(0.0);
+	ERR_PRINT_ON;
+
+	CHECK(server->path_query_is_done(bad_query));
+	CHECK(receiver->calls == 2);
+	CHECK(receiver->query == good_query);
+	CHECK(int(receiver->udata) == 7);
+
+	server->free(query);
+	server->free(bad_query);
+	server->free(good_query);
+	server->free(region);
+	server->free(map);
+	server->process(0.0);
+
+	memdelete(receiver);
+	memdelete(server);
+}
+
+static Ref<NavigationMesh> create_quad_navmesh() {
+	Vector<Vector3> vertices;
+	vertices.push_back(Vector3(0, 0, 0));
+	vertices.push_back(Vector3(0, 0, 10));
+	vertices.push_back(Vector3(10, 0, 10));
+	vertices.push_back(Vector3(10, 0, 0));
+
+	Ref<NavigationMesh> navmesh;
+	navmesh.instance();
+	navmesh->set_vertices(vertices);
+
+	Vector<int> polygon;
+	polygon.push_back(0);
+	polygon.push_back(1);
+	polygon.push_back(2);
+	polygon.push_back(3);
+	navmesh->add_polygon(polygon);
+
+	return navmesh;
+}
+
+static NavRegion *add_region(NavMap *p_map, const Ref<NavigationMesh> &p_navmesh, const Vector3 &p_origin) {
+	NavRegion *region = memnew(NavRegion);
+	region->set_mesh(p_navmesh);
+	region->set_transform(Transform(Basis(), p_origin));
+	p_map->add_region(region);
+	region->set_map(p_map);
+	return region;
+}
+
+static void remove_region(NavMap *p_map, NavRegion *p_region) {
+	p_map->remove_region(p_region);
+	p_region->set_map(nullptr);
+	memdelete(p_region);
+}
+
+/// Describes every polygon edge of the regions, and what it's connected to,
+/// using the index of the region in `p_regions`.
+static Vector<String> get_connections(const Vector<NavRegion *> &p_regions) {
+	Vector<String> connections;
+	for (int r = 0; r < p_regions.size(); r++) {
+		if (p_regions[r] == nullptr) {
+			continue;
+		}
+
+		const std::vector<gd::Polygon> &polygons = p_regions[r]->get_polygons();
+		for (size_t p = 0; p < polygons.size(); p++) {
+			for (size_t e = 0; e < polygons[p].edges.size(); e++) {
+				const gd::Edge &edge = polygons[p].edges[e];
+				String connection = vformat("%d:%d:%d -> ", r, int(p), int(e));
+				if (edge.other_polygon) {
+					connection += vformat("%d:%d:%d", p_regions.find(edge.other_polygon->owner), int(edge.other_polygon->id), edge.other_edge);
+				} else {
+					connection += "free";
+				}
+				connections.push_back(connection);
+			}
+		}
+	}
+	return connections;
+}
+
+/// Builds a new map with the same regions, so all its connections are made
+/// at once, and checks that the incrementally updated map has the same ones.
+static void check_connections_match_rebuild(NavMap *p_map, const Vector<NavRegion *> &p_regions) {
+	NavMap *rebuilt_map = memnew(NavMap);
+	Vector<NavRegion *> rebuilt_regions;
+	for (int r = 0; r < p_regions.size(); r++) {
+		if (p_regions[r] == nullptr) {
+			rebuilt_regions.push_back(nullptr);
+		} else {
+			rebuilt_regions.push_back(add_region(rebuilt_map, p_regions[r]->get_mesh(), p_regions[r]->get_transform().origin));
+		}
+	}
+	rebuilt_map->sync();
+
+	const Vector<String> connections = get_connections(p_regions);
+	const Vector<String> rebuilt_connections = get_connections(rebuilt_regions);
+	CHECK(connections.size() == rebuilt_connections.size());
+	for (int i = 0; i < MIN(connections.size(), rebuilt_connections.size()); i++) {
+		CHECK_MESSAGE(connections[i] == rebuilt_connections[i], vformat("Edge connection %s differs from the full rebuild %s.", connections[i], rebuilt_connections[i]));
+	}
+
+	const Vector3 from(1, 0, 1);
+	const Vector3 to(39, 0, 9);
+	CHECK(p_map->get_path(from, to, true) == rebuilt_map->get_path(from, to, true));
+
+	for (int r = 0; r < rebuilt_regions.size(); r++) {
+		if (rebuilt_regions[r]) {
+			remove_region(rebuilt_map, rebuilt_regions[r]);
+		}
+	}
+	memdelete(rebuilt_map);
+}
+
+void incremental_connections_test() {
+	Ref<NavigationMesh> navmesh = create_quad_navmesh();
+	NavMap *map = memnew(NavMap);
+
+	// A row of quads sharing their edges, one more quad 1 unit away from the
+	// end of the row, linked through the edge connection margin, and one
+	// sharing an edge with the first quad from above.
+	const Vector3 origins[5] = {
+		Vector3(0, 0, 0),
+		Vector3(10, 0, 0),
+		Vector3(20, 0, 0),
+		Vector3(31, 0, 0),
+		Vector3(0, 0, 10),
+	};
+
+	Vector<NavRegion *> regions;
+	regions.resize(5);
+	for (int r = 0; r < 3; r++) {
+		regions.write[r] = add_region(map, navmesh, origins[r]);
+	}
+	map->sync();
+	check_connections_match_rebuild(map, regions);
+
+	SUBCASE("Add, move and remove regions") {
+		regions.write[3] = add_region(map, navmesh, origins[3]);
+		regions.write[4] = add_region(map, navmesh, origins[4]);
+		map->sync();
+		check_connections_match_rebuild(map, regions);
+
+		// Moved away from every other region, then back.
+		regions[1]->set_transform(Transform(Basis(), Vector3(100, 0, 0)));
+		map->sync();
+		check_connections_match_rebuild(map, regions);
+
+		regions[1]->set_transform(Transform(Basis(), origins[1]));
+		map->sync();
+		check_connections_match_rebuild(map, regions);
+
+		// Still within the edge connection margin.
+		regions[3]->set_transform(Transform(Basis(), Vector3(32, 0, 0)));
+		map->sync();
+		check_connections_match_rebuild(map, regions);
+
+		remove_region(map, regions[2]);
+		regions.write[2] = nullptr;
+		map->sync();
+		check_connections_match_rebuild(map, regions);
+
+		regions.write[2] = add_region(map, navmesh, origins[2]);
+		map->sync();
+		check_connections_match_rebuild(map, regions);
+	}
+
+	SUBCASE("Several changes between syncs") {
+		regions.write[3] = add_region(map, navmesh, origins[3]);
+		regions[1]->set_transform(Transform(Basis(), Vector3(100, 0, 0)));
+		remove_region(map, regions[0]);
+		regions.write[0] = nullptr;
+		map->sync();
+		check_connections_match_rebuild(map, regions);
+
+		regions.write[0] = add_region(map, navmesh, origins[0]);
+		regions.write[4] = add_region(map, navmesh, origins[4]);
+		regions[1]->set_transform(Transform(Basis(), origins[1]));
+		map->sync();
+		check_connections_match_rebuild(map, regions);
+	}
+
+	for (int r = 0; r < regions.size(); r++) {
+		if (regions[r]) {
+			remove_region(map, regions[r]);
+		}
+	}
+	memdelete(map);
+}
+
+void avoidance_neighbors_test() {
+	NavMap *map = memnew(NavMap);
+	Vector<RvoAgent *> agents;
+	RandomPCG rng(1234);
+
+	// Agents around the origin, so the grid cells have negative coordinates
+	// too, with different neighbor distances and counts.
+	const int agent_count = 500;
+	for (int i = 0; i < agent_count; i++) {
+		RvoAgent *agent = memnew(RvoAgent);
+		agent->set_map(map);
+		map->add_agent(agent);
+		map->set_agent_as_controlled(agent);
+
+		RVO::Agent *rvo_agent = agent->get_agent();
+		rvo_agent->position_ = RVO::Vector3(rng.random(-30.0f, 30.0f), rng.random(-2.0f, 2.0f), rng.random(-30.0f, 30.0f));
+		rvo_agent->neighborDist_ = (i % 3 == 0) ? 8.0 : 3.0;
+		rvo_agent->maxNeighbors_ = (i % 5 == 0) ? agent_count : 10;
+		rvo_agent->timeHorizon_ = 1.0;
+		rvo_agent->radius_ = 0.5;
+		rvo_agent->maxSpeed_ = 2.0;
+
+		agents.push_back(agent);
+	}
+
+	map->sync();
+	map->step(1.0 / 60.0);
+
+	for (int i = 0; i < agents.size(); i++) {
+		const RVO::Agent *rvo_agent = agents[i]->get_agent();
+
+		// Same insertion as the grid search, over every other agent.
+		RVO::Agent expected;
+		expected.position_ = rvo_agent->position_;
+		expected.maxNeighbors_ = rvo_agent->maxNeighbors_;
+		float range_sq = rvo_agent->neighborDist_ * rvo_agent->neighborDist_;
+		for (int j = 0; j < agents.size(); j++) {
+			if (j != i) {
+				expected.insertAgentNeighbor(agents[j]->get_agent(), range_sq);
+			}
+		}
+
+		const std::vector<std::pair<float, const RVO::Agent *>> &neighbors = rvo_agent->agentNeighbors_;
+		CHECK_MESSAGE(neighbors.size() == expected.agentNeighbors_.size(), vformat("Agent %d has a wrong number of neighbors.", i));
+		for (size_t n = 0; n < MIN(neighbors.size(), expected.agentNeighbors_.size()); n++) {
+			CHECK_MESSAGE(neighbors[n].second == expected.agentNeighbors_[n].second, vformat("Agent %d has a wrong neighbor.", i));
+		}
+	}
+
+	for (int i = 0; i < agents.size(); i++) {
+		map->remove_agent(agents[i]);
+		memdelete(agents[i]);
+	}
+	memdelete(map);
+}
+
+#ifndef _3D_DISABLED
+/// Gives access to the bake from already parsed geometry, as the geometry
+/// nodes need the physics and rendering servers.
+class NavigationMeshGeneratorTester : public NavigationMeshGenerator {
+public:
+	static void bake_tiles(Ref<NavigationMesh> p_nav_mesh, Vector<float> &p_vertices, Vector<int> &p_indices) {
+		_bake_navigation_mesh_tiles(p_nav_mesh, p_vertices, p_indices);
+	}
+
+	static void rebake_tiles(Ref<NavigationMesh> p_nav_mesh, Vector<float> &p_vertices, Vector<int> &p_indices, const AABB &p_aabb) {
+		_rebake_navigation_mesh_tiles(p_nav_mesh, p_vertices, p_indices, p_aabb);
+	}
+};
+
+static const int FLOOR_SIZE = 20;
+
+/// A flat floor of 1x1 quads, optionally with a square hole.
+static void create_floor(Vector<float> &r_vertices, Vector<int> &r_indices, const Rect2i &p_hole = Rect2i()) {
+	r_vertices.clear();
+	r_indices.clear();
+
+	for (int z = 0; z <= FLOOR_SIZE; z++) {
+		for (int x = 0; x <= FLOOR_SIZE; x++) {
+			r_vertices.push_back(x);
+			r_vertices.push_back(0);
+			r_vertices.push_back(z);
+		}
+	}
+
+	for (int z = 0; z < FLOOR_SIZE; z++) {
+		for (int x = 0; x < FLOOR_SIZE; x++) {
+			if (p_hole.has_point(Point2i(x, z))) {
+				continue;
+			}
+
+			// Counter clockwise seen from above, so the triangles face up.
+			const int i = z * (FLOOR_SIZE + 1) + x;
+			r_indices.push_back(i);
+			r_indices.push_back(i + FLOOR_SIZE + 1);
+			r_indices.push_back(i + 1);
+
+			r_indices.push_back(i + 1);
+			r_indices.push_back(i + FLOOR_SIZE + 1);
+			r_indices.push_back(i + FLOOR_SIZE + 2);
+		}
+	}
+}
+
+static Ref<NavigationMesh> create_tiled_navmesh() {
+	Ref<NavigationMesh> navmesh;
+	navmesh.instance();
+	navmesh->set_tile_size(16);
+	return navmesh;
+}
+
+/// Describes the polygons by the positions of their vertices, sorted so the
+/// order of the polygons doesn't matter.
+static Vector<String> get_polygons(Ref<NavigationMesh> p_navmesh) {
+	const Vector<Vector3> vertices = p_navmesh->get_vertices();
+	Vector<String> polygons;
+	for (int i = 0; i < p_navmesh->get_polygon_count(); i++) {
+		const Vector<int> polygon = p_navmesh->get_polygon(i);
+		String description;
+		for (int j = 0; j < polygon.size(); j++) {
+			description += String(vertices[polygon[j]]) + " ";
+		}
+		polygons.push_back(description);
+	}
+	polygons.sort();
+	return polygons;
+}
+
+void tiled_bake_test() {
+	Vector<float> vertices;
+	Vector<int> indices;
+	create_floor(vertices, indices);
+
+	Ref<NavigationMesh> navmesh = create_tiled_navmesh();
+	NavigationMeshGeneratorTester::bake_tiles(navmesh, vertices, indices);
+	REQUIRE(navmesh->get_polygon_count() > 0);
+
+	const Vector<Vector3> nav_vertices = navmesh->get_vertices();
+	for (int i = 0; i < nav_vertices.size(); i++) {
+		CHECK(nav_vertices[i].x >= 0);
+		CHECK(nav_vertices[i].x <= FLOOR_SIZE);
+		CHECK(nav_vertices[i].z >= 0);
+		CHECK(nav_vertices[i].z <= FLOOR_SIZE);
+	}
+
+	// The tiles over the floor get polygons, and each polygon stays inside
+	// the tile that made it.
+	const real_t tile_width = navmesh->get_tile_size() * navmesh->get_cell_size();
+	const int tile_count = (int)Math::ceil(FLOOR_SIZE / tile_width);
+	Vector<int> tile_polygons;
+	tile_polygons.resize(tile_count * tile_count);
+	for (int i = 0; i < tile_polygons.size(); i++) {
+		tile_polygons.write[i] = 0;
+	}
+
+	for (int i = 0; i < navmesh->get_polygon_count(); i++) {
+		const Vector<int> polygon = navmesh->get_polygon(i);
+		REQUIRE(polygon.size() > 0);
+
+		AABB bounds(nav_vertices[polygon[0]], Vector3());
+		for (int j = 1; j < polygon.size(); j++) {
+			bounds.expand_to(nav_vertices[polygon[j]]);
+		}
+
+		const Vector3 center = bounds.position + bounds.size * 0.5;
+		const int x = (int)Math::floor(center.x / tile_width);
+		const int z = (int)Math::floor(center.z / tile_width);
+		REQUIRE(x >= 0);
+		REQUIRE(x < tile_count);
+		REQUIRE(z >= 0);
+		REQUIRE(z < tile_count);
+		tile_polygons.write[z * tile_count + x]++;
+
+		CHECK(bounds.position.x >= x * tile_width - CMP_EPSILON);
+		CHECK(bounds.position.z >= z * tile_width - CMP_EPSILON);
+		CHECK(bounds.position.x + bounds.size.x <= (x + 1) * tile_width + CMP_EPSILON);
+		CHECK(bounds.position.z + bounds.size.z <= (z + 1) * tile_width + CMP_EPSILON);
+	}
+
+	// The tiles on the far sides only cover a thin strip of the floor, which
+	// the agent radius can erode away.
+	const int full_tile_count = (int)Math::floor(FLOOR_SIZE / tile_width);
+	for (int z = 0; z < full_tile_count; z++) {
+		for (int x = 0; x < full_tile_count; x++) {
+			CHECK_MESSAGE(tile_polygons[z * tile_count + x] > 0, vformat("Tile (%d, %d) has no polygons.", x, z));
+		}
+	}
+}
+
+void tiled_rebake_test() {
+	Vector<float> vertices;
+	Vector<int> indices;
+	create_floor(vertices, indices);
+
+	Ref<NavigationMesh> navmesh = create_tiled_navmesh();
+	NavigationMeshGeneratorTester::bake_tiles(navmesh, vertices, indices);
+	const Vector<String> polygons = get_polygons(navmesh);
+	REQUIRE(polygons.size() > 0);
+
+	SUBCASE("Invalid AABB") {
+		ERR_PRINT_OFF;
+		NavigationMeshGenerator::get_singleton()->rebake_tiles(navmesh, nullptr, AABB(Vector3(1, 0, 1), Vector3()));
+		NavigationMeshGenerator::get_singleton()->rebake_tiles(navmesh, nullptr, AABB(Vector3(5, 0, 5), Vector3(-2, 1, -2)));
+		ERR_PRINT_ON;
+		CHECK_MESSAGE(get_polygons(navmesh) == polygons, "The navigation mesh should be left as is.");
+	}
+
+	SUBCASE("Unchanged geometry") {
+		NavigationMeshGeneratorTester::rebake_tiles(navmesh, vertices, indices, AABB(Vector3(3, -1, 3), Vector3(6, 2, 6)));
+		CHECK_MESSAGE(get_polygons(navmesh) == polygons, "Rebaking the same geometry should give the same polygons.");
+	}
+
+	SUBCASE("Changed geometry") {
+		// A hole in the floor, the rebaked area covers every tile that can
+		// see it through its border.
+		const Rect2i hole(8, 8, 4, 4);
+		create_floor(vertices, indices, hole);
+
+		Ref<NavigationMesh> expected_navmesh = create_tiled_navmesh();
+		NavigationMeshGeneratorTester::bake_tiles(expected_navmesh, vertices, indices);
+		const Vector<String> expected_polygons = get_polygons(expected_navmesh);
+		CHECK(expected_polygons != polygons);
+
+		const real_t tile_width = navmesh->get_tile_size() * navmesh->get_cell_size();
+		const AABB changed_area(Vector3(hole.position.x, -1, hole.position.y), Vector3(hole.size.x, 2, hole.size.y));
+		NavigationMeshGeneratorTester::rebake_tiles(navmesh, vertices, indices, changed_area.grow(tile_width));
+		CHECK_MESSAGE(get_polygons(navmesh) == expected_polygons, "Rebaking the changed tiles should match a full bake.");
+	}
+}
+#endif
+} // namespace TestNavigation
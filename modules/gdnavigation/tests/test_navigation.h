@@ -0,0 +1,70 @@
+/*************************************************************************/
+/*  test_navigation.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_NAVIGATION_H
+#define TEST_NAVIGATION_H
+
+#include "tests/test_macros.h"
+
+namespace TestNavigation {
+
+void path_query_test();
+
+TEST_CASE("[Navigation] Asynchronous path queries") {
+	path_query_test();
+}
+
+void incremental_connections_test();
+
+TEST_CASE("[Navigation] Incremental edge connections match a full rebuild") {
+	incremental_connections_test();
+}
+
+void avoidance_neighbors_test();
+
+TEST_CASE("[Navigation] Avoidance neighbors match a brute force search") {
+	avoidance_neighbors_test();
+}
+
+#ifndef _3D_DISABLED
+void tiled_bake_test();
+void tiled_rebake_test();
+
+TEST_CASE("[Navigation] Bake a navigation mesh in tiles") {
+	tiled_bake_test();
+}
+
+TEST_CASE("[Navigation] Rebake the tiles of a navigation mesh") {
+	tiled_rebake_test();
+}
+#endif
+} // namespace TestNavigation
+
+#endif // TEST_NAVIGATION_H
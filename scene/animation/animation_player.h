@@ -170,6 +170,7 @@ private:
 		String name;
 		StringName next;
 		Vector<TrackNodeCache *> node_cache;
+		Vector<int> track_cursors; // Last key sampled in each track, to continue from there.
 		Ref<Animation> animation;
 	};
 
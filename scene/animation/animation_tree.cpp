@@ -443,11 +443,20 @@ void AnimationNode::_bind_methods() {
 AnimationNode::AnimationNode() {
 	state = nullptr;
 	parent = nullptr;
+	batch_owner = nullptr;
+	batch_pass = 0;
 	filter_enabled = false;
 }
 
 ////////////////////
 
+SelfList<AnimationTree>::List AnimationTree::parallel_trees;
+AnimationTree::ParallelBatch AnimationTree::parallel_batch;
+uint64_t AnimationTree::parallel_batch_frame[2] = { UINT64_MAX, UINT64_MAX };
+uint64_t AnimationTree::parallel_batch_pass = 0;
+ThreadWorkPool AnimationTree::thread_work_pool;
+bool AnimationTree::thread_work_pool_started = false;
+
 void AnimationTree::set_tree_root(const Ref<AnimationNode> &p_root) {
 	if (root.is_valid()) {
 		root->disconnect("tree_changed", callable_mp(this, &AnimationTree::_tree_changed));
@@ -518,6 +527,28 @@ AnimationTree::AnimationProcessMode AnimationTree::get_process_mode() const {
 	return process_mode;
 }
 
+void AnimationTree::set_parallel_evaluation(bool p_enable) {
+	if (parallel_evaluation == p_enable) {
+		return;
+	}
+
+	parallel_evaluation = p_enable;
+
+	if (!is_inside_tree()) {
+		return;
+	}
+
+	if (parallel_evaluation) {
+		parallel_trees.add(&parallel_list);
+	} else {
+		parallel_list.remove_from_list();
+	}
+}
+
+bool AnimationTree::is_parallel_evaluation_enabled() const {
+	return parallel_evaluation;
+}
+
 void AnimationTree::_node_removed(Node *p_node) {
 	cache_valid = false;
 }
@@ -711,12 +742,13 @@ void AnimationTree::_clear_caches() {
 		memdelete(track_cache[*K]);
 	}
 	playing_caches.clear();
+	track_events.clear();
 
 	track_cache.clear();
 	cache_valid = false;
 }
 
-void AnimationTree::_process_graph(float p_delta) {
+bool AnimationTree::_prepare_graph() {
 	_update_properties(); //if properties need updating, update them
 
 	//check all tracks, see if they need modification
@@ -727,14 +759,14 @@ void AnimationTree::_process_graph(float p_delta) {
 		ERR_PRINT("AnimationTree: root AnimationNode is not set, disabling playback.");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	if (!has_node(animation_player)) {
 		ERR_PRINT("AnimationTree: no valid AnimationPlayer path set, disabling playback");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(get_node(animation_player));
@@ -764,15 +796,21 @@ void AnimationTree::_process_graph(float p_delta) {
 		ERR_PRINT("AnimationTree: path points to a node not an AnimationPlayer, disabling playback");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	if (!cache_valid) {
 		if (!_update_caches(player)) {
-			return;
+			return false;
 		}
 	}
 
+	state.player = player;
+
+	return true;
+}
+
+void AnimationTree::_evaluate_graph(float p_delta) {
 	{ //setup
 
 		process_pass++;
@@ -781,7 +819,6 @@ void AnimationTree::_process_graph(float p_delta) {
 		state.invalid_reasons = "";
 		state.animation_states.clear(); //will need to be re-created
 		state.valid = true;
-		state.player = player;
 		state.last_pass = process_pass;
 		state.tree = this;
 
@@ -805,94 +842,98 @@ void AnimationTree::_process_graph(float p_delta) {
 
 		root->_pre_process(SceneStringNames::get_singleton()->parameters_base_path, nullptr, &state, p_delta, false, Vector<StringName>());
 	}
+}
 
-	if (!state.valid) {
-		return; //state is not valid. do nothing.
-	}
+void AnimationTree::_process_tracks(bool p_defer_events) {
 	//apply value/transform/bezier blends to track caches and execute method/audio/animation tracks
 
-	{
-		bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
-
-		for (List<AnimationNode::AnimationState>::Element *E = state.animation_states.front(); E; E = E->next()) {
-			const AnimationNode::AnimationState &as = E->get();
+	track_events.clear();
 
-			Ref<Animation> a = as.animation;
-			float time = as.time;
-			float delta = as.delta;
-			bool seeked = as.seeked;
+	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
 
-			for (int i = 0; i < a->get_track_count(); i++) {
-				NodePath path = a->track_get_path(i);
+	for (List<AnimationNode::AnimationState>::Element *E = state.animation_states.front(); E; E = E->next()) {
+		const AnimationNode::AnimationState &as = E->get();
 
-				ERR_CONTINUE(!track_cache.has(path));
+		Ref<Animation> a = as.animation;
+		float time = as.time;
+		float delta = as.delta;
 
-				TrackCache *track = track_cache[path];
-				if (track->type != a->track_get_type(i)) {
-					continue; //may happen should not
-				}
+		for (int i = 0; i < a->get_track_count(); i++) {
+			NodePath path = a->track_get_path(i);
 
-				track->root_motion = root_motion_track == path;
+			ERR_CONTINUE(!track_cache.has(path));
 
-				ERR_CONTINUE(!state.track_map.has(path));
-				int blend_idx = state.track_map[path];
+			TrackCache *track = track_cache[path];
+			if (track->type != a->track_get_type(i)) {
+				continue; //may happen should not
+			}
 
-				ERR_CONTINUE(blend_idx < 0 || blend_idx >= state.track_count);
+			track->root_motion = root_motion_track == path;
 
-				float blend = (*as.track_blends)[blend_idx];
+			ERR_CONTINUE(!state.track_map.has(path));
+			int blend_idx = state.track_map[path];
 
-				if (blend < CMP_EPSILON) {
-					continue; //nothing to blend
-				}
+			ERR_CONTINUE(blend_idx < 0 || blend_idx >= state.track_count);
 
-				switch (track->type) {
-					case Animation::TYPE_TRANSFORM: {
-						TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
-
-						if (track->root_motion) {
-							if (t->process_pass != process_pass) {
-								t->process_pass = process_pass;
-								t->loc = Vector3();
-								t->rot = Quat();
-								t->rot_blend_accum = 0;
-								t->scale = Vector3(1, 1, 1);
-							}
+			float blend = (*as.track_blends)[blend_idx];
 
-							float prev_time = time - delta;
-							if (prev_time < 0) {
-								if (!a->has_loop()) {
-									prev_time = 0;
-								} else {
-									prev_time = a->get_length() + prev_time;
-								}
-							}
+			if (blend < CMP_EPSILON) {
+				continue; //nothing to blend
+			}
 
-							Vector3 loc[2];
-							Quat rot[2];
-							Vector3 scale[2];
+			bool event = track->type == Animation::TYPE_METHOD || track->type == Animation::TYPE_AUDIO || track->type == Animation::TYPE_ANIMATION;
+			if (track->type == Animation::TYPE_VALUE) {
+				Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
+				event = update_mode != Animation::UPDATE_CONTINUOUS && update_mode != Animation::UPDATE_CAPTURE;
+			}
 
-							if (prev_time > time) {
-								Error err = a->transform_track_interpolate(i, prev_time, &loc[0], &rot[0], &scale[0]);
-								if (err != OK) {
-									continue;
-								}
+			if (event) {
+				if (p_defer_events) {
+					TrackEvent track_event;
+					track_event.anim_state = &as;
+					track_event.track = i;
+					track_event.cache = track;
+					track_event.blend = blend;
+					track_events.push_back(track_event);
+				} else {
+					_process_track_event(as, i, track, blend, can_call);
+				}
+				continue;
+			}
 
-								a->transform_track_interpolate(i, a->get_length(), &loc[1], &rot[1], &scale[1]);
+			switch (track->type) {
+				case Animation::TYPE_TRANSFORM: {
+					TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
 
-								t->loc += (loc[1] - loc[0]) * blend;
-								t->scale += (scale[1] - scale[0]) * blend;
-								Quat q = Quat().slerp(rot[0].normalized().inverse() * rot[1].normalized(), blend).normalized();
-								t->rot = (t->rot * q).normalized();
+					if (track->root_motion) {
+						if (t->process_pass != process_pass) {
+							t->process_pass = process_pass;
+							t->loc = Vector3();
+							t->rot = Quat();
+							t->rot_blend_accum = 0;
+							t->scale = Vector3(1, 1, 1);
+						}
 
+						float prev_time = time - delta;
+						if (prev_time < 0) {
+							if (!a->has_loop()) {
 								prev_time = 0;
+							} else {
+								prev_time = a->get_length() + prev_time;
 							}
+						}
 
+						Vector3 loc[2];
+						Quat rot[2];
+						Vector3 scale[2];
+
+						if (prev_time > time) {
 							Error err = a->transform_track_interpolate(i, prev_time, &loc[0], &rot[0], &scale[0]);
 							if (err != OK) {
 								continue;
 							}
 
-							a->transform_track_interpolate(i, time, &loc[1], &rot[1], &scale[1]);
+							a->transform_track_interpolate(i, a->get_length(), &loc[1], &rot[1], &scale[1]);
 
 							t->loc += (loc[1] - loc[0]) * blend;
 							t->scale += (scale[1] - scale[0]) * blend;
@@ -900,334 +941,522 @@ void AnimationTree::_process_graph(float p_delta) {
 							t->rot = (t->rot * q).normalized();
 
 							prev_time = 0;
+						}
 
-						} else {
-							Vector3 loc;
-							Quat rot;
-							Vector3 scale;
-
-							Error err = a->transform_track_interpolate(i, time, &loc, &rot, &scale);
-							//ERR_CONTINUE(err!=OK); //used for testing, should be removed
-
-							if (t->process_pass != process_pass) {
-								t->process_pass = process_pass;
-								t->loc = loc;
-								t->rot = rot;
-								t->rot_blend_accum = 0;
-								t->scale = scale;
-							}
+						Error err = a->transform_track_interpolate(i, prev_time, &loc[0], &rot[0], &scale[0]);
+						if (err != OK) {
+							continue;
+						}
 
-							if (err != OK) {
-								continue;
-							}
+						a->transform_track_interpolate(i, time, &loc[1], &rot[1], &scale[1]);
 
-							t->loc = t->loc.lerp(loc, blend);
-							if (t->rot_blend_accum == 0) {
-								t->rot = rot;
-								t->rot_blend_accum = blend;
-							} else {
-								float rot_total = t->rot_blend_accum + blend;
-								t->rot = rot.slerp(t->rot, t->rot_blend_accum / rot_total).normalized();
-								t->rot_blend_accum = rot_total;
-							}
-							t->scale = t->scale.lerp(scale, blend);
+						t->loc += (loc[1] - loc[0]) * blend;
+						t->scale += (scale[1] - scale[0]) * blend;
+						Quat q = Quat().slerp(rot[0].normalized().inverse() * rot[1].normalized(), blend).normalized();
+						t->rot = (t->rot * q).normalized();
+
+						prev_time = 0;
+
+					} else {
+						Vector3 loc;
+						Quat rot;
+						Vector3 scale;
+
+						Error err = a->transform_track_interpolate(i, time, &loc, &rot, &scale);
+						//ERR_CONTINUE(err!=OK); //used for testing, should be removed
+
+						if (t->process_pass != process_pass) {
+							t->process_pass = process_pass;
+							t->loc = loc;
+							t->rot = rot;
+							t->rot_blend_accum = 0;
+							t->scale = scale;
 						}
 
-					} break;
-					case Animation::TYPE_VALUE: {
-						TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
+						if (err != OK) {
+							continue;
+						}
 
-						Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
+						t->loc = t->loc.lerp(loc, blend);
+						if (t->rot_blend_accum == 0) {
+							t->rot = rot;
+							t->rot_blend_accum = blend;
+						} else {
+							float rot_total = t->rot_blend_accum + blend;
+							t->rot = rot.slerp(t->rot, t->rot_blend_accum / rot_total).normalized();
+							t->rot_blend_accum = rot_total;
+						}
+						t->scale = t->scale.lerp(scale, blend);
+					}
 
-						if (update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE) { //delta == 0 means seek
+				} break;
+				case Animation::TYPE_VALUE: {
+					TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
 
-							Variant value = a->value_track_interpolate(i, time);
+					Variant value = a->value_track_interpolate(i, time);
 
-							if (value == Variant()) {
-								continue;
-							}
+					if (value == Variant()) {
+						continue;
+					}
 
-							if (t->process_pass != process_pass) {
-								t->value = value;
-								t->process_pass = process_pass;
-							}
+					if (t->process_pass != process_pass) {
+						t->value = value;
+						t->process_pass = process_pass;
+					}
 
-							Variant::interpolate(t->value, value, blend, t->value);
+					Variant::interpolate(t->value, value, blend, t->value);
 
-						} else if (delta != 0) {
-							List<int> indices;
-							a->value_track_get_key_indices(i, time, delta, &indices);
+				} break;
+				case Animation::TYPE_BEZIER: {
+					TrackCacheBezier *t = static_cast<TrackCacheBezier *>(track);
 
-							for (List<int>::Element *F = indices.front(); F; F = F->next()) {
-								Variant value = a->track_get_key_value(i, F->get());
-								t->object->set_indexed(t->subpath, value);
-							}
-						}
+					float bezier = a->bezier_track_interpolate(i, time);
 
-					} break;
-					case Animation::TYPE_METHOD: {
-						if (delta == 0) {
-							continue;
-						}
-						TrackCacheMethod *t = static_cast<TrackCacheMethod *>(track);
+					if (t->process_pass != process_pass) {
+						t->value = bezier;
+						t->process_pass = process_pass;
+					}
 
-						List<int> indices;
+					t->value = Math::lerp(t->value, bezier, blend);
 
-						a->method_track_get_key_indices(i, time, delta, &indices);
+				} break;
+				default: {
+				}
+			}
+		}
+	}
+}
 
-						for (List<int>::Element *F = indices.front(); F; F = F->next()) {
-							StringName method = a->method_track_get_name(i, F->get());
-							Vector<Variant> params = a->method_track_get_params(i, F->get());
+void AnimationTree::_process_track_event(const AnimationNode::AnimationState &p_anim_state, int p_track, TrackCache *p_cache, float p_blend, bool p_can_call) {
+	Ref<Animation> a = p_anim_state.animation;
+	float time = p_anim_state.time;
+	float delta = p_anim_state.delta;
+	bool seeked = p_anim_state.seeked;
 
-							int s = params.size();
+	switch (p_cache->type) {
+		case Animation::TYPE_VALUE: {
+			if (delta == 0) {
+				return;
+			}
+			TrackCacheValue *t = static_cast<TrackCacheValue *>(p_cache);
 
-							ERR_CONTINUE(s > VARIANT_ARG_MAX);
-							if (can_call) {
-								t->object->call_deferred(
-										method,
-										s >= 1 ? params[0] : Variant(),
-										s >= 2 ? params[1] : Variant(),
-										s >= 3 ? params[2] : Variant(),
-										s >= 4 ? params[3] : Variant(),
-										s >= 5 ? params[4] : Variant());
-							}
-						}
+			List<int> indices;
+			a->value_track_get_key_indices(p_track, time, delta, &indices);
 
-					} break;
-					case Animation::TYPE_BEZIER: {
-						TrackCacheBezier *t = static_cast<TrackCacheBezier *>(track);
+			for (List<int>::Element *F = indices.front(); F; F = F->next()) {
+				Variant value = a->track_get_key_value(p_track, F->get());
+				t->object->set_indexed(t->subpath, value);
+			}
 
-						float bezier = a->bezier_track_interpolate(i, time);
+		} break;
+		case Animation::TYPE_METHOD: {
+			if (delta == 0) {
+				return;
+			}
+			TrackCacheMethod *t = static_cast<TrackCacheMethod *>(p_cache);
 
-						if (t->process_pass != process_pass) {
-							t->value = bezier;
-							t->process_pass = process_pass;
-						}
+			List<int> indices;
 
-						t->value = Math::lerp(t->value, bezier, blend);
+			a->method_track_get_key_indices(p_track, time, delta, &indices);
 
-					} break;
-					case Animation::TYPE_AUDIO: {
-						TrackCacheAudio *t = static_cast<TrackCacheAudio *>(track);
+			for (List<int>::Element *F = indices.front(); F; F = F->next()) {
+				StringName method = a->method_track_get_name(p_track, F->get());
+				Vector<Variant> params = a->method_track_get_params(p_track, F->get());
 
-						if (seeked) {
-							//find whathever should be playing
-							int idx = a->track_find_key(i, time);
-							if (idx < 0) {
-								continue;
-							}
+				int s = params.size();
 
-							Ref<AudioStream> stream = a->audio_track_get_key_stream(i, idx);
-							if (!stream.is_valid()) {
-								t->object->call("stop");
-								t->playing = false;
-								playing_caches.erase(t);
-							} else {
-								float start_ofs = a->audio_track_get_key_start_offset(i, idx);
-								start_ofs += time - a->track_get_key_time(i, idx);
-								float end_ofs = a->audio_track_get_key_end_offset(i, idx);
-								float len = stream->get_length();
-
-								if (start_ofs > len - end_ofs) {
-									t->object->call("stop");
-									t->playing = false;
-									playing_caches.erase(t);
-									continue;
-								}
-
-								t->object->call("set_stream", stream);
-								t->object->call("play", start_ofs);
-
-								t->playing = true;
-								playing_caches.insert(t);
-								if (len && end_ofs > 0) { //force a end at a time
-									t->len = len - start_ofs - end_ofs;
-								} else {
-									t->len = 0;
-								}
-
-								t->start = time;
-							}
+				ERR_CONTINUE(s > VARIANT_ARG_MAX);
+				if (p_can_call) {
+					t->object->call_deferred(
+							method,
+							s >= 1 ? params[0] : Variant(),
+							s >= 2 ? params[1] : Variant(),
+							s >= 3 ? params[2] : Variant(),
+							s >= 4 ? params[3] : Variant(),
+							s >= 5 ? params[4] : Variant());
+				}
+			}
 
-						} else {
-							//find stuff to play
-							List<int> to_play;
-							a->track_get_key_indices_in_range(i, time, delta, &to_play);
-							if (to_play.size()) {
-								int idx = to_play.back()->get();
-
-								Ref<AudioStream> stream = a->audio_track_get_key_stream(i, idx);
-								if (!stream.is_valid()) {
-									t->object->call("stop");
-									t->playing = false;
-									playing_caches.erase(t);
-								} else {
-									float start_ofs = a->audio_track_get_key_start_offset(i, idx);
-									float end_ofs = a->audio_track_get_key_end_offset(i, idx);
-									float len = stream->get_length();
-
-									t->object->call("set_stream", stream);
-									t->object->call("play", start_ofs);
-
-									t->playing = true;
-									playing_caches.insert(t);
-									if (len && end_ofs > 0) { //force a end at a time
-										t->len = len - start_ofs - end_ofs;
-									} else {
-										t->len = 0;
-									}
-
-									t->start = time;
-								}
-							} else if (t->playing) {
-								bool loop = a->has_loop();
-
-								bool stop = false;
-
-								if (!loop && time < t->start) {
-									stop = true;
-								} else if (t->len > 0) {
-									float len = t->start > time ? (a->get_length() - t->start) + time : time - t->start;
-
-									if (len > t->len) {
-										stop = true;
-									}
-								}
-
-								if (stop) {
-									//time to stop
-									t->object->call("stop");
-									t->playing = false;
-									playing_caches.erase(t);
-								}
-							}
-						}
+		} break;
+		case Animation::TYPE_AUDIO: {
+			TrackCacheAudio *t = static_cast<TrackCacheAudio *>(p_cache);
 
-						float db = Math::linear2db(MAX(blend, 0.00001));
-						if (t->object->has_method("set_unit_db")) {
-							t->object->call("set_unit_db", db);
+			if (seeked) {
+				//find whathever should be playing
+				int idx = a->track_find_key(p_track, time);
+				if (idx < 0) {
+					return;
+				}
+
+				Ref<AudioStream> stream = a->audio_track_get_key_stream(p_track, idx);
+				if (!stream.is_valid()) {
+					t->object->call("stop");
+					t->playing = false;
+					playing_caches.erase(t);
+				} else {
+					float start_ofs = a->audio_track_get_key_start_offset(p_track, idx);
+					start_ofs += time - a->track_get_key_time(p_track, idx);
+					float end_ofs = a->audio_track_get_key_end_offset(p_track, idx);
+					float len = stream->get_length();
+
+					if (start_ofs > len - end_ofs) {
+						t->object->call("stop");
+						t->playing = false;
+						playing_caches.erase(t);
+						return;
+					}
+
+					t->object->call("set_stream", stream);
+					t->object->call("play", start_ofs);
+
+					t->playing = true;
+					playing_caches.insert(t);
+					if (len && end_ofs > 0) { //force a end at a time
+						t->len = len - start_ofs - end_ofs;
+					} else {
+						t->len = 0;
+					}
+
+					t->start = time;
+				}
+
+			} else {
+				//find stuff to play
+				List<int> to_play;
+				a->track_get_key_indices_in_range(p_track, time, delta, &to_play);
+				if (to_play.size()) {
+					int idx = to_play.back()->get();
+
+					Ref<AudioStream> stream = a->audio_track_get_key_stream(p_track, idx);
+					if (!stream.is_valid()) {
+						t->object->call("stop");
+						t->playing = false;
+						playing_caches.erase(t);
+					} else {
+						float start_ofs = a->audio_track_get_key_start_offset(p_track, idx);
+						float end_ofs = a->audio_track_get_key_end_offset(p_track, idx);
+						float len = stream->get_length();
+
+						t->object->call("set_stream", stream);
+						t->object->call("play", start_ofs);
+
+						t->playing = true;
+						playing_caches.insert(t);
+						if (len && end_ofs > 0) { //force a end at a time
+							t->len = len - start_ofs - end_ofs;
 						} else {
-							t->object->call("set_volume_db", db);
+							t->len = 0;
 						}
-					} break;
-					case Animation::TYPE_ANIMATION: {
-						TrackCacheAnimation *t = static_cast<TrackCacheAnimation *>(track);
 
-						AnimationPlayer *player2 = Object::cast_to<AnimationPlayer>(t->object);
+						t->start = time;
+					}
+				} else if (t->playing) {
+					bool loop = a->has_loop();
 
-						if (!player2) {
-							continue;
+					bool stop = false;
+
+					if (!loop && time < t->start) {
+						stop = true;
+					} else if (t->len > 0) {
+						float len = t->start > time ? (a->get_length() - t->start) + time : time - t->start;
+
+						if (len > t->len) {
+							stop = true;
 						}
+					}
 
-						if (delta == 0 || seeked) {
-							//seek
-							int idx = a->track_find_key(i, time);
-							if (idx < 0) {
-								continue;
-							}
+					if (stop) {
+						//time to stop
+						t->object->call("stop");
+						t->playing = false;
+						playing_caches.erase(t);
+					}
+				}
+			}
 
-							float pos = a->track_get_key_time(i, idx);
+			float db = Math::linear2db(MAX(p_blend, 0.00001));
+			if (t->object->has_method("set_unit_db")) {
+				t->object->call("set_unit_db", db);
+			} else {
+				t->object->call("set_volume_db", db);
+			}
+		} break;
+		case Animation::TYPE_ANIMATION: {
+			TrackCacheAnimation *t = static_cast<TrackCacheAnimation *>(p_cache);
 
-							StringName anim_name = a->animation_track_get_key_animation(i, idx);
-							if (String(anim_name) == "[stop]" || !player2->has_animation(anim_name)) {
-								continue;
-							}
+			AnimationPlayer *player2 = Object::cast_to<AnimationPlayer>(t->object);
 
-							Ref<Animation> anim = player2->get_animation(anim_name);
+			if (!player2) {
+				return;
+			}
 
-							float at_anim_pos;
+			if (delta == 0 || seeked) {
+				//seek
+				int idx = a->track_find_key(p_track, time);
+				if (idx < 0) {
+					return;
+				}
 
-							if (anim->has_loop()) {
-								at_anim_pos = Math::fposmod(time - pos, anim->get_length()); //seek to loop
-							} else {
-								at_anim_pos = MAX(anim->get_length(), time - pos); //seek to end
-							}
+				float pos = a->track_get_key_time(p_track, idx);
 
-							if (player2->is_playing() || seeked) {
-								player2->play(anim_name);
-								player2->seek(at_anim_pos);
-								t->playing = true;
-								playing_caches.insert(t);
-							} else {
-								player2->set_assigned_animation(anim_name);
-								player2->seek(at_anim_pos, true);
-							}
-						} else {
-							//find stuff to play
-							List<int> to_play;
-							a->track_get_key_indices_in_range(i, time, delta, &to_play);
-							if (to_play.size()) {
-								int idx = to_play.back()->get();
-
-								StringName anim_name = a->animation_track_get_key_animation(i, idx);
-								if (String(anim_name) == "[stop]" || !player2->has_animation(anim_name)) {
-									if (playing_caches.has(t)) {
-										playing_caches.erase(t);
-										player2->stop();
-										t->playing = false;
-									}
-								} else {
-									player2->play(anim_name);
-									t->playing = true;
-									playing_caches.insert(t);
-								}
-							}
-						}
+				StringName anim_name = a->animation_track_get_key_animation(p_track, idx);
+				if (String(anim_name) == "[stop]" || !player2->has_animation(anim_name)) {
+					return;
+				}
 
-					} break;
+				Ref<Animation> anim = player2->get_animation(anim_name);
+
+				float at_anim_pos;
+
+				if (anim->has_loop()) {
+					at_anim_pos = Math::fposmod(time - pos, anim->get_length()); //seek to loop
+				} else {
+					at_anim_pos = MAX(anim->get_length(), time - pos); //seek to end
+				}
+
+				if (player2->is_playing() || seeked) {
+					player2->play(anim_name);
+					player2->seek(at_anim_pos);
+					t->playing = true;
+					playing_caches.insert(t);
+				} else {
+					player2->set_assigned_animation(anim_name);
+					player2->seek(at_anim_pos, true);
+				}
+			} else {
+				//find stuff to play
+				List<int> to_play;
+				a->track_get_key_indices_in_range(p_track, time, delta, &to_play);
+				if (to_play.size()) {
+					int idx = to_play.back()->get();
+
+					StringName anim_name = a->animation_track_get_key_animation(p_track, idx);
+					if (String(anim_name) == "[stop]" || !player2->has_animation(anim_name)) {
+						if (playing_caches.has(t)) {
+							playing_caches.erase(t);
+							player2->stop();
+							t->playing = false;
+						}
+					} else {
+						player2->play(anim_name);
+						t->playing = true;
+						playing_caches.insert(t);
+					}
 				}
 			}
+
+		} break;
+		default: {
 		}
 	}
+}
 
-	{
-		// finally, set the tracks
+void AnimationTree::_apply_tracks() {
+	const NodePath *K = nullptr;
+	while ((K = track_cache.next(K))) {
+		TrackCache *track = track_cache[*K];
+		if (track->process_pass != process_pass) {
+			continue; //not processed, ignore
+		}
+
+		switch (track->type) {
+			case Animation::TYPE_TRANSFORM: {
+				TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
+
+				Transform xform;
+				xform.origin = t->loc;
+
+				xform.basis.set_quat_scale(t->rot, t->scale);
+
+				if (t->root_motion) {
+					root_motion_transform = xform;
+
+					if (t->skeleton && t->bone_idx >= 0) {
+						root_motion_transform = (t->skeleton->get_bone_rest(t->bone_idx) * root_motion_transform) * t->skeleton->get_bone_rest(t->bone_idx).affine_inverse();
+					}
+				} else if (t->skeleton && t->bone_idx >= 0) {
+					t->skeleton->set_bone_pose(t->bone_idx, xform);
+
+				} else {
+					t->spatial->set_transform(xform);
+				}
+
+			} break;
+			case Animation::TYPE_VALUE: {
+				TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
+
+				t->object->set_indexed(t->subpath, t->value);
+
+			} break;
+			case Animation::TYPE_BEZIER: {
+				TrackCacheBezier *t = static_cast<TrackCacheBezier *>(track);
+
+				t->object->set_indexed(t->subpath, t->value);
+
+			} break;
+			default: {
+			} //the rest don't matter
+		}
+	}
+}
+
+void AnimationTree::_process_graph(float p_delta) {
+	parallel_evaluated = false;
+
+	if (!_prepare_graph()) {
+		return;
+	}
+
+	_evaluate_graph(p_delta);
+
+	if (!state.valid) {
+		return; //state is not valid. do nothing.
+	}
+
+	_process_tracks(false);
+	_apply_tracks();
+}
+
+void AnimationTree::_apply_graph(float p_delta) {
+	if (!state.valid) {
+		return; //state is not valid. do nothing.
+	}
+
+	if (!cache_valid) {
+		// Caches were cleared after the batch, so the blended values and recorded
+		// events are gone. The graph was already evaluated for this frame, so only
+		// blend the animation states it produced again, into new caches.
+		HashMap<NodePath, int> track_map = state.track_map;
+		if (!_update_caches(state.player)) {
+			return;
+		}
+
+		bool same_tracks = track_map.size() == state.track_map.size();
 		const NodePath *K = nullptr;
-		while ((K = track_cache.next(K))) {
-			TrackCache *track = track_cache[*K];
-			if (track->process_pass != process_pass) {
-				continue; //not processed, ignore
-			}
+		while (same_tracks && (K = track_map.next(K))) {
+			same_tracks = state.track_map.has(*K) && state.track_map[*K] == track_map[*K];
+		}
+		if (!same_tracks) {
+			return; //the blends were computed for other tracks, they'll be right next frame
+		}
 
-			switch (track->type) {
-				case Animation::TYPE_TRANSFORM: {
-					TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
+		_process_tracks(false);
+		_apply_tracks();
+		return;
+	}
 
-					Transform xform;
-					xform.origin = t->loc;
+	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
 
-					xform.basis.set_quat_scale(t->rot, t->scale);
+	for (uint32_t i = 0; i < track_events.size(); i++) {
+		const TrackEvent &track_event = track_events[i];
+		_process_track_event(*track_event.anim_state, track_event.track, track_event.cache, track_event.blend, can_call);
+	}
+	track_events.clear();
 
-					if (t->root_motion) {
-						root_motion_transform = xform;
+	_apply_tracks();
+}
 
-						if (t->skeleton && t->bone_idx >= 0) {
-							root_motion_transform = (t->skeleton->get_bone_rest(t->bone_idx) * root_motion_transform) * t->skeleton->get_bone_rest(t->bone_idx).affine_inverse();
-						}
-					} else if (t->skeleton && t->bone_idx >= 0) {
-						t->skeleton->set_bone_pose(t->bone_idx, xform);
+bool AnimationTree::_claim_graph_nodes() {
+	// Nodes keep their evaluation state, so a tree sharing a node with another
+	// tree of the batch, or using a scripted node, is evaluated on its own.
+	for (uint32_t i = 0; i < graph_nodes.size(); i++) {
+		AnimationNode *node = graph_nodes[i];
+		if (node->get_script_instance()) {
+			return false;
+		}
+		if (node->batch_pass == parallel_batch_pass && node->batch_owner != this) {
+			return false;
+		}
+	}
 
-					} else {
-						t->spatial->set_transform(xform);
-					}
+	for (uint32_t i = 0; i < graph_nodes.size(); i++) {
+		graph_nodes[i]->batch_pass = parallel_batch_pass;
+		graph_nodes[i]->batch_owner = this;
+	}
 
-				} break;
-				case Animation::TYPE_VALUE: {
-					TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
+	return true;
+}
 
-					t->object->set_indexed(t->subpath, t->value);
+void AnimationTree::ParallelBatch::evaluate(uint32_t p_index, void *p_userdata) {
+	const Item &item = items[p_index];
+	AnimationTree *tree = item.tree;
 
-				} break;
-				case Animation::TYPE_BEZIER: {
-					TrackCacheBezier *t = static_cast<TrackCacheBezier *>(track);
+	tree->_evaluate_graph(item.delta);
 
-					t->object->set_indexed(t->subpath, t->value);
+	if (tree->state.valid) {
+		tree->_process_tracks(true);
+	}
+}
 
-				} break;
-				default: {
-				} //the rest don't matter
-			}
+bool AnimationTree::_add_to_parallel_batch(float p_delta) {
+	if (!_prepare_graph() || !_claim_graph_nodes()) {
+		return false;
+	}
+
+	ParallelBatch::Item item;
+	item.tree = this;
+	item.delta = p_delta;
+	parallel_batch.items.push_back(item);
+
+	return true;
+}
+
+void AnimationTree::_evaluate_parallel_batch() {
+	if (parallel_batch.items.size() == 0) {
+		return;
+	}
+
+	if (!thread_work_pool_started) {
+		thread_work_pool.init();
+		thread_work_pool_started = true;
+	}
+
+	thread_work_pool.do_work(parallel_batch.items.size(), &parallel_batch, &ParallelBatch::evaluate, nullptr);
+	parallel_batch.items.clear();
+}
+
+void AnimationTree::_process_parallel_batch(AnimationProcessMode p_mode) {
+	uint64_t frame = p_mode == ANIMATION_PROCESS_PHYSICS ? Engine::get_singleton()->get_physics_frames() : Engine::get_singleton()->get_idle_frames();
+	if (parallel_batch_frame[p_mode] == frame) {
+		return; //already done by the first tree processed in this frame
+	}
+
+	parallel_batch_frame[p_mode] = frame;
+	parallel_batch_pass++;
+
+	for (SelfList<AnimationTree> *E = parallel_trees.first(); E; E = E->next()) {
+		AnimationTree *tree = E->self();
+		tree->parallel_evaluated = false;
+
+		if (!tree->active || tree->process_mode != p_mode || !tree->can_process()) {
+			continue;
 		}
+
+		float delta = p_mode == ANIMATION_PROCESS_PHYSICS ? tree->get_physics_process_delta_time() : tree->get_process_delta_time();
+		tree->parallel_evaluated = tree->_add_to_parallel_batch(delta);
+	}
+
+	_evaluate_parallel_batch();
+}
+
+void AnimationTree::_process_frame(float p_delta) {
+	if (parallel_evaluation) {
+		_process_parallel_batch(process_mode);
+
+		if (parallel_evaluated) {
+			parallel_evaluated = false;
+			_apply_graph(p_delta);
+			return;
+		}
+	}
+
+	_process_graph(p_delta);
+}
+
+void AnimationTree::finish_thread_pool() {
+	if (thread_work_pool_started) {
+		thread_work_pool.finish();
+		thread_work_pool_started = false;
 	}
 }
 
@@ -1237,14 +1466,15 @@ void AnimationTree::advance(float p_time) {
 
 void AnimationTree::_notification(int p_what) {
 	if (active && p_what == NOTIFICATION_INTERNAL_PHYSICS_PROCESS && process_mode == ANIMATION_PROCESS_PHYSICS) {
-		_process_graph(get_physics_process_delta_time());
+		_process_frame(get_physics_process_delta_time());
 	}
 
 	if (active && p_what == NOTIFICATION_INTERNAL_PROCESS && process_mode == ANIMATION_PROCESS_IDLE) {
-		_process_graph(get_process_delta_time());
+		_process_frame(get_process_delta_time());
 	}
 
 	if (p_what == NOTIFICATION_EXIT_TREE) {
+		parallel_list.remove_from_list();
 		_clear_caches();
 		if (last_animation_player.is_valid()) {
 			Object *player = ObjectDB::get_instance(last_animation_player);
@@ -1253,6 +1483,9 @@ void AnimationTree::_notification(int p_what) {
 			}
 		}
 	} else if (p_what == NOTIFICATION_ENTER_TREE) {
+		if (parallel_evaluation) {
+			parallel_trees.add(&parallel_list);
+		}
 		if (last_animation_player.is_valid()) {
 			Object *player = ObjectDB::get_instance(last_animation_player);
 			if (player) {
@@ -1339,6 +1572,8 @@ void AnimationTree::_tree_changed() {
 }
 
 void AnimationTree::_update_properties_for_node(const String &p_base_path, Ref<AnimationNode> node) {
+	graph_nodes.push_back(node.ptr());
+
 	if (!property_parent_map.has(p_base_path)) {
 		property_parent_map[p_base_path] = HashMap<StringName, StringName>();
 	}
@@ -1389,6 +1624,7 @@ void AnimationTree::_update_properties() {
 	property_parent_map.clear();
 	input_activity_map.clear();
 	input_activity_map_get.clear();
+	graph_nodes.clear();
 
 	if (root.is_valid()) {
 		_update_properties_for_node(SceneStringNames::get_singleton()->parameters_base_path, root);
@@ -1479,6 +1715,9 @@ void AnimationTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_process_mode", "mode"), &AnimationTree::set_process_mode);
 	ClassDB::bind_method(D_METHOD("get_process_mode"), &AnimationTree::get_process_mode);
 
+	ClassDB::bind_method(D_METHOD("set_parallel_evaluation", "enable"), &AnimationTree::set_parallel_evaluation);
+	ClassDB::bind_method(D_METHOD("is_parallel_evaluation_enabled"), &AnimationTree::is_parallel_evaluation_enabled);
+
 	ClassDB::bind_method(D_METHOD("set_animation_player", "root"), &AnimationTree::set_animation_player);
 	ClassDB::bind_method(D_METHOD("get_animation_player"), &AnimationTree::get_animation_player);
 
@@ -1497,6 +1736,7 @@ void AnimationTree::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "anim_player", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "AnimationPlayer"), "set_animation_player", "get_animation_player");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "active"), "set_active", "is_active");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_mode", PROPERTY_HINT_ENUM, "Physics,Idle,Manual"), "set_process_mode", "get_process_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "parallel_evaluation"), "set_parallel_evaluation", "is_parallel_evaluation_enabled");
 	ADD_GROUP("Root Motion", "root_motion_");
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_motion_track"), "set_root_motion_track", "get_root_motion_track");
 
@@ -1505,7 +1745,8 @@ void AnimationTree::_bind_methods() {
 	BIND_ENUM_CONSTANT(ANIMATION_PROCESS_MANUAL);
 }
 
-AnimationTree::AnimationTree() {
+AnimationTree::AnimationTree() :
+		parallel_list(this) {
 	process_mode = ANIMATION_PROCESS_IDLE;
 	active = false;
 	cache_valid = false;
@@ -1513,6 +1754,8 @@ AnimationTree::AnimationTree() {
 	process_pass = 1;
 	started = true;
 	properties_dirty = true;
+	parallel_evaluation = false;
+	parallel_evaluated = false;
 }
 
 AnimationTree::~AnimationTree() {
@@ -32,6 +32,9 @@
 #define ANIMATION_GRAPH_PLAYER_H
 
 #include "animation_player.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/self_list.h"
+#include "core/templates/thread_work_pool.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
 #include "scene/resources/animation.h"
@@ -92,6 +95,10 @@ public:
 	Vector<StringName> connections;
 	AnimationNode *parent;
 
+	//used to detect nodes shared by trees of the same parallel batch
+	AnimationTree *batch_owner;
+	uint64_t batch_pass;
+
 	HashMap<NodePath, bool> filter;
 	bool filter_enabled;
 
@@ -263,6 +270,57 @@ private:
 	bool _update_caches(AnimationPlayer *player);
 	void _process_graph(float p_delta);
 
+	// Tracks with side effects (method calls, audio, sub animations and
+	// discrete values), recorded while blending on a worker thread so they
+	// can run on the main thread.
+	struct TrackEvent {
+		const AnimationNode::AnimationState *anim_state;
+		int track;
+		TrackCache *cache;
+		float blend;
+	};
+
+	LocalVector<TrackEvent> track_events;
+	LocalVector<AnimationNode *> graph_nodes;
+
+	bool _prepare_graph();
+	void _evaluate_graph(float p_delta);
+	void _process_tracks(bool p_defer_events);
+	void _process_track_event(const AnimationNode::AnimationState &p_anim_state, int p_track, TrackCache *p_cache, float p_blend, bool p_can_call);
+	void _apply_graph(float p_delta);
+	void _apply_tracks();
+
+	struct ParallelBatch {
+		struct Item {
+			AnimationTree *tree;
+			float delta;
+		};
+
+		LocalVector<Item> items;
+		void evaluate(uint32_t p_index, void *p_userdata);
+	};
+
+	bool parallel_evaluation;
+	bool parallel_evaluated;
+	SelfList<AnimationTree> parallel_list;
+
+	static SelfList<AnimationTree>::List parallel_trees;
+	static ParallelBatch parallel_batch;
+	static uint64_t parallel_batch_frame[2];
+	static uint64_t parallel_batch_pass;
+	static ThreadWorkPool thread_work_pool;
+	static bool thread_work_pool_started;
+
+	bool _claim_graph_nodes();
+	bool _add_to_parallel_batch(float p_delta);
+	static void _evaluate_parallel_batch();
+	void _process_frame(float p_delta);
+	static void _process_parallel_batch(AnimationProcessMode p_mode);
+
+#ifdef TESTS_ENABLED
+	friend class AnimationTreeTester;
+#endif
+
 	uint64_t setup_pass;
 	uint64_t process_pass;
 
@@ -312,6 +370,9 @@ public:
 	void set_animation_player(const NodePath &p_player);
 	NodePath get_animation_player() const;
 
+	void set_parallel_evaluation(bool p_enable);
+	bool is_parallel_evaluation_enabled() const;
+
 	virtual String get_configuration_warning() const override;
 
 	bool is_state_invalid() const;
@@ -328,6 +389,9 @@ public:
 	void rename_parameter(const String &p_base, const String &p_new_base);
 
 	uint64_t get_last_process_pass() const;
+
+	static void finish_thread_pool();
+
 	AnimationTree();
 	~AnimationTree();
 };
@@ -1016,5 +1016,6 @@ void unregister_scene_types() {
 
 	ParticlesMaterial::finish_shaders();
 	CanvasItemMaterial::finish_shaders();
+	AnimationTree::finish_thread_pool();
 	SceneStringNames::free();
 }
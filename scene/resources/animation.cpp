@@ -31,6 +31,8 @@
 #include "animation.h"
 #include "scene/scene_string_names.h"
 
+#include "core/io/marshalls.h"
+
 #include "core/math/geometry_3d.h"
 
 bool Animation::_set(const StringName &p_name, const Variant &p_value) {
@@ -75,7 +77,48 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 		} else if (what == "enabled") {
 			track_set_enabled(track, p_value);
 		} else if (what == "keys" || what == "key_values") {
-			if (track_get_type(track) == TYPE_TRANSFORM) {
+			if (track_get_type(track) == TYPE_TRANSFORM && p_value.get_type() == Variant::DICTIONARY) {
+				// Compressed track, see _get().
+				TransformTrack *tt = static_cast<TransformTrack *>(tracks[track]);
+				Dictionary d = p_value;
+				ERR_FAIL_COND_V(!d.has("times") || !d.has("bounds") || !d.has("data"), false);
+
+				Vector<float> times = d["times"];
+				Vector<float> bounds = d["bounds"];
+				Vector<uint8_t> data = d["data"];
+				int key_count = times.size() / 2;
+				ERR_FAIL_COND_V(times.size() % 2, false);
+				ERR_FAIL_COND_V(bounds.size() != 12, false);
+				ERR_FAIL_COND_V(data.size() != key_count * (int)sizeof(CompressedTransformKey), false);
+
+				tt->transforms.clear();
+				tt->compressed = true;
+				tt->loc_min = Vector3(bounds[0], bounds[1], bounds[2]);
+				tt->loc_size = Vector3(bounds[3], bounds[4], bounds[5]);
+				tt->scale_min = Vector3(bounds[6], bounds[7], bounds[8]);
+				tt->scale_size = Vector3(bounds[9], bounds[10], bounds[11]);
+				tt->compressed_transforms.resize(key_count);
+
+				const uint8_t *r = data.ptr();
+				for (int i = 0; i < key_count; i++) {
+					TKey<CompressedTransformKey> &ck = tt->compressed_transforms.write[i];
+					ck.time = times[i * 2 + 0];
+					ck.transition = times[i * 2 + 1];
+					for (int j = 0; j < 3; j++) {
+						ck.value.loc[j] = decode_uint16(r);
+						r += 2;
+					}
+					for (int j = 0; j < 4; j++) {
+						ck.value.rot[j] = (int16_t)decode_uint16(r);
+						r += 2;
+					}
+					for (int j = 0; j < 3; j++) {
+						ck.value.scale[j] = decode_uint16(r);
+						r += 2;
+					}
+				}
+
+			} else if (track_get_type(track) == TYPE_TRANSFORM) {
 				TransformTrack *tt = static_cast<TransformTrack *>(tracks[track]);
 				Vector<float> values = p_value;
 				int vcount = values.size();
@@ -83,6 +126,8 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 
 				const float *r = values.ptr();
 
+				tt->compressed = false;
+				tt->compressed_transforms.clear();
 				tt->transforms.resize(vcount / 12);
 
 				for (int i = 0; i < (vcount / 12); i++) {
@@ -351,7 +396,51 @@ bool Animation::_get(const StringName &p_name, Variant &r_ret) const {
 		} else if (what == "enabled") {
 			r_ret = track_is_enabled(track);
 		} else if (what == "keys") {
-			if (track_get_type(track) == TYPE_TRANSFORM) {
+			if (track_is_compressed(track)) {
+				// Saved as the quantized keys, so compressed tracks stay compressed when loaded.
+				const TransformTrack *tt = static_cast<const TransformTrack *>(tracks[track]);
+				const int key_count = tt->compressed_transforms.size();
+
+				Vector<float> times;
+				times.resize(key_count * 2);
+				Vector<uint8_t> data;
+				data.resize(key_count * sizeof(CompressedTransformKey));
+
+				float *wt = times.ptrw();
+				uint8_t *w = data.ptrw();
+				for (int i = 0; i < key_count; i++) {
+					const TKey<CompressedTransformKey> &ck = tt->compressed_transforms[i];
+					wt[i * 2 + 0] = ck.time;
+					wt[i * 2 + 1] = ck.transition;
+					for (int j = 0; j < 3; j++) {
+						w += encode_uint16(ck.value.loc[j], w);
+					}
+					for (int j = 0; j < 4; j++) {
+						w += encode_uint16((uint16_t)ck.value.rot[j], w);
+					}
+					for (int j = 0; j < 3; j++) {
+						w += encode_uint16(ck.value.scale[j], w);
+					}
+				}
+
+				Vector<float> bounds;
+				bounds.resize(12);
+				for (int j = 0; j < 3; j++) {
+					bounds.write[0 + j] = tt->loc_min[j];
+					bounds.write[3 + j] = tt->loc_size[j];
+					bounds.write[6 + j] = tt->scale_min[j];
+					bounds.write[9 + j] = tt->scale_size[j];
+				}
+
+				Dictionary d;
+				d["times"] = times;
+				d["bounds"] = bounds;
+				d["data"] = data;
+
+				r_ret = d;
+				return true;
+
+			} else if (track_get_type(track) == TYPE_TRANSFORM) {
 				Vector<float> keys;
 				int kk = track_get_key_count(track);
 				keys.resize(kk * 12);
@@ -576,7 +665,8 @@ void Animation::_get_property_list(List<PropertyInfo> *p_list) const {
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/loop_wrap", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/imported", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/enabled", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
-		p_list->push_back(PropertyInfo(Variant::ARRAY, "tracks/" + itos(i) + "/keys", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		// Compressed transform tracks store their quantized keys in a dictionary, see _get().
+		p_list->push_back(PropertyInfo(track_is_compressed(i) ? Variant::DICTIONARY : Variant::ARRAY, "tracks/" + itos(i) + "/keys", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 	}
 }
 
@@ -775,16 +865,24 @@ Error Animation::transform_track_get_key(int p_track, int p_key, Vector3 *r_loc,
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, ERR_INVALID_PARAMETER);
-	ERR_FAIL_INDEX_V(p_key, tt->transforms.size(), ERR_INVALID_PARAMETER);
+
+	TransformKey tk;
+	if (tt->compressed) {
+		ERR_FAIL_INDEX_V(p_key, tt->compressed_transforms.size(), ERR_INVALID_PARAMETER);
+		tk = _decompress_key(tt, tt->compressed_transforms[p_key].value);
+	} else {
+		ERR_FAIL_INDEX_V(p_key, tt->transforms.size(), ERR_INVALID_PARAMETER);
+		tk = tt->transforms[p_key].value;
+	}
 
 	if (r_loc) {
-		*r_loc = tt->transforms[p_key].value.loc;
+		*r_loc = tk.loc;
 	}
 	if (r_rot) {
-		*r_rot = tt->transforms[p_key].value.rot;
+		*r_rot = tk.rot;
 	}
 	if (r_scale) {
-		*r_scale = tt->transforms[p_key].value.scale;
+		*r_scale = tk.scale;
 	}
 
 	return OK;
@@ -796,6 +894,7 @@ int Animation::transform_track_insert_key(int p_track, float p_time, const Vecto
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, -1);
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
+	_transform_track_decompress(tt);
 
 	TKey<TransformKey> tkey;
 	tkey.time = p_time;
@@ -821,6 +920,7 @@ void Animation::track_remove_key(int p_track, int p_idx) {
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_idx, tt->transforms.size());
 			tt->transforms.remove(p_idx);
 
@@ -867,6 +967,16 @@ int Animation::track_find_key(int p_track, float p_time, bool p_exact) const {
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				int k = _find(tt->compressed_transforms, p_time);
+				if (k < 0 || k >= tt->compressed_transforms.size()) {
+					return -1;
+				}
+				if (tt->compressed_transforms[k].time != p_time && p_exact) {
+					return -1;
+				}
+				return k;
+			}
 			int k = _find(tt->transforms, p_time);
 			if (k < 0 || k >= tt->transforms.size()) {
 				return -1;
@@ -1051,6 +1161,9 @@ int Animation::track_get_key_count(int p_track) const {
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				return tt->compressed_transforms.size();
+			}
 			return tt->transforms.size();
 		} break;
 		case TYPE_VALUE: {
@@ -1085,13 +1198,15 @@ Variant Animation::track_get_key_value(int p_track, int p_key_idx) const {
 
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
-			TransformTrack *tt = static_cast<TransformTrack *>(t);
-			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), Variant());
+			Vector3 loc;
+			Quat rot;
+			Vector3 scale;
+			ERR_FAIL_COND_V(transform_track_get_key(p_track, p_key_idx, &loc, &rot, &scale) != OK, Variant());
 
 			Dictionary d;
-			d["location"] = tt->transforms[p_key_idx].value.loc;
-			d["rotation"] = tt->transforms[p_key_idx].value.rot;
-			d["scale"] = tt->transforms[p_key_idx].value.scale;
+			d["location"] = loc;
+			d["rotation"] = rot;
+			d["scale"] = scale;
 
 			return d;
 		} break;
@@ -1154,6 +1269,10 @@ float Animation::track_get_key_time(int p_track, int p_key_idx) const {
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed_transforms.size(), -1);
+				return tt->compressed_transforms[p_key_idx].time;
+			}
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
 			return tt->transforms[p_key_idx].time;
 		} break;
@@ -1199,6 +1318,7 @@ void Animation::track_set_key_time(int p_track, int p_key_idx, float p_time) {
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 			TKey<TransformKey> key = tt->transforms[p_key_idx];
 			key.time = p_time;
@@ -1263,6 +1383,10 @@ float Animation::track_get_key_transition(int p_track, int p_key_idx) const {
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed_transforms.size(), -1);
+				return tt->compressed_transforms[p_key_idx].transition;
+			}
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
 			return tt->transforms[p_key_idx].transition;
 		} break;
@@ -1299,6 +1423,7 @@ void Animation::track_set_key_value(int p_track, int p_key_idx, const Variant &p
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 
 			Dictionary d = p_value;
@@ -1382,6 +1507,7 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 			tt->transforms.write[p_key_idx].transition = p_transition;
 		} break;
@@ -1579,30 +1705,56 @@ float Animation::_cubic_interpolate(const float &p_pre_a, const float &p_a, cons
 	return _interpolate(p_a, p_b, p_c);
 }
 
-template <class T>
-T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const {
-	int len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+template <class K>
+int Animation::_find_from_cursor(const Vector<K> &p_keys, float p_time, int *r_cursor) const {
+	if (!r_cursor) {
+		return _find(p_keys, p_time);
+	}
+
+	// Playback mostly moves forward by less than a key between samples, so the
+	// key found last time and the one after it are checked before searching.
+	const int len = p_keys.size();
+	int idx = *r_cursor;
+	for (int i = 0; i < 2 && idx >= -1 && idx < len; i++, idx++) {
+		bool after_key = idx < 0 || p_keys[idx].time < p_time || Math::is_equal_approx(p_time, p_keys[idx].time);
+		if (idx >= 0 && !after_key) {
+			break; // Went backwards.
+		}
+		bool before_next = idx + 1 >= len || (p_time < p_keys[idx + 1].time && !Math::is_equal_approx(p_time, p_keys[idx + 1].time));
+		if (after_key && before_next) {
+			*r_cursor = idx;
+			return idx;
+		}
+	}
+
+	idx = _find(p_keys, p_time);
+	*r_cursor = idx;
+	return idx;
+}
+
+template <class K>
+bool Animation::_find_interpolation_keys(const Vector<K> &p_keys, float p_time, bool p_loop_wrap, int *r_cursor, int &r_len, int &r_idx, int &r_next, float &r_c) const {
+	// Find the last key (there may be more past the end), usually the last one.
+	int len = p_keys.size();
+	if (len > 0 && p_keys[len - 1].time > length && !Math::is_equal_approx(length, p_keys[len - 1].time)) {
+		len = _find(p_keys, length) + 1;
+	}
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
 		// meaning no keys, or only key time is larger than length
-		if (p_ok) {
-			*p_ok = false;
-		}
-		return T();
+		return false;
 	} else if (len == 1) { // one key found (0+1), return it
-
-		if (p_ok) {
-			*p_ok = true;
-		}
-		return p_keys[0].value;
+		r_len = 1;
+		r_idx = r_next = 0;
+		r_c = 0;
+		return true;
 	}
 
-	int idx = _find(p_keys, p_time);
+	int idx = _find_from_cursor(p_keys, p_time, r_cursor);
 
-	ERR_FAIL_COND_V(idx == -2, T());
+	ERR_FAIL_COND_V(idx == -2, false);
 
-	bool result = true;
 	int next = 0;
 	float c = 0;
 	// prepare for all cases of interpolation
@@ -1674,11 +1826,36 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 			if (loop) {
 				idx = next = 0;
 			} else {
-				result = false;
+				return false;
 			}
 		}
 	}
 
+	float tr = p_keys[idx].transition;
+
+	if (tr == 0) {
+		// don't interpolate if not needed
+		next = idx;
+	} else if (tr != 1.0) {
+		c = Math::ease(c, tr);
+	}
+
+	r_len = len;
+	r_idx = idx;
+	r_next = next;
+	r_c = c;
+	return true;
+}
+
+template <class T>
+T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_cursor) const {
+	int len = 0;
+	int idx = 0;
+	int next = 0;
+	float c = 0;
+
+	bool result = _find_interpolation_keys(p_keys, p_time, p_loop_wrap, r_cursor, len, idx, next, c);
+
 	if (p_ok) {
 		*p_ok = result;
 	}
@@ -1686,17 +1863,11 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 		return T();
 	}
 
-	float tr = p_keys[idx].transition;
-
-	if (tr == 0 || idx == next) {
+	if (idx == next) {
 		// don't interpolate if not needed
 		return p_keys[idx].value;
 	}
 
-	if (tr != 1.0) {
-		c = Math::ease(c, tr);
-	}
-
 	switch (p_interp) {
 		case INTERPOLATION_NEAREST: {
 			return p_keys[idx].value;
@@ -1724,7 +1895,48 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 	// do a barrel roll
 }
 
-Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const {
+Animation::TransformKey Animation::_decompress_key(const TransformTrack *p_track, const CompressedTransformKey &p_key) const {
+	TransformKey tk;
+	tk.loc = p_track->loc_min + Vector3(p_key.loc[0], p_key.loc[1], p_key.loc[2]) * p_track->loc_size / 65535.0;
+	tk.rot = Quat(p_key.rot[0], p_key.rot[1], p_key.rot[2], p_key.rot[3]).normalized();
+	tk.scale = p_track->scale_min + Vector3(p_key.scale[0], p_key.scale[1], p_key.scale[2]) * p_track->scale_size / 65535.0;
+	return tk;
+}
+
+Animation::TransformKey Animation::_interpolate_compressed(const TransformTrack *p_track, float p_time, bool *p_ok, int *r_cursor) const {
+	const Vector<TKey<CompressedTransformKey>> &keys = p_track->compressed_transforms;
+
+	int len = 0;
+	int idx = 0;
+	int next = 0;
+	float c = 0;
+
+	*p_ok = _find_interpolation_keys(keys, p_time, p_track->loop_wrap, r_cursor, len, idx, next, c);
+	if (!*p_ok) {
+		return TransformKey();
+	}
+
+	if (idx == next || p_track->interpolation == INTERPOLATION_NEAREST) {
+		return _decompress_key(p_track, keys[idx].value);
+	}
+
+	if (p_track->interpolation == INTERPOLATION_CUBIC) {
+		int pre = idx - 1;
+		if (pre < 0) {
+			pre = 0;
+		}
+		int post = next + 1;
+		if (post >= len) {
+			post = next;
+		}
+
+		return _cubic_interpolate(_decompress_key(p_track, keys[pre].value), _decompress_key(p_track, keys[idx].value), _decompress_key(p_track, keys[next].value), _decompress_key(p_track, keys[post].value), c);
+	}
+
+	return _interpolate(_decompress_key(p_track, keys[idx].value), _decompress_key(p_track, keys[next].value), c);
+}
+
+Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *r_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, ERR_INVALID_PARAMETER);
@@ -1733,7 +1945,12 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
 
 	bool ok = false;
 
-	TransformKey tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok);
+	TransformKey tk;
+	if (tt->compressed) {
+		tk = _interpolate_compressed(tt, p_time, &ok, r_cursor);
+	} else {
+		tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok, r_cursor);
+	}
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1930,8 +2147,13 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
 			switch (t->type) {
 				case TYPE_TRANSFORM: {
 					const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-					_track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
-					_track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+					if (tt->compressed) {
+						_track_get_key_indices_in_range(tt->compressed_transforms, from_time, length, p_indices);
+						_track_get_key_indices_in_range(tt->compressed_transforms, 0, to_time, p_indices);
+					} else {
+						_track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
+						_track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+					}
 
 				} break;
 				case TYPE_VALUE: {
@@ -1986,7 +2208,11 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-			_track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
+			if (tt->compressed) {
+				_track_get_key_indices_in_range(tt->compressed_transforms, from_time, to_time, p_indices);
+			} else {
+				_track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
+			}
 
 		} break;
 		case TYPE_VALUE: {
@@ -2670,6 +2896,9 @@ void Animation::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("clear"), &Animation::clear);
 	ClassDB::bind_method(D_METHOD("copy_track", "track_idx", "to_animation"), &Animation::copy_track);
 
+	ClassDB::bind_method(D_METHOD("compress", "max_error"), &Animation::compress, DEFVAL(0.001));
+	ClassDB::bind_method(D_METHOD("track_is_compressed", "track_idx"), &Animation::track_is_compressed);
+
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "length", PROPERTY_HINT_RANGE, "0.001,99999,0.001"), "set_length", "get_length");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "loop"), "set_loop", "has_loop");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "step", PROPERTY_HINT_RANGE, "0,4096,0.001"), "set_step", "get_step");
@@ -2875,6 +3104,7 @@ void Animation::_transform_track_optimize(int p_idx, float p_allowed_linear_err,
 	ERR_FAIL_INDEX(p_idx, tracks.size());
 	ERR_FAIL_COND(tracks[p_idx]->type != TYPE_TRANSFORM);
 	TransformTrack *tt = static_cast<TransformTrack *>(tracks[p_idx]);
+	_transform_track_decompress(tt);
 	bool prev_erased = false;
 	TKey<TransformKey> first_erased;
 
@@ -2919,6 +3149,106 @@ void Animation::optimize(float p_allowed_linear_err, float p_allowed_angular_err
 	}
 }
 
+void Animation::_transform_track_compress(TransformTrack *p_track, float p_max_error) {
+	if (p_track->compressed || p_track->transforms.empty()) {
+		return;
+	}
+
+	const Vector<TKey<TransformKey>> &keys = p_track->transforms;
+
+	Vector3 loc_min = keys[0].value.loc;
+	Vector3 loc_max = loc_min;
+	Vector3 scale_min = keys[0].value.scale;
+	Vector3 scale_max = scale_min;
+	for (int i = 1; i < keys.size(); i++) {
+		for (int j = 0; j < 3; j++) {
+			loc_min[j] = MIN(loc_min[j], keys[i].value.loc[j]);
+			loc_max[j] = MAX(loc_max[j], keys[i].value.loc[j]);
+			scale_min[j] = MIN(scale_min[j], keys[i].value.scale[j]);
+			scale_max[j] = MAX(scale_max[j], keys[i].value.scale[j]);
+		}
+	}
+
+	const Vector3 loc_size = loc_max - loc_min;
+	const Vector3 scale_size = scale_max - scale_min;
+
+	// Components are rounded to the closest of 65536 steps over the range of the track,
+	// tracks moving too far for the allowed error keep their full precision.
+	const real_t max_size = MAX(loc_size[loc_size.max_axis()], scale_size[scale_size.max_axis()]);
+	if (max_size / 65535.0 * 0.5 > p_max_error) {
+		return;
+	}
+
+	Vector<TKey<CompressedTransformKey>> compressed;
+	compressed.resize(keys.size());
+
+	for (int i = 0; i < keys.size(); i++) {
+		const TKey<TransformKey> &key = keys[i];
+		TKey<CompressedTransformKey> &ck = compressed.write[i];
+		ck.time = key.time;
+		ck.transition = key.transition;
+
+		Quat rot = key.value.rot;
+		if (rot.length_squared() > 0) {
+			rot.normalize();
+		} else {
+			rot = Quat();
+		}
+
+		for (int j = 0; j < 3; j++) {
+			ck.value.loc[j] = loc_size[j] > 0 ? (uint16_t)CLAMP(Math::round((key.value.loc[j] - loc_min[j]) / loc_size[j] * 65535.0), 0, 65535) : 0;
+			ck.value.scale[j] = scale_size[j] > 0 ? (uint16_t)CLAMP(Math::round((key.value.scale[j] - scale_min[j]) / scale_size[j] * 65535.0), 0, 65535) : 0;
+		}
+		for (int j = 0; j < 4; j++) {
+			ck.value.rot[j] = (int16_t)CLAMP(Math::round(rot[j] * 32767.0), -32767, 32767);
+		}
+	}
+
+	p_track->loc_min = loc_min;
+	p_track->loc_size = loc_size;
+	p_track->scale_min = scale_min;
+	p_track->scale_size = scale_size;
+	p_track->compressed_transforms = compressed;
+	p_track->transforms.clear();
+	p_track->compressed = true;
+}
+
+void Animation::_transform_track_decompress(TransformTrack *p_track) {
+	if (!p_track->compressed) {
+		return;
+	}
+
+	const Vector<TKey<CompressedTransformKey>> &keys = p_track->compressed_transforms;
+	p_track->transforms.resize(keys.size());
+	for (int i = 0; i < keys.size(); i++) {
+		TKey<TransformKey> &key = p_track->transforms.write[i];
+		key.time = keys[i].time;
+		key.transition = keys[i].transition;
+		key.value = _decompress_key(p_track, keys[i].value);
+	}
+
+	p_track->compressed_transforms.clear();
+	p_track->compressed = false;
+}
+
+void Animation::compress(float p_max_error) {
+	ERR_FAIL_COND(p_max_error <= 0);
+	for (int i = 0; i < tracks.size(); i++) {
+		if (tracks[i]->type == TYPE_TRANSFORM) {
+			_transform_track_compress(static_cast<TransformTrack *>(tracks[i]), p_max_error);
+		}
+	}
+	emit_changed();
+}
+
+bool Animation::track_is_compressed(int p_track) const {
+	ERR_FAIL_INDEX_V(p_track, tracks.size(), false);
+	if (tracks[p_track]->type != TYPE_TRANSFORM) {
+		return false;
+	}
+	return static_cast<const TransformTrack *>(tracks[p_track])->compressed;
+}
+
 Animation::Animation() {
 	step = 0.1;
 	loop = false;
@@ -101,11 +101,27 @@ private:
 		Vector3 scale;
 	};
 
+	// Quantized transform key, relative to the bounds of its track.
+	struct CompressedTransformKey {
+		uint16_t loc[3];
+		int16_t rot[4];
+		uint16_t scale[3];
+	};
+
 	/* TRANSFORM TRACK */
 
 	struct TransformTrack : public Track {
 		Vector<TKey<TransformKey>> transforms;
 
+		// Once compressed, the keys are kept quantized in compressed_transforms
+		// and transforms is empty until the track is edited again.
+		bool compressed = false;
+		Vector<TKey<CompressedTransformKey>> compressed_transforms;
+		Vector3 loc_min;
+		Vector3 loc_size;
+		Vector3 scale_min;
+		Vector3 scale_size;
+
 		TransformTrack() { type = TYPE_TRANSFORM; }
 	};
 
@@ -194,6 +210,10 @@ private:
 
 	template <class K>
 	inline int _find(const Vector<K> &p_keys, float p_time) const;
+	template <class K>
+	inline int _find_from_cursor(const Vector<K> &p_keys, float p_time, int *r_cursor) const;
+	template <class K>
+	_FORCE_INLINE_ bool _find_interpolation_keys(const Vector<K> &p_keys, float p_time, bool p_loop_wrap, int *r_cursor, int &r_len, int &r_idx, int &r_next, float &r_c) const;
 
 	_FORCE_INLINE_ Animation::TransformKey _interpolate(const Animation::TransformKey &p_a, const Animation::TransformKey &p_b, float p_c) const;
 
@@ -209,7 +229,12 @@ private:
 	_FORCE_INLINE_ float _cubic_interpolate(const float &p_pre_a, const float &p_a, const float &p_b, const float &p_post_b, float p_c) const;
 
 	template <class T>
-	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const;
+	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_cursor = nullptr) const;
+	TransformKey _interpolate_compressed(const TransformTrack *p_track, float p_time, bool *p_ok, int *r_cursor) const;
+
+	_FORCE_INLINE_ TransformKey _decompress_key(const TransformTrack *p_track, const CompressedTransformKey &p_key) const;
+	void _transform_track_compress(TransformTrack *p_track, float p_max_error);
+	void _transform_track_decompress(TransformTrack *p_track);
 
 	template <class T>
 	_FORCE_INLINE_ void _track_get_key_indices_in_range(const Vector<T> &p_array, float from_time, float to_time, List<int> *p_indices) const;
@@ -331,7 +356,7 @@ public:
 	void track_set_interpolation_loop_wrap(int p_track, bool p_enable);
 	bool track_get_interpolation_loop_wrap(int p_track) const;
 
-	Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const;
+	Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *r_cursor = nullptr) const;
 
 	Variant value_track_interpolate(int p_track, float p_time) const;
 	void value_track_get_key_indices(int p_track, float p_time, float p_delta, List<int> *p_indices) const;
@@ -359,6 +384,9 @@ public:
 
 	void optimize(float p_allowed_linear_err = 0.05, float p_allowed_angular_err = 0.01, float p_max_optimizable_angle = Math_PI * 0.125);
 
+	void compress(float p_max_error = 0.001);
+	bool track_is_compressed(int p_track) const;
+
 	Animation();
 	~Animation();
 };
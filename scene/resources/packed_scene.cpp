@@ -41,6 +41,39 @@
 
 #define PACKED_SCENE_VERSION 2
 
+void SceneState::_update_setter_cache() const {
+	MutexLock lock(setter_cache_mutex);
+	if (!setter_cache_dirty) {
+		return;
+	}
+
+	setter_cache.resize(nodes.size());
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		Vector<const ClassDB::PropertySetGet *> &setters = setter_cache.write[i];
+		setters.clear();
+
+		if (n.instance >= 0 || n.type == TYPE_INSTANCED || n.type < 0 || n.type >= names.size()) {
+			continue; // Type only known once instanced, always use Object::set().
+		}
+
+		setters.resize(n.properties.size());
+		for (int j = 0; j < n.properties.size(); j++) {
+			const ClassDB::PropertySetGet *psg = nullptr;
+			int name = n.properties[j].name;
+			if (name >= 0 && name < names.size()) {
+				psg = ClassDB::get_property_setget(names[n.type], names[name]);
+				if (psg && !psg->_setptr) {
+					psg = nullptr; // Setter is not a bound method, let Object::set() resolve it.
+				}
+			}
+			setters.write[j] = psg;
+		}
+	}
+
+	setter_cache_dirty = false;
+}
+
 bool SceneState::can_instance() const {
 	return nodes.size() > 0;
 }
@@ -84,6 +117,14 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
 	Map<Ref<Resource>, Ref<Resource>> resources_local_to_scene;
 
+	// The editor relies on Object::set() marking objects as edited, so only use cached setters at runtime.
+	Vector<Vector<const ClassDB::PropertySetGet *>> setters;
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED) {
+		_update_setter_cache();
+		MutexLock lock(setter_cache_mutex);
+		setters = setter_cache;
+	}
+
 	for (int i = 0; i < nc; i++) {
 		const NodeData &n = nd[i];
 
@@ -187,6 +228,11 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 			if (nprop_count) {
 				const NodeData::Property *nprops = &n.properties[0];
 
+				const ClassDB::PropertySetGet *const *nsetters = nullptr;
+				if (i < setters.size() && setters[i].size() == nprop_count && node->get_class_name() == snames[n.type]) {
+					nsetters = setters[i].ptr();
+				}
+
 				for (int j = 0; j < nprop_count; j++) {
 					bool valid;
 					ERR_FAIL_INDEX_V(nprops[j].name, sname_count, nullptr);
@@ -243,7 +289,22 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 						} else if (p_edit_state == GEN_EDIT_STATE_INSTANCE) {
 							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor
 						}
-						node->set(snames[nprops[j].name], value, &valid);
+
+						const ClassDB::PropertySetGet *psg = nsetters ? nsetters[j] : nullptr;
+						if (psg && !node->get_script_instance()) {
+							// Same call ClassDB::set_property() ends up doing, minus the lookups.
+							Callable::CallError ce;
+							if (psg->index >= 0) {
+								Variant index = psg->index;
+								const Variant *args[2] = { &index, &value };
+								psg->_setptr->call(node, args, 2, ce);
+							} else {
+								const Variant *args[1] = { &value };
+								psg->_setptr->call(node, args, 1, ce);
+							}
+						} else {
+							node->set(snames[nprops[j].name], value, &valid);
+						}
 					}
 				}
 			}
@@ -647,6 +708,7 @@ Error SceneState::_parse_node(Node *p_owner, Node *p_node, int p_parent_idx, Map
 
 		parent_node = idx;
 		nodes.push_back(nd);
+		setter_cache_dirty = true;
 	}
 
 	for (int i = 0; i < p_node->get_child_count(); i++) {
@@ -904,6 +966,7 @@ void SceneState::clear() {
 	variants.clear();
 	nodes.clear();
 	connections.clear();
+	setter_cache_dirty = true;
 	node_path_cache.clear();
 	node_paths.clear();
 	editable_instances.clear();
@@ -1095,6 +1158,7 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 	}
 
 	nodes.resize(node_count);
+	setter_cache_dirty = true;
 	if (node_count) {
 		const int *r = snodes.ptr();
 		int idx = 0;
@@ -1501,6 +1565,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.index = p_index;
 
 	nodes.push_back(nd);
+	setter_cache_dirty = true;
 
 	return nodes.size() - 1;
 }
@@ -1514,6 +1579,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value) {
 	prop.name = p_name;
 	prop.value = p_value;
 	nodes.write[p_node].properties.push_back(prop);
+	setter_cache_dirty = true;
 }
 
 void SceneState::add_node_group(int p_node, int p_group) {
@@ -1596,6 +1662,7 @@ SceneState::SceneState() {
 ////////////////
 
 void PackedScene::_set_bundled_scene(const Dictionary &p_scene) {
+	clear_pool();
 	state->set_bundled_scene(p_scene);
 }
 
@@ -1604,10 +1671,12 @@ Dictionary PackedScene::_get_bundled_scene() const {
 }
 
 Error PackedScene::pack(Node *p_scene) {
+	clear_pool();
 	return state->pack(p_scene);
 }
 
 void PackedScene::clear() {
+	clear_pool();
 	state->clear();
 }
 
@@ -1638,7 +1707,248 @@ Node *PackedScene::instance(GenEditState p_edit_state) const {
 	return s;
 }
 
+Vector<PackedScene::PoolNodeState> PackedScene::_capture_pool_reset_state(Node *p_root) {
+	Vector<PoolNodeState> reset_state;
+
+	List<Node *> to_visit;
+	to_visit.push_back(p_root);
+	while (to_visit.size()) {
+		Node *node = to_visit.front()->get();
+		to_visit.pop_front();
+
+		PoolNodeState ns;
+		ns.path = p_root->get_path_to(node);
+
+		List<PropertyInfo> plist;
+		node->get_property_list(&plist);
+		for (List<PropertyInfo>::Element *E = plist.front(); E; E = E->next()) {
+			if (!(E->get().usage & PROPERTY_USAGE_STORAGE) || E->get().name == CoreStringNames::get_singleton()->_script) {
+				continue;
+			}
+
+			Variant value = node->get(E->get().name);
+			Ref<Resource> res = value;
+			if (res.is_valid() && res->is_local_to_scene()) {
+				continue; // Owned by this instance, every instance keeps its own copy.
+			}
+			if (value.get_type() == Variant::ARRAY || value.get_type() == Variant::DICTIONARY) {
+				value = value.duplicate(true);
+			}
+			ns.properties.push_back(Pair<StringName, Variant>(E->get().name, value));
+		}
+
+		ns.child_count = node->get_child_count();
+
+		List<Node::GroupInfo> groups;
+		node->get_groups(&groups);
+		for (List<Node::GroupInfo>::Element *E = groups.front(); E; E = E->next()) {
+			ns.groups.push_back(E->get().name);
+		}
+
+		List<Object::Connection> connections;
+		node->get_all_signal_connections(&connections);
+		ns.connection_count = connections.size();
+		connections.clear();
+		node->get_signals_connected_to_this(&connections);
+		ns.incoming_connection_count = connections.size();
+
+		reset_state.push_back(ns);
+
+		for (int i = 0; i < node->get_child_count(); i++) {
+			to_visit.push_back(node->get_child(i));
+		}
+	}
+
+	return reset_state;
+}
+
+bool PackedScene::_has_pool_reset_structure(Node *p_root, const Vector<PoolNodeState> &p_reset_state) {
+	if (p_reset_state.empty()) {
+		return false;
+	}
+
+	// Nodes, groups and connections added or removed since it was instanced
+	// are not undone by the reset, so such an instance can't be reused.
+	for (int i = 0; i < p_reset_state.size(); i++) {
+		const PoolNodeState &ns = p_reset_state[i];
+		Node *node = i == 0 ? p_root : p_root->get_node_or_null(ns.path);
+		if (!node || node->get_child_count() != ns.child_count) {
+			return false;
+		}
+
+		List<Node::GroupInfo> groups;
+		node->get_groups(&groups);
+		if (groups.size() != ns.groups.size()) {
+			return false;
+		}
+		for (int j = 0; j < ns.groups.size(); j++) {
+			if (!node->is_in_group(ns.groups[j])) {
+				return false;
+			}
+		}
+
+		List<Object::Connection> connections;
+		node->get_all_signal_connections(&connections);
+		if (connections.size() != ns.connection_count) {
+			return false;
+		}
+		connections.clear();
+		node->get_signals_connected_to_this(&connections);
+		if (connections.size() != ns.incoming_connection_count) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void PackedScene::_reset_pooled_instance(Node *p_root, const Vector<PoolNodeState> &p_reset_state) {
+	for (int i = 0; i < p_reset_state.size(); i++) {
+		const PoolNodeState &ns = p_reset_state[i];
+		Node *node = i == 0 ? p_root : p_root->get_node(ns.path);
+
+		for (int j = 0; j < ns.properties.size(); j++) {
+			const Variant &value = ns.properties[j].second;
+			if (value.get_type() == Variant::ARRAY || value.get_type() == Variant::DICTIONARY) {
+				node->set(ns.properties[j].first, value.duplicate(true));
+			} else {
+				node->set(ns.properties[j].first, value);
+			}
+		}
+
+		node->request_ready();
+	}
+}
+
+void PackedScene::_add_pool_instance(Node *p_node) {
+	pool_instances.insert(p_node->get_instance_id());
+
+	if (pool_instances.size() > pool_instances_prune_size) {
+		// Instances freed without being released are never erased, drop them from time to time.
+		Set<ObjectID>::Element *E = pool_instances.front();
+		while (E) {
+			Set<ObjectID>::Element *N = E->next();
+			if (!ObjectDB::get_instance(E->get())) {
+				pool_instances.erase(E);
+			}
+			E = N;
+		}
+		pool_instances_prune_size = MAX(64, pool_instances.size() * 2);
+	}
+}
+
+Node *PackedScene::instance_pooled() {
+	Node *node = nullptr;
+	bool capture = false;
+	{
+		MutexLock lock(pool_mutex);
+		if (pool.size()) {
+			node = pool.front()->get();
+			pool.pop_front();
+		}
+		capture = pool_reset_state.empty();
+	}
+
+	if (!node) {
+		node = instance();
+		ERR_FAIL_COND_V(!node, nullptr);
+
+		if (capture) {
+			// Getters may run script code, so the pool isn't locked while reading them.
+			Vector<PoolNodeState> reset_state = _capture_pool_reset_state(node);
+
+			MutexLock lock(pool_mutex);
+			if (pool_reset_state.empty()) {
+				pool_reset_state = reset_state;
+			}
+		}
+	}
+
+	MutexLock lock(pool_mutex);
+	_add_pool_instance(node);
+
+	return node;
+}
+
+void PackedScene::release_instance(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(p_node->is_queued_for_deletion(), "Can't release an instance that is queued for deletion.");
+
+	Vector<PoolNodeState> reset_state;
+	bool pool_full = false;
+	{
+		MutexLock lock(pool_mutex);
+		ERR_FAIL_COND_MSG(!pool_instances.has(p_node->get_instance_id()), "Can't release a node that wasn't obtained with instance_pooled() from this scene.");
+		pool_instances.erase(p_node->get_instance_id());
+
+		reset_state = pool_reset_state;
+		pool_full = pool.size() >= pool_size;
+	}
+
+	if (p_node->get_parent()) {
+		p_node->get_parent()->remove_child(p_node);
+	}
+
+	// Setters may run script code, so the pool isn't locked while resetting.
+	bool reuse = !pool_full && _has_pool_reset_structure(p_node, reset_state);
+	if (reuse) {
+		_reset_pooled_instance(p_node, reset_state);
+
+		MutexLock lock(pool_mutex);
+		reuse = pool.size() < pool_size;
+		if (reuse) {
+			pool.push_back(p_node);
+		}
+	}
+
+	if (!reuse) {
+		memdelete(p_node);
+	}
+}
+
+void PackedScene::set_pool_size(int p_size) {
+	ERR_FAIL_COND(p_size < 0);
+
+	List<Node *> to_free;
+	{
+		MutexLock lock(pool_mutex);
+		pool_size = p_size;
+		while (pool.size() > pool_size) {
+			to_free.push_back(pool.back()->get());
+			pool.pop_back();
+		}
+	}
+
+	for (List<Node *>::Element *E = to_free.front(); E; E = E->next()) {
+		memdelete(E->get());
+	}
+}
+
+int PackedScene::get_pool_size() const {
+	return pool_size;
+}
+
+int PackedScene::get_pooled_instance_count() const {
+	MutexLock lock(pool_mutex);
+	return pool.size();
+}
+
+void PackedScene::clear_pool() {
+	List<Node *> to_free;
+	{
+		MutexLock lock(pool_mutex);
+		to_free = pool;
+		pool.clear();
+		pool_reset_state.clear();
+	}
+
+	for (List<Node *>::Element *E = to_free.front(); E; E = E->next()) {
+		memdelete(E->get());
+	}
+}
+
 void PackedScene::replace_state(Ref<SceneState> p_by) {
+	clear_pool();
 	state = p_by;
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -1647,6 +1957,7 @@ void PackedScene::replace_state(Ref<SceneState> p_by) {
 }
 
 void PackedScene::recreate_state() {
+	clear_pool();
 	state = Ref<SceneState>(memnew(SceneState));
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -1667,6 +1978,12 @@ void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pack", "path"), &PackedScene::pack);
 	ClassDB::bind_method(D_METHOD("instance", "edit_state"), &PackedScene::instance, DEFVAL(GEN_EDIT_STATE_DISABLED));
 	ClassDB::bind_method(D_METHOD("can_instance"), &PackedScene::can_instance);
+	ClassDB::bind_method(D_METHOD("instance_pooled"), &PackedScene::instance_pooled);
+	ClassDB::bind_method(D_METHOD("release_instance", "node"), &PackedScene::release_instance);
+	ClassDB::bind_method(D_METHOD("set_pool_size", "size"), &PackedScene::set_pool_size);
+	ClassDB::bind_method(D_METHOD("get_pool_size"), &PackedScene::get_pool_size);
+	ClassDB::bind_method(D_METHOD("get_pooled_instance_count"), &PackedScene::get_pooled_instance_count);
+	ClassDB::bind_method(D_METHOD("clear_pool"), &PackedScene::clear_pool);
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
 	ClassDB::bind_method(D_METHOD("get_state"), &PackedScene::get_state);
@@ -1681,3 +1998,7 @@ void PackedScene::_bind_methods() {
 PackedScene::PackedScene() {
 	state = Ref<SceneState>(memnew(SceneState));
 }
+
+PackedScene::~PackedScene() {
+	clear_pool();
+}
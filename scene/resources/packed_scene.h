@@ -88,6 +88,13 @@ class SceneState : public Reference {
 
 	Vector<ConnectionData> connections;
 
+	// Setters resolved per node property, so instancing can skip the name lookups done by Object::set().
+	mutable Vector<Vector<const ClassDB::PropertySetGet *>> setter_cache;
+	mutable bool setter_cache_dirty = true;
+	mutable Mutex setter_cache_mutex;
+
+	void _update_setter_cache() const;
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 
@@ -195,6 +202,29 @@ class PackedScene : public Resource {
 
 	Ref<SceneState> state;
 
+	struct PoolNodeState {
+		NodePath path;
+		Vector<Pair<StringName, Variant>> properties;
+		// Only instances with the same structure can be reset.
+		int child_count = 0;
+		Vector<StringName> groups;
+		int connection_count = 0;
+		int incoming_connection_count = 0;
+	};
+
+	// Released instances waiting to be reused, and the property values they are reset to.
+	List<Node *> pool;
+	Vector<PoolNodeState> pool_reset_state;
+	Set<ObjectID> pool_instances; // Handed out by instance_pooled(), so they can be released.
+	int pool_instances_prune_size = 64;
+	int pool_size = 64;
+	Mutex pool_mutex;
+
+	static Vector<PoolNodeState> _capture_pool_reset_state(Node *p_root);
+	static bool _has_pool_reset_structure(Node *p_root, const Vector<PoolNodeState> &p_reset_state);
+	static void _reset_pooled_instance(Node *p_root, const Vector<PoolNodeState> &p_reset_state);
+	void _add_pool_instance(Node *p_node);
+
 	void _set_bundled_scene(const Dictionary &p_scene);
 	Dictionary _get_bundled_scene() const;
 
@@ -216,6 +246,13 @@ public:
 	bool can_instance() const;
 	Node *instance(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
 
+	Node *instance_pooled();
+	void release_instance(Node *p_node);
+	void set_pool_size(int p_size);
+	int get_pool_size() const;
+	int get_pooled_instance_count() const;
+	void clear_pool();
+
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
 
@@ -227,6 +264,7 @@ public:
 	Ref<SceneState> get_state();
 
 	PackedScene();
+	~PackedScene();
 };
 
 VARIANT_ENUM_CAST(PackedScene::GenEditState)
@@ -355,20 +355,38 @@ Ref<Image> StreamTexture2D::load_image_from_file(FileAccess *f, int p_size_limit
 				continue;
 			}
 
-			Vector<uint8_t> pv;
-			pv.resize(size);
-			{
-				uint8_t *wr = pv.ptrw();
-				f->get_buffer(wr, size);
+			Ref<Image> img;
+
+			// PNG and WebP data can be decoded straight from a memory mapped pack,
+			// after skipping Godot's own 4 byte prefix.
+			const uint8_t *mapped = nullptr;
+			if (data_format != DATA_FORMAT_BASIS_UNIVERSAL && size > 4) {
+				mapped = f->get_buffer_ptr(size);
 			}
 
-			Ref<Image> img;
-			if (data_format == DATA_FORMAT_BASIS_UNIVERSAL) {
-				img = Image::basis_universal_unpacker(pv);
-			} else if (data_format == DATA_FORMAT_LOSSLESS) {
-				img = Image::lossless_unpacker(pv);
+			if (mapped && data_format == DATA_FORMAT_LOSSLESS && Image::_png_mem_loader_func) {
+				ERR_FAIL_COND_V(mapped[0] != 'P' || mapped[1] != 'N' || mapped[2] != 'G' || mapped[3] != ' ', Ref<Image>());
+				img = Image::_png_mem_loader_func(&mapped[4], size - 4);
+			} else if (mapped && data_format == DATA_FORMAT_LOSSY && Image::_webp_mem_loader_func) {
+				ERR_FAIL_COND_V(mapped[0] != 'W' || mapped[1] != 'E' || mapped[2] != 'B' || mapped[3] != 'P', Ref<Image>());
+				img = Image::_webp_mem_loader_func(&mapped[4], size - 4);
 			} else {
-				img = Image::lossy_unpacker(pv);
+				Vector<uint8_t> pv;
+				pv.resize(size);
+				if (mapped) {
+					copymem(pv.ptrw(), mapped, size);
+				} else {
+					uint8_t *wr = pv.ptrw();
+					f->get_buffer(wr, size);
+				}
+
+				if (data_format == DATA_FORMAT_BASIS_UNIVERSAL) {
+					img = Image::basis_universal_unpacker(pv);
+				} else if (data_format == DATA_FORMAT_LOSSLESS) {
+					img = Image::lossless_unpacker(pv);
+				} else {
+					img = Image::lossy_unpacker(pv);
+				}
 			}
 
 			if (img.is_null() || img->empty()) {
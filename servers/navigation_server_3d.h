@@ -90,6 +90,18 @@ public:
 	/// Returns the navigation path to reach the destination from the origin.
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize) const = 0;
 
+	/// Queue a path query, solved together with the other pending queries on
+	/// worker threads during the next `process`. The returned `RID` is used to
+	/// poll the result and must be released with `free`.
+	/// The optional receiver method is called with the query and the path.
+	virtual RID map_query_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, Object *p_receiver = nullptr, StringName p_method = StringName(), Variant p_udata = Variant()) const = 0;
+
+	/// Returns true once the path query is solved.
+	virtual bool path_query_is_done(RID p_query) const = 0;
+
+	/// Returns the path found by the query, empty until it is solved.
+	virtual Vector<Vector3> path_query_get_path(RID p_query) const = 0;
+
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const = 0;
 	virtual Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const = 0;
 	virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const = 0;
@@ -175,7 +187,7 @@ public:
 	/// Control activation of this server.
 	virtual void set_active(bool p_active) const = 0;
 
-	/// Process the collision avoidance agents.
+	/// Process the collision avoidance agents and solves the queued path queries.
 	/// The result of this process is needed by the physics server,
 	/// so this must be called in the main thread.
 	/// Note: This function is not thread safe.
@@ -44,10 +44,10 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 	memset(z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 
 	for (int i = 0; i < p_child_item_count; i++) {
-		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr);
+		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, 0);
 	}
 	if (p_canvas_item) {
-		_cull_canvas_item(p_canvas_item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr);
+		_cull_canvas_item(p_canvas_item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, 0);
 	}
 
 	RendererCanvasRender::Item *list = nullptr;
@@ -104,7 +104,146 @@ void _mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner, RID_PtrOwner<Rende
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
-void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **z_list, RendererCanvasRender::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner) {
+bool RendererCanvasCull::_is_rect_volatile(const Item *p_item) {
+	if (p_item->canvas_group) {
+		return true; //may redo its own commands while culling
+	}
+
+	if (p_item->custom_rect) {
+		return false;
+	}
+
+	if (p_item->update_when_visible) {
+		return true;
+	}
+
+	const Item::Command *c = p_item->commands;
+	while (c) {
+		if (c->type == Item::Command::TYPE_MESH || c->type == Item::Command::TYPE_MULTIMESH || c->type == Item::Command::TYPE_PARTICLES) {
+			return true; //rect depends on resources that may change without the item knowing
+		}
+		c = c->next;
+	}
+
+	return false;
+}
+
+bool RendererCanvasCull::_is_child_indexable(const Item *p_item) {
+	if (p_item->child_items.size() || p_item->sort_y || p_item->canvas_group || p_item->copy_back_buffer || p_item->vp_render || p_item->update_when_visible) {
+		return false;
+	}
+
+	return !_is_rect_volatile(p_item);
+}
+
+static _FORCE_INLINE_ AABB _get_child_index_aabb(const RendererCanvasCull::Item *p_item) {
+	Rect2 rect = p_item->xform.xform(p_item->get_rect());
+	return AABB(Vector3(rect.position.x, rect.position.y, 0), Vector3(rect.size.x, rect.size.y, 0));
+}
+
+void RendererCanvasCull::_update_child_index(Item *p_canvas_item) {
+	Item::ChildIndex *index = p_canvas_item->child_index;
+
+	if (!index->rebuild) {
+		for (uint32_t i = 0; i < index->dirty.size(); i++) {
+			Item *child = index->dirty[i];
+			if (_is_child_indexable(child) != child->child_index_id.is_valid()) {
+				index->rebuild = true;
+				break;
+			}
+			child->child_index_dirty = false;
+			if (child->child_index_id.is_valid()) {
+				index->bvh.update(child->child_index_id, _get_child_index_aabb(child));
+			}
+		}
+		index->dirty.clear();
+	}
+
+	if (!index->rebuild) {
+		return;
+	}
+
+	index->bvh.clear();
+	index->unindexed.clear();
+	index->dirty.clear();
+
+	int child_item_count = p_canvas_item->child_items.size();
+	Item **child_items = p_canvas_item->child_items.ptrw();
+
+	for (int i = 0; i < child_item_count; i++) {
+		Item *child = child_items[i];
+		child->child_index_pos = i;
+		child->child_index_dirty = false;
+
+		if (_is_child_indexable(child)) {
+			child->child_index_id = index->bvh.insert(_get_child_index_aabb(child), child);
+		} else {
+			child->child_index_id = DynamicBVH::ID();
+			index->unindexed.push_back(i);
+		}
+	}
+
+	index->rebuild = false;
+}
+
+void RendererCanvasCull::_cull_child_index(Item *p_canvas_item, const Transform2D &p_xform, const Rect2 &p_clip_rect, LocalVector<Item *> &r_children) {
+	_update_child_index(p_canvas_item);
+
+	Item::ChildIndex *index = p_canvas_item->child_index;
+
+	// Same test as done per item when drawing, but in the space of the children. Grown by a unit as
+	// child transforms may be snapped to pixel.
+	Rect2 local_view = p_xform.affine_inverse().xform(Rect2(Vector2(), p_clip_rect.size)).grow(1.0);
+
+	struct CullResult {
+		LocalVector<uint32_t> positions;
+
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			positions.push_back(static_cast<Item *>(p_data)->child_index_pos);
+			return false;
+		}
+	} result;
+
+	index->bvh.aabb_query(AABB(Vector3(local_view.position.x, local_view.position.y, 0), Vector3(local_view.size.x, local_view.size.y, 0)), result);
+	result.positions.sort();
+
+	//merge back with the children that are always visited, keeping draw order
+	Item **child_items = p_canvas_item->child_items.ptrw();
+	const LocalVector<uint32_t> &unindexed = index->unindexed;
+	uint32_t from_query = 0;
+	uint32_t from_unindexed = 0;
+
+	r_children.reserve(result.positions.size() + unindexed.size());
+
+	while (from_query < result.positions.size() || from_unindexed < unindexed.size()) {
+		if (from_unindexed == unindexed.size() || (from_query < result.positions.size() && result.positions[from_query] < unindexed[from_unindexed])) {
+			r_children.push_back(child_items[result.positions[from_query++]]);
+		} else {
+			r_children.push_back(child_items[unindexed[from_unindexed++]]);
+		}
+	}
+}
+
+void RendererCanvasCull::_mark_child_index_dirty(Item *p_item) {
+	if (p_item->child_index_dirty || !canvas_item_owner.owns(p_item->parent)) {
+		return;
+	}
+
+	Item *parent = canvas_item_owner.getornull(p_item->parent);
+	if (!parent->child_index) {
+		return;
+	}
+
+	p_item->child_index_dirty = true;
+	parent->child_index->dirty.push_back(p_item);
+}
+
+void RendererCanvasCull::_mark_item_dirty(Item *p_item) {
+	p_item->global_dirty = true;
+	_mark_child_index_dirty(p_item);
+}
+
+void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **z_list, RendererCanvasRender::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner, uint64_t p_parent_version) {
 	Item *ci = p_canvas_item;
 
 	if (!ci->visible) {
@@ -114,16 +253,45 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 	if (ci->children_order_dirty) {
 		ci->child_items.sort_custom<ItemIndexSort>();
 		ci->children_order_dirty = false;
+		if (ci->child_index) {
+			ci->child_index->rebuild = true;
+		}
+	}
+
+	// Parent values are known unchanged when the parent kept the version we computed against,
+	// otherwise (top level and Y sorted items) they are compared.
+	bool global_valid = !ci->global_dirty && ci->global_snapped == snapping_2d_transforms_to_pixel;
+	if (global_valid) {
+		if (p_parent_version) {
+			global_valid = ci->parent_version_cache == p_parent_version;
+		} else {
+			global_valid = ci->parent_xform_cache == p_transform && ci->parent_modulate_cache == p_modulate;
+		}
 	}
 
-	Rect2 rect = ci->get_rect();
-	Transform2D xform = ci->xform;
-	if (snapping_2d_transforms_to_pixel) {
-		xform.elements[2] = xform.elements[2].floor();
+	if (!global_valid) {
+		Transform2D local_xform = ci->xform;
+		if (snapping_2d_transforms_to_pixel) {
+			local_xform.elements[2] = local_xform.elements[2].floor();
+		}
+		ci->global_xform_cache = p_transform * local_xform;
+		ci->global_modulate_cache = Color(ci->modulate.r * p_modulate.r, ci->modulate.g * p_modulate.g, ci->modulate.b * p_modulate.b, ci->modulate.a * p_modulate.a);
+		ci->cull_rect_cache = ci->global_xform_cache.xform(ci->get_rect());
+		ci->rect_volatile = _is_rect_volatile(ci);
+
+		ci->parent_xform_cache = p_transform;
+		ci->parent_modulate_cache = p_modulate;
+		ci->parent_version_cache = p_parent_version;
+		ci->global_snapped = snapping_2d_transforms_to_pixel;
+		ci->global_version = ++global_version_counter;
+		ci->global_dirty = false;
+	} else if (ci->rect_volatile) {
+		ci->cull_rect_cache = ci->global_xform_cache.xform(ci->get_rect());
 	}
-	xform = p_transform * xform;
 
-	Rect2 global_rect = xform.xform(rect);
+	const Transform2D &xform = ci->global_xform_cache;
+
+	Rect2 global_rect = ci->cull_rect_cache;
 	global_rect.position += p_clip_rect.position;
 
 	if (ci->use_parent_material && p_material_owner) {
@@ -133,7 +301,7 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		ci->material_owner = nullptr;
 	}
 
-	Color modulate(ci->modulate.r * p_modulate.r, ci->modulate.g * p_modulate.g, ci->modulate.b * p_modulate.b, ci->modulate.a * p_modulate.a);
+	const Color &modulate = ci->global_modulate_cache;
 
 	if (modulate.a < 0.007) {
 		return;
@@ -170,6 +338,22 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		sorter.sort(child_items, child_item_count);
 	}
 
+	LocalVector<Item *> indexed_children;
+
+	if (!ci->sort_y && child_item_count >= CHILD_INDEX_MIN_ITEMS) {
+		if (!ci->child_index) {
+			ci->child_index = memnew(Item::ChildIndex);
+		}
+		if (xform.basis_determinant() != 0) {
+			_cull_child_index(ci, xform, p_clip_rect, indexed_children);
+			child_items = indexed_children.ptr();
+			child_item_count = indexed_children.size();
+		}
+	} else if (ci->child_index) {
+		memdelete(ci->child_index);
+		ci->child_index = nullptr;
+	}
+
 	if (ci->z_relative) {
 		p_z = CLAMP(p_z + ci->z_index, RS::CANVAS_ITEM_Z_MIN, RS::CANVAS_ITEM_Z_MAX);
 	} else {
@@ -188,9 +372,9 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			continue;
 		}
 		if (ci->sort_y) {
-			_cull_canvas_item(child_items[i], xform * child_items[i]->ysort_xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner);
+			_cull_canvas_item(child_items[i], xform * child_items[i]->ysort_xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, 0);
 		} else {
-			_cull_canvas_item(child_items[i], xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, p_material_owner);
+			_cull_canvas_item(child_items[i], xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, p_material_owner, ci->global_version);
 		}
 	}
 
@@ -295,9 +479,9 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			continue;
 		}
 		if (ci->sort_y) {
-			_cull_canvas_item(child_items[i], xform * child_items[i]->ysort_xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner);
+			_cull_canvas_item(child_items[i], xform * child_items[i]->ysort_xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, 0);
 		} else {
-			_cull_canvas_item(child_items[i], xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, p_material_owner);
+			_cull_canvas_item(child_items[i], xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, p_material_owner, ci->global_version);
 		}
 	}
 }
@@ -411,6 +595,10 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 		} else if (canvas_item_owner.owns(canvas_item->parent)) {
 			Item *item_owner = canvas_item_owner.getornull(canvas_item->parent);
 			item_owner->child_items.erase(canvas_item);
+			if (item_owner->child_index) {
+				item_owner->child_index->rebuild = true;
+			}
+			_mark_child_index_dirty(item_owner);
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -431,6 +619,7 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 			Item *item_owner = canvas_item_owner.getornull(p_parent);
 			item_owner->child_items.push_back(canvas_item);
 			item_owner->children_order_dirty = true;
+			_mark_child_index_dirty(item_owner);
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -465,6 +654,7 @@ void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->xform = p_transform;
+	_mark_item_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_set_clip(RID p_item, bool p_clip) {
@@ -487,6 +677,7 @@ void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_r
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
+	_mark_item_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_set_modulate(RID p_item, const Color &p_color) {
@@ -494,6 +685,7 @@ void RendererCanvasCull::canvas_item_set_modulate(RID p_item, const Color &p_col
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->modulate = p_color;
+	canvas_item->global_dirty = true;
 }
 
 void RendererCanvasCull::canvas_item_set_self_modulate(RID p_item, const Color &p_color) {
@@ -515,6 +707,7 @@ void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->update_when_visible = p_update;
+	_mark_item_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width) {
@@ -523,6 +716,7 @@ void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from,
 
 	Item::CommandPrimitive *line = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_COND(!line);
+	_mark_item_dirty(canvas_item);
 	if (p_width > 1.001) {
 		Vector2 t = (p_from - p_to).tangent().normalized();
 		line->points[0] = p_from + t * p_width;
@@ -556,6 +750,7 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 
 	Item::CommandPolygon *pline = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_COND(!pline);
+	_mark_item_dirty(canvas_item);
 
 	PackedColorArray colors;
 	PackedVector2Array points;
@@ -686,6 +881,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 
 	Item::CommandPolygon *pline = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_COND(!pline);
+	_mark_item_dirty(canvas_item);
 
 	if (true || p_width <= 1) {
 #define TODO make thick lines possible
@@ -702,6 +898,7 @@ void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
+	_mark_item_dirty(canvas_item);
 	rect->modulate = p_color;
 	rect->rect = p_rect;
 }
@@ -712,6 +909,7 @@ void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 
 	Item::CommandPolygon *circle = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_COND(!circle);
+	_mark_item_dirty(canvas_item);
 
 	circle->primitive = RS::PRIMITIVE_TRIANGLES;
 
@@ -746,6 +944,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
+	_mark_item_dirty(canvas_item);
 	rect->modulate = p_modulate;
 	rect->rect = p_rect;
 	rect->flags = 0;
@@ -777,6 +976,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const R
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
+	_mark_item_dirty(canvas_item);
 	rect->modulate = p_modulate;
 	rect->rect = p_rect;
 
@@ -818,6 +1018,7 @@ void RendererCanvasCull::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_r
 
 	Item::CommandNinePatch *style = canvas_item->alloc_command<Item::CommandNinePatch>();
 	ERR_FAIL_COND(!style);
+	_mark_item_dirty(canvas_item);
 
 	style->texture = p_texture;
 
@@ -842,6 +1043,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 
 	Item::CommandPrimitive *prim = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_COND(!prim);
+	_mark_item_dirty(canvas_item);
 
 	for (int i = 0; i < p_points.size(); i++) {
 		prim->points[i] = p_points[i];
@@ -878,6 +1080,7 @@ void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2
 
 	Item::CommandPolygon *polygon = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_COND(!polygon);
+	_mark_item_dirty(canvas_item);
 	polygon->primitive = RS::PRIMITIVE_TRIANGLES;
 	polygon->texture = p_texture;
 	polygon->polygon.create(indices, p_points, p_colors, p_uvs);
@@ -898,6 +1101,7 @@ void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector
 
 	Item::CommandPolygon *polygon = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_COND(!polygon);
+	_mark_item_dirty(canvas_item);
 
 	polygon->texture = p_texture;
 
@@ -912,6 +1116,7 @@ void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transfo
 
 	Item::CommandTransform *tr = canvas_item->alloc_command<Item::CommandTransform>();
 	ERR_FAIL_COND(!tr);
+	_mark_item_dirty(canvas_item);
 	tr->xform = p_transform;
 }
 
@@ -921,6 +1126,7 @@ void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 
 	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
 	ERR_FAIL_COND(!m);
+	_mark_item_dirty(canvas_item);
 	m->mesh = p_mesh;
 
 	m->texture = p_texture;
@@ -935,6 +1141,7 @@ void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles,
 
 	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
 	ERR_FAIL_COND(!part);
+	_mark_item_dirty(canvas_item);
 	part->particles = p_particles;
 
 	part->texture = p_texture;
@@ -949,6 +1156,7 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 
 	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
 	ERR_FAIL_COND(!mm);
+	_mark_item_dirty(canvas_item);
 	mm->multimesh = p_mesh;
 
 	mm->texture = p_texture;
@@ -960,6 +1168,7 @@ void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 
 	Item::CommandClipIgnore *ci = canvas_item->alloc_command<Item::CommandClipIgnore>();
 	ERR_FAIL_COND(!ci);
+	_mark_item_dirty(canvas_item);
 	ci->ignore = p_ignore;
 }
 
@@ -970,6 +1179,7 @@ void RendererCanvasCull::canvas_item_set_sort_children_by_y(RID p_item, bool p_e
 	canvas_item->sort_y = p_enable;
 
 	_mark_ysort_dirty(canvas_item, canvas_item_owner);
+	_mark_child_index_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_set_z_index(RID p_item, int p_z) {
@@ -1010,6 +1220,8 @@ void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 		canvas_item->copy_back_buffer->rect = p_rect;
 		canvas_item->copy_back_buffer->full = p_rect == Rect2();
 	}
+
+	_mark_child_index_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_clear(RID p_item) {
@@ -1017,6 +1229,7 @@ void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->clear();
+	_mark_item_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_set_draw_index(RID p_item, int p_index) {
@@ -1071,6 +1284,8 @@ void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::Canva
 		canvas_item->canvas_group->blur_mipmaps = p_blur_mipmaps;
 		canvas_item->canvas_group->clear_margin = p_clear_margin;
 	}
+
+	_mark_item_dirty(canvas_item);
 }
 
 RID RendererCanvasCull::canvas_light_create() {
@@ -1465,6 +1680,10 @@ bool RendererCanvasCull::free(RID p_rid) {
 			} else if (canvas_item_owner.owns(canvas_item->parent)) {
 				Item *item_owner = canvas_item_owner.getornull(canvas_item->parent);
 				item_owner->child_items.erase(canvas_item);
+				if (item_owner->child_index) {
+					item_owner->child_index->rebuild = true;
+				}
+				_mark_child_index_dirty(item_owner);
 
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -31,6 +31,7 @@
 #ifndef RENDERING_SERVER_CANVAS_CULL_H
 #define RENDERING_SERVER_CANVAS_CULL_H
 
+#include "core/math/dynamic_bvh.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
 
@@ -55,6 +56,31 @@ public:
 
 		Vector<Item *> child_items;
 
+		//bounding volume tree over the leaf children, so items with many children only visit those in view
+		struct ChildIndex {
+			DynamicBVH bvh;
+			LocalVector<uint32_t> unindexed; //children that are always visited (not leaves, or with a rect that can change behind our back)
+			LocalVector<Item *> dirty;
+			bool rebuild = true;
+		};
+
+		//global transform, modulate and rect from the last cull, reused while neither the item nor its parent changed
+		Transform2D global_xform_cache;
+		Color global_modulate_cache;
+		Rect2 cull_rect_cache;
+		Transform2D parent_xform_cache;
+		Color parent_modulate_cache;
+		uint64_t parent_version_cache = 0;
+		uint64_t global_version = 0;
+		bool global_dirty = true;
+		bool global_snapped = false;
+		bool rect_volatile = true;
+
+		ChildIndex *child_index = nullptr;
+		DynamicBVH::ID child_index_id; //leaf in the parent child index
+		uint32_t child_index_pos = 0;
+		bool child_index_dirty = false;
+
 		Item() {
 			children_order_dirty = true;
 			E = nullptr;
@@ -70,6 +96,12 @@ public:
 			ysort_pos = Vector2();
 			ysort_index = 0;
 		}
+
+		~Item() {
+			if (child_index) {
+				memdelete(child_index);
+			}
+		}
 	};
 
 	struct ItemIndexSort {
@@ -152,13 +184,26 @@ public:
 	RID_PtrOwner<Item> canvas_item_owner;
 	RID_PtrOwner<RendererCanvasRender::Light> canvas_light_owner;
 
+	enum {
+		CHILD_INDEX_MIN_ITEMS = 64
+	};
+
 	bool disable_scale;
 	bool sdf_used = false;
 	bool snapping_2d_transforms_to_pixel = false;
 
 private:
 	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel);
-	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **z_list, RendererCanvasRender::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner);
+	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **z_list, RendererCanvasRender::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner, uint64_t p_parent_version);
+
+	static bool _is_rect_volatile(const Item *p_item);
+	static bool _is_child_indexable(const Item *p_item);
+	void _update_child_index(Item *p_canvas_item);
+	void _cull_child_index(Item *p_canvas_item, const Transform2D &p_xform, const Rect2 &p_clip_rect, LocalVector<Item *> &r_children);
+	void _mark_child_index_dirty(Item *p_item);
+	void _mark_item_dirty(Item *p_item);
+
+	uint64_t global_version_counter = 0;
 
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
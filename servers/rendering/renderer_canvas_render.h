@@ -594,6 +594,8 @@ public:
 
 	virtual void draw_window_margins(int *p_margins, RID *p_margin_textures) = 0;
 
+	virtual int get_render_info(RS::RenderInfo p_info) = 0;
+
 	virtual bool free(RID p_rid) = 0;
 	virtual void update() = 0;
 
@@ -390,6 +390,114 @@ void RendererCanvasRenderRD::_bind_canvas_texture(RD::DrawListID p_draw_list, RI
 	r_last_texture = p_texture;
 }
 
+void RendererCanvasRenderRD::_add_batch_rect(RD::DrawListID p_draw_list, RD::FramebufferFormatID p_framebuffer_format, const Item::CommandRect *p_rect, const float *p_world, const Color &p_modulate, RS::CanvasItemTextureFilter p_filter, RS::CanvasItemTextureRepeat p_repeat) {
+	State::RectBatch &batch = state.rect_batch;
+
+	RID texture = p_rect->texture.is_valid() ? p_rect->texture : default_canvas_texture;
+
+	if (batch.count && (batch.texture != texture || batch.filter != p_filter || batch.repeat != p_repeat)) {
+		_flush_rect_batch(p_draw_list, p_framebuffer_format);
+	}
+
+	if (batch.count == 0) {
+		batch.texture = texture;
+		batch.filter = p_filter;
+		batch.repeat = p_repeat;
+		batch.from = state.batch_rects_used;
+	}
+
+	State::BatchRect &br = state.batch_rects[state.batch_rects_used];
+	state.batch_rects_used++;
+	batch.count++;
+
+	for (int i = 0; i < 6; i++) {
+		br.world[i] = p_world[i];
+	}
+
+	Rect2 src_rect = Rect2(0, 0, 1, 1);
+	Rect2 dst_rect = Rect2(p_rect->rect.position, p_rect->rect.size);
+
+	if (dst_rect.size.width < 0) {
+		dst_rect.position.x += dst_rect.size.width;
+		dst_rect.size.width *= -1;
+	}
+	if (dst_rect.size.height < 0) {
+		dst_rect.position.y += dst_rect.size.height;
+		dst_rect.size.height *= -1;
+	}
+
+	br.flags = 0;
+	br.pad = 0;
+
+	if (p_rect->texture.is_valid()) {
+		if (p_rect->flags & CANVAS_RECT_REGION) {
+			//the texture size is only known once the batch is bound, the shader scales the region
+			src_rect = p_rect->source;
+			br.flags |= BATCH_RECT_FLAGS_REGION_IN_PIXELS;
+		}
+
+		if (p_rect->flags & CANVAS_RECT_FLIP_H) {
+			src_rect.size.x *= -1;
+		}
+
+		if (p_rect->flags & CANVAS_RECT_FLIP_V) {
+			src_rect.size.y *= -1;
+		}
+
+		if (p_rect->flags & CANVAS_RECT_TRANSPOSE) {
+			dst_rect.size.x *= -1; // Encoding in the dst_rect.z uniform
+		}
+	}
+
+	br.modulation[0] = p_rect->modulate.r * p_modulate.r;
+	br.modulation[1] = p_rect->modulate.g * p_modulate.g;
+	br.modulation[2] = p_rect->modulate.b * p_modulate.b;
+	br.modulation[3] = p_rect->modulate.a * p_modulate.a;
+
+	br.src_rect[0] = src_rect.position.x;
+	br.src_rect[1] = src_rect.position.y;
+	br.src_rect[2] = src_rect.size.width;
+	br.src_rect[3] = src_rect.size.height;
+
+	br.dst_rect[0] = dst_rect.position.x;
+	br.dst_rect[1] = dst_rect.position.y;
+	br.dst_rect[2] = dst_rect.size.width;
+	br.dst_rect[3] = dst_rect.size.height;
+}
+
+void RendererCanvasRenderRD::_flush_rect_batch(RD::DrawListID p_draw_list, RD::FramebufferFormatID p_framebuffer_format) {
+	State::RectBatch &batch = state.rect_batch;
+
+	if (batch.count == 0) {
+		return;
+	}
+
+	//not synced with draw, so the upload lands before any draw list of this frame
+	RD::get_singleton()->buffer_update(state.batch_rect_buffer, batch.from * sizeof(State::BatchRect), batch.count * sizeof(State::BatchRect), &state.batch_rects[batch.from]);
+
+	RID pipeline = shader.pipeline_variants.variants[PIPELINE_LIGHT_MODE_DISABLED][PIPELINE_VARIANT_QUAD].get_render_pipeline(RD::INVALID_ID, p_framebuffer_format);
+	RD::get_singleton()->draw_list_bind_render_pipeline(p_draw_list, pipeline);
+
+	PushConstant push_constant;
+	memset(&push_constant, 0, sizeof(PushConstant));
+
+	RID last_texture;
+	Size2 texpixel_size;
+	_bind_canvas_texture(p_draw_list, batch.texture, batch.filter, batch.repeat, last_texture, push_constant, texpixel_size);
+
+	push_constant.flags |= FLAGS_BATCHED_RECTS;
+	push_constant.batch_offset = batch.from;
+
+	RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
+	RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
+	RD::get_singleton()->draw_list_draw(p_draw_list, true, batch.count);
+
+	frame_stats.batches++;
+	frame_stats.batched_rects += batch.count;
+
+	batch.count = 0;
+}
+
 void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item *p_item, RD::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants) {
 	//create an empty push constant
 
@@ -420,8 +528,8 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 	push_constant.color_texture_pixel_size[0] = 0;
 	push_constant.color_texture_pixel_size[1] = 0;
 
-	push_constant.pad[0] = 0;
-	push_constant.pad[1] = 0;
+	push_constant.batch_offset = 0;
+	push_constant.pad = 0;
 
 	push_constant.lights[0] = 0;
 	push_constant.lights[1] = 0;
@@ -457,6 +565,9 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 
 	PipelineVariants *pipeline_variants = p_pipeline_variants;
 
+	//only the default shader without lights can take rects from the batch buffer
+	bool can_batch = pipeline_variants == &shader.pipeline_variants && light_mode == PIPELINE_LIGHT_MODE_DISABLED;
+
 	bool reclip = false;
 
 	RID last_texture;
@@ -466,10 +577,22 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 	while (c) {
 		push_constant.flags = base_flags | (push_constant.flags & (FLAGS_DEFAULT_NORMAL_MAP_USED | FLAGS_DEFAULT_SPECULAR_MAP_USED)); //reset on each command for sanity, keep canvastexture binding config
 
+		bool batch_command = can_batch && c->type == Item::Command::TYPE_RECT && !(static_cast<const Item::CommandRect *>(c)->flags & CANVAS_RECT_CLIP_UV) && state.batch_rects_used < MAX_BATCH_RECTS;
+
+		if (!batch_command && state.rect_batch.count) {
+			_flush_rect_batch(p_draw_list, p_framebuffer_format);
+			last_texture = RID(); //flushing binds the batch texture
+		}
+
 		switch (c->type) {
 			case Item::Command::TYPE_RECT: {
 				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
 
+				if (batch_command) {
+					_add_batch_rect(p_draw_list, p_framebuffer_format, rect, push_constant.world, base_color, current_filter, current_repeat);
+					break;
+				}
+
 				//bind pipeline
 				{
 					RID pipeline = pipeline_variants->variants[light_mode][PIPELINE_VARIANT_QUAD].get_render_pipeline(RD::INVALID_ID, p_framebuffer_format);
@@ -1116,6 +1239,14 @@ RID RendererCanvasRenderRD::_create_base_uniform_set(RID p_to_render_target, boo
 		uniforms.push_back(u);
 	}
 
+	{
+		RD::Uniform u;
+		u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+		u.binding = 10;
+		u.ids.push_back(state.batch_rect_buffer);
+		uniforms.push_back(u);
+	}
+
 	RID uniform_set = RD::get_singleton()->uniform_set_create(uniforms, shader.default_version_rd_shader, BASE_UNIFORM_SET);
 	if (p_backbuffer) {
 		storage->render_target_set_backbuffer_uniform_set(p_to_render_target, uniform_set);
@@ -1173,6 +1304,8 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 		Item *ci = items[i];
 
 		if (current_clip != ci->final_clip_owner) {
+			_flush_rect_batch(draw_list, fb_format);
+
 			current_clip = ci->final_clip_owner;
 
 			//setup clip
@@ -1191,6 +1324,8 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 		}
 
 		if (material != prev_material) {
+			_flush_rect_batch(draw_list, fb_format);
+
 			MaterialData *material_data = nullptr;
 			if (material.is_valid()) {
 				material_data = (MaterialData *)storage->material_get_data(material, RendererStorageRD::SHADER_TYPE_2D);
@@ -1211,10 +1346,13 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 		}
 
 		_render_item(draw_list, ci, fb_format, canvas_transform_inverse, current_clip, p_lights, pipeline_variants);
+		frame_stats.items++;
 
 		prev_material = material;
 	}
 
+	_flush_rect_batch(draw_list, fb_format);
+
 	RD::get_singleton()->draw_list_end();
 }
 
@@ -2362,6 +2500,24 @@ void RendererCanvasRenderRD::set_time(double p_time) {
 }
 
 void RendererCanvasRenderRD::update() {
+	//all canvas draw lists of the frame are recorded by now
+	state.batch_rects_used = 0;
+
+	last_frame_stats = frame_stats;
+	frame_stats = RenderStats();
+}
+
+int RendererCanvasRenderRD::get_render_info(RS::RenderInfo p_info) {
+	switch (p_info) {
+		case RS::INFO_2D_ITEMS_IN_FRAME:
+			return last_frame_stats.items;
+		case RS::INFO_2D_BATCHES_IN_FRAME:
+			return last_frame_stats.batches;
+		case RS::INFO_2D_BATCHED_RECTS_IN_FRAME:
+			return last_frame_stats.batched_rects;
+		default:
+			return 0;
+	}
 }
 
 RendererCanvasRenderRD::RendererCanvasRenderRD(RendererStorageRD *p_storage) {
@@ -2615,6 +2771,9 @@ RendererCanvasRenderRD::RendererCanvasRenderRD(RendererStorageRD *p_storage) {
 		state.canvas_state_buffer = RD::get_singleton()->uniform_buffer_create(sizeof(State::Buffer));
 		state.lights_uniform_buffer = RD::get_singleton()->uniform_buffer_create(sizeof(LightUniform) * state.max_lights_per_render);
 
+		state.batch_rects = memnew_arr(State::BatchRect, MAX_BATCH_RECTS);
+		state.batch_rect_buffer = RD::get_singleton()->storage_buffer_create(sizeof(State::BatchRect) * MAX_BATCH_RECTS);
+
 		RD::SamplerState shadow_sampler_state;
 		shadow_sampler_state.mag_filter = RD::SAMPLER_FILTER_LINEAR;
 		shadow_sampler_state.min_filter = RD::SAMPLER_FILTER_LINEAR;
@@ -2764,6 +2923,8 @@ RendererCanvasRenderRD::~RendererCanvasRenderRD() {
 
 		memdelete_arr(state.light_uniforms);
 		RD::get_singleton()->free(state.lights_uniform_buffer);
+		memdelete_arr(state.batch_rects);
+		RD::get_singleton()->free(state.batch_rect_buffer);
 		RD::get_singleton()->free(shader.default_skeleton_uniform_buffer);
 		RD::get_singleton()->free(shader.default_skeleton_texture_buffer);
 	}
@@ -79,6 +79,7 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 		FLAGS_NINEPACH_DRAW_CENTER = (1 << 12),
 		FLAGS_USING_PARTICLES = (1 << 13),
+		FLAGS_BATCHED_RECTS = (1 << 14),
 
 		FLAGS_USE_SKELETON = (1 << 15),
 		FLAGS_NINEPATCH_H_MODE_SHIFT = 16,
@@ -107,7 +108,12 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		MAX_RENDER_ITEMS = 256 * 1024,
 		MAX_LIGHT_TEXTURES = 1024,
 		MAX_LIGHTS_PER_ITEM = 16,
-		DEFAULT_MAX_LIGHTS_PER_RENDER = 256
+		DEFAULT_MAX_LIGHTS_PER_RENDER = 256,
+		MAX_BATCH_RECTS = 16384
+	};
+
+	enum {
+		BATCH_RECT_FLAGS_REGION_IN_PIXELS = 1
 	};
 
 	/****************/
@@ -375,6 +381,29 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 		RID default_transforms_uniform_set;
 
+		//rects from consecutive items that use the default shader and no lights are drawn instanced from this buffer
+		struct BatchRect {
+			float world[6];
+			uint32_t flags;
+			uint32_t pad;
+			float modulation[4];
+			float dst_rect[4];
+			float src_rect[4];
+		};
+
+		struct RectBatch {
+			RID texture;
+			RS::CanvasItemTextureFilter filter;
+			RS::CanvasItemTextureRepeat repeat;
+			uint32_t from = 0;
+			uint32_t count = 0;
+		};
+
+		BatchRect *batch_rects;
+		RID batch_rect_buffer;
+		uint32_t batch_rects_used = 0; //reset every frame, so regions already used by this frame's draw lists are never overwritten
+		RectBatch rect_batch;
+
 		uint32_t max_lights_per_render;
 		uint32_t max_lights_per_item;
 
@@ -393,7 +422,8 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 				float ninepatch_margins[4];
 				float dst_rect[4];
 				float src_rect[4];
-				float pad[2];
+				uint32_t batch_offset;
+				uint32_t pad;
 			};
 			//primitive
 			struct {
@@ -413,6 +443,17 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 	Item *items[MAX_RENDER_ITEMS];
 
+public:
+	struct RenderStats {
+		uint32_t items = 0;
+		uint32_t batches = 0;
+		uint32_t batched_rects = 0;
+	};
+
+private:
+	RenderStats frame_stats;
+	RenderStats last_frame_stats;
+
 	bool using_directional_lights = false;
 	RID default_canvas_texture;
 
@@ -425,6 +466,8 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 	RID _create_base_uniform_set(RID p_to_render_target, bool p_backbuffer);
 
 	inline void _bind_canvas_texture(RD::DrawListID p_draw_list, RID p_texture, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat, RID &r_last_texture, PushConstant &push_constant, Size2 &r_texpixel_size); //recursive, so regular inline used instead.
+	void _add_batch_rect(RD::DrawListID p_draw_list, RD::FramebufferFormatID p_framebuffer_format, const Item::CommandRect *p_rect, const float *p_world, const Color &p_modulate, RS::CanvasItemTextureFilter p_filter, RS::CanvasItemTextureRepeat p_repeat);
+	void _flush_rect_batch(RD::DrawListID p_draw_list, RD::FramebufferFormatID p_framebuffer_format);
 	void _render_item(RenderingDevice::DrawListID p_draw_list, const Item *p_item, RenderingDevice::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants);
 	void _render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, bool p_to_backbuffer = false);
 
@@ -462,6 +505,9 @@ public:
 
 	void set_time(double p_time);
 	void update();
+
+	int get_render_info(RS::RenderInfo p_info);
+
 	bool free(RID p_rid);
 	RendererCanvasRenderRD(RendererStorageRD *p_storage);
 	~RendererCanvasRenderRD();
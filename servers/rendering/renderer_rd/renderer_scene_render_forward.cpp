@@ -30,6 +30,8 @@
 
 #include "renderer_scene_render_forward.h"
 #include "core/config/project_settings.h"
+#include "core/templates/safe_refcount.h"
+#include "servers/rendering/renderer_rd/renderer_compositor_rd.h"
 #include "servers/rendering/rendering_device.h"
 #include "servers/rendering/rendering_server_default.h"
 
@@ -806,13 +808,104 @@ bool RendererSceneRenderForward::free(RID p_rid) {
 	return false;
 }
 
-void RendererSceneRenderForward::_fill_instances(RenderList::Element **p_elements, int p_element_count, bool p_for_depth, bool p_has_sdfgi, bool p_has_opaque_gi) {
-	uint32_t lightmap_captures_used = 0;
+void RendererSceneRenderForward::_update_instance_transforms(RenderList::Element **p_elements, int p_element_count) {
+	LocalVector<uint32_t> &dirty = scene_state.instance_transform_dirty;
+	dirty.clear();
+	bool upload_all = false;
 
 	for (int i = 0; i < p_element_count; i++) {
-		const RenderList::Element *e = p_elements[i];
+		InstanceBase *inst = p_elements[i]->instance;
+
+		if (inst->transform_data_index < 0) {
+			uint32_t slot;
+			if (scene_state.instance_transform_free_slots.size()) {
+				slot = scene_state.instance_transform_free_slots[scene_state.instance_transform_free_slots.size() - 1];
+				scene_state.instance_transform_free_slots.resize(scene_state.instance_transform_free_slots.size() - 1);
+			} else {
+				slot = scene_state.instance_transform_count++;
+			}
+
+			if (slot >= scene_state.instance_transform_capacity) {
+				uint32_t new_capacity = MAX(scene_state.instance_transform_capacity * 2, (uint32_t)INSTANCE_TRANSFORM_INITIAL_CAPACITY);
+				scene_state.instance_transforms = (InstanceTransformData *)memrealloc(scene_state.instance_transforms, sizeof(InstanceTransformData) * new_capacity);
+				scene_state.instance_transform_capacity = new_capacity;
+
+				if (scene_state.instance_transform_buffer.is_valid()) {
+					RD::get_singleton()->free(scene_state.instance_transform_buffer);
+				}
+				scene_state.instance_transform_buffer = RD::get_singleton()->storage_buffer_create(sizeof(InstanceTransformData) * new_capacity);
+				upload_all = true; // New buffer starts empty.
+			}
+
+			inst->transform_data_index = slot;
+			inst->transform_data_dirty = true;
+		}
+
+		if (inst->base_type == RS::INSTANCE_PARTICLES) {
+			inst->transform_data_dirty = true; // Local coords can be toggled without touching the transform.
+		}
+
+		if (!inst->transform_data_dirty) {
+			continue;
+		}
+
+		InstanceTransformData &td = scene_state.instance_transforms[inst->transform_data_index];
+		if (inst->base_type == RS::INSTANCE_PARTICLES && !storage->particles_is_using_local_coords(inst->base)) {
+			RendererStorageRD::store_transform(Transform(), td.transform);
+			RendererStorageRD::store_transform(Transform(), td.normal_transform);
+		} else {
+			RendererStorageRD::store_transform(inst->transform, td.transform);
+			RendererStorageRD::store_transform(Transform(inst->transform.basis.inverse().transposed()), td.normal_transform);
+		}
+
+		inst->transform_data_dirty = false;
+		dirty.push_back(inst->transform_data_index);
+	}
+
+	if (upload_all) {
+		RD::get_singleton()->buffer_update(scene_state.instance_transform_buffer, 0, sizeof(InstanceTransformData) * scene_state.instance_transform_count, scene_state.instance_transforms, true);
+		_update_render_base_uniform_set(); //buffer was replaced
+		return;
+	}
+
+	if (dirty.size() == 0) {
+		return;
+	}
+
+	dirty.sort();
+
+	// Merge nearby slots into ranges, uploading a few clean slots is cheaper than issuing many small updates.
+	uint32_t from = dirty[0];
+	uint32_t to = dirty[0];
+	for (uint32_t i = 1; i <= dirty.size(); i++) {
+		if (i < dirty.size() && dirty[i] - to <= INSTANCE_TRANSFORM_UPLOAD_GAP) {
+			to = dirty[i];
+			continue;
+		}
+
+		RD::get_singleton()->buffer_update(scene_state.instance_transform_buffer, sizeof(InstanceTransformData) * from, sizeof(InstanceTransformData) * (to - from + 1), &scene_state.instance_transforms[from], true);
+
+		if (i < dirty.size()) {
+			from = dirty[i];
+			to = dirty[i];
+		}
+	}
+}
+
+void RendererSceneRenderForward::instance_free_render_data(InstanceBase *p_instance) {
+	if (p_instance->transform_data_index >= 0) {
+		scene_state.instance_transform_free_slots.push_back(p_instance->transform_data_index);
+		p_instance->transform_data_index = -1;
+	}
+}
+
+void RendererSceneRenderForward::_fill_instances_chunk(uint32_t p_chunk, FillInstancesData *p_data) {
+	const uint32_t from = p_chunk * FILL_INSTANCES_CHUNK_SIZE;
+	const uint32_t to = MIN(from + FILL_INSTANCES_CHUNK_SIZE, p_data->element_count);
+
+	for (uint32_t i = from; i < to; i++) {
+		const RenderList::Element *e = p_data->elements[i];
 		InstanceData &id = scene_state.instances[i];
-		bool store_transform = true;
 		id.flags = 0;
 		id.mask = e->instance->layer_mask;
 		id.instance_uniforms_ofs = e->instance->instance_allocated_shader_parameters_offset >= 0 ? e->instance->instance_allocated_shader_parameters_offset : 0;
@@ -854,25 +947,15 @@ void RendererSceneRenderForward::_fill_instances(RenderList::Element **p_element
 
 			id.flags |= (stride << INSTANCE_DATA_FLAGS_MULTIMESH_STRIDE_SHIFT);
 
-			if (!storage->particles_is_using_local_coords(e->instance->base)) {
-				store_transform = false;
-			}
-
 		} else if (e->instance->base_type == RS::INSTANCE_MESH) {
 			if (e->instance->skeleton.is_valid()) {
 				id.flags |= INSTANCE_DATA_FLAG_SKELETON;
 			}
 		}
 
-		if (store_transform) {
-			RendererStorageRD::store_transform(e->instance->transform, id.transform);
-			RendererStorageRD::store_transform(Transform(e->instance->transform.basis.inverse().transposed()), id.normal_transform);
-		} else {
-			RendererStorageRD::store_transform(Transform(), id.transform);
-			RendererStorageRD::store_transform(Transform(), id.normal_transform);
-		}
+		id.transform_index = e->instance->transform_data_index;
 
-		if (p_for_depth) {
+		if (p_data->for_depth) {
 			id.gi_offset = 0xFFFFFFFF;
 			continue;
 		}
@@ -895,9 +978,10 @@ void RendererSceneRenderForward::_fill_instances(RenderList::Element **p_element
 				id.gi_offset = 0xFFFFFFFF;
 			}
 		} else if (!e->instance->lightmap_sh.empty()) {
-			if (lightmap_captures_used < scene_state.max_lightmap_captures) {
+			uint32_t capture_index = atomic_increment(&p_data->lightmap_captures_used) - 1;
+			if (capture_index < scene_state.max_lightmap_captures) {
 				const Color *src_capture = e->instance->lightmap_sh.ptr();
-				LightmapCaptureData &lcd = scene_state.lightmap_captures[lightmap_captures_used];
+				LightmapCaptureData &lcd = scene_state.lightmap_captures[capture_index];
 				for (int j = 0; j < 9; j++) {
 					lcd.sh[j * 4 + 0] = src_capture[j].r;
 					lcd.sh[j * 4 + 1] = src_capture[j].g;
@@ -905,12 +989,11 @@ void RendererSceneRenderForward::_fill_instances(RenderList::Element **p_element
 					lcd.sh[j * 4 + 3] = src_capture[j].a;
 				}
 				id.flags |= INSTANCE_DATA_FLAG_USE_LIGHTMAP_CAPTURE;
-				id.gi_offset = lightmap_captures_used;
-				lightmap_captures_used++;
+				id.gi_offset = capture_index;
 			}
 
 		} else {
-			if (p_has_opaque_gi) {
+			if (p_data->has_opaque_gi) {
 				id.flags |= INSTANCE_DATA_FLAG_USE_GI_BUFFERS;
 			}
 
@@ -937,7 +1020,7 @@ void RendererSceneRenderForward::_fill_instances(RenderList::Element **p_element
 					id.gi_offset |= 0xFFFF0000;
 				}
 			} else {
-				if (p_has_sdfgi && (e->instance->baked_light || e->instance->dynamic_gi)) {
+				if (p_data->has_sdfgi && (e->instance->baked_light || e->instance->dynamic_gi)) {
 					id.flags |= INSTANCE_DATA_FLAG_USE_SDFGI;
 				}
 				id.gi_offset = 0xFFFFFFFF;
@@ -945,6 +1028,29 @@ void RendererSceneRenderForward::_fill_instances(RenderList::Element **p_element
 		}
 	}
 
+}
+
+void RendererSceneRenderForward::_fill_instances(RenderList::Element **p_elements, int p_element_count, bool p_for_depth, bool p_has_sdfgi, bool p_has_opaque_gi) {
+	FillInstancesData data;
+	data.elements = p_elements;
+	data.element_count = p_element_count;
+	data.for_depth = p_for_depth;
+	data.has_sdfgi = p_has_sdfgi;
+	data.has_opaque_gi = p_has_opaque_gi;
+	data.lightmap_captures_used = 0;
+
+	_update_instance_transforms(p_elements, p_element_count);
+
+	// Every element writes only its own slot of the staging array, so chunks can be filled in any order.
+	uint32_t chunk_count = (p_element_count + FILL_INSTANCES_CHUNK_SIZE - 1) / FILL_INSTANCES_CHUNK_SIZE;
+	if (chunk_count > 1) {
+		RendererCompositorRD::thread_work_pool.do_work(chunk_count, this, &RendererSceneRenderForward::_fill_instances_chunk, &data);
+	} else if (chunk_count == 1) {
+		_fill_instances_chunk(0, &data);
+	}
+
+	uint32_t lightmap_captures_used = MIN(data.lightmap_captures_used, scene_state.max_lightmap_captures);
+
 	RD::get_singleton()->buffer_update(scene_state.instance_buffer, 0, sizeof(InstanceData) * p_element_count, scene_state.instances, true);
 	if (lightmap_captures_used) {
 		RD::get_singleton()->buffer_update(scene_state.lightmap_capture_buffer, 0, sizeof(LightmapCaptureData) * lightmap_captures_used, scene_state.lightmap_captures, true);
@@ -982,17 +1088,7 @@ void RendererSceneRenderForward::_render_list(RenderingDevice::DrawListID p_draw
 		RID xforms_uniform_set;
 
 		//find cull variant
-		ShaderData::CullVariant cull_variant;
-
-		if (p_pass_mode == PASS_MODE_DEPTH_MATERIAL || p_pass_mode == PASS_MODE_SDF || ((p_pass_mode == PASS_MODE_SHADOW || p_pass_mode == PASS_MODE_SHADOW_DP) && e->instance->cast_shadows == RS::SHADOW_CASTING_SETTING_DOUBLE_SIDED)) {
-			cull_variant = ShaderData::CULL_VARIANT_DOUBLE_SIDED;
-		} else {
-			bool mirror = e->instance->mirror;
-			if (p_reverse_cull) {
-				mirror = !mirror;
-			}
-			cull_variant = mirror ? ShaderData::CULL_VARIANT_REVERSED : ShaderData::CULL_VARIANT_NORMAL;
-		}
+		ShaderData::CullVariant cull_variant = _get_cull_variant(e, p_pass_mode, p_reverse_cull);
 
 		//find primitive and vertex format
 		RS::PrimitiveType primitive;
@@ -1085,6 +1181,7 @@ void RendererSceneRenderForward::_render_list(RenderingDevice::DrawListID p_draw
 		RD::VertexFormatID vertex_format = -1;
 		RID vertex_array_rd;
 		RID index_array_rd;
+		bool uses_lod = false;
 
 		if (mesh_surface) {
 			if (e->instance->mesh_instance.is_valid()) { //skeleton and blend shape
@@ -1093,7 +1190,27 @@ void RendererSceneRenderForward::_render_list(RenderingDevice::DrawListID p_draw
 				storage->mesh_surface_get_vertex_arrays_and_format(mesh_surface, pipeline->get_vertex_input_mask(), vertex_array_rd, vertex_format);
 			}
 
-			if (p_screen_lod_threshold > 0.0 && storage->mesh_surface_has_lod(mesh_surface)) {
+			if (p_screen_lod_threshold > 0.0 && storage->mesh_surface_has_lod(mesh_surface) && e->instance->lod_pass == get_scene_pass() && e->instance->base_type != RS::INSTANCE_PARTICLES) {
+				//LOD distance was computed by the cull stage for this scene pass, pick the LOD once and keep it for all passes
+				uses_lod = true;
+				InstanceBase *inst = e->instance;
+				if (inst->surface_lods.size() <= e->surface_index) {
+					inst->surface_lods.resize(e->surface_index + 1);
+				}
+
+				InstanceBase::SurfaceLOD &surface_lod = inst->surface_lods[e->surface_index];
+				if (surface_lod.pass != inst->lod_pass) {
+					Vector3 model_scale_vec = inst->transform.basis.get_scale_abs();
+					float model_scale = MAX(model_scale_vec.x, MAX(model_scale_vec.y, model_scale_vec.z));
+
+					surface_lod.lod = storage->mesh_surface_get_lod(mesh_surface, model_scale * inst->lod_bias, inst->lod_distance, p_screen_lod_threshold, surface_lod.lod, lod_hysteresis);
+					surface_lod.pass = inst->lod_pass;
+				}
+
+				index_array_rd = storage->mesh_surface_get_lod_index_array(mesh_surface, surface_lod.lod);
+
+			} else if (p_screen_lod_threshold > 0.0 && storage->mesh_surface_has_lod(mesh_surface)) {
+				uses_lod = true;
 				Vector3 support_min = e->instance->transformed_aabb.get_support(-p_lod_plane.normal);
 				Vector3 support_max = e->instance->transformed_aabb.get_support(p_lod_plane.normal);
 
@@ -1157,12 +1274,27 @@ void RendererSceneRenderForward::_render_list(RenderingDevice::DrawListID p_draw
 			prev_material = material;
 		}
 
+		// Following elements drawing the same surface with the same material and state are
+		// drawn with this one as a single instanced draw. Their instance data is already
+		// contiguous, the shader offsets the instance index by gl_InstanceIndex.
+		uint32_t instance_count = 1;
+		if (e->instance->base_type == RS::INSTANCE_MESH && !e->instance->mesh_instance.is_valid() && !e->instance->skeleton.is_valid() && !uses_lod) {
+			while (i + int(instance_count) < p_element_count) {
+				const RenderList::Element *n = p_elements[i + instance_count];
+				if (n->sort_key != e->sort_key || n->surface_index != e->surface_index || n->material != e->material || n->instance->base != e->instance->base || n->instance->base_type != RS::INSTANCE_MESH || n->instance->mesh_instance.is_valid() || n->instance->skeleton.is_valid() || _get_cull_variant(n, p_pass_mode, p_reverse_cull) != cull_variant) {
+					break;
+				}
+				instance_count++;
+			}
+		}
+
 		push_constant.index = i;
 		RD::get_singleton()->draw_list_set_push_constant(draw_list, &push_constant, sizeof(PushConstant));
 
 		switch (e->instance->base_type) {
 			case RS::INSTANCE_MESH: {
-				RD::get_singleton()->draw_list_draw(draw_list, index_array_rd.is_valid());
+				RD::get_singleton()->draw_list_draw(draw_list, index_array_rd.is_valid(), instance_count);
+				i += instance_count - 1;
 			} break;
 			case RS::INSTANCE_MULTIMESH: {
 				uint32_t instances = storage->multimesh_get_instances_to_draw(e->instance->base);
@@ -2339,6 +2471,14 @@ void RendererSceneRenderForward::_update_render_base_uniform_set() {
 			uniforms.push_back(u);
 		}
 
+		{
+			RD::Uniform u;
+			u.binding = 8;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.ids.push_back(scene_state.instance_transform_buffer);
+			uniforms.push_back(u);
+		}
+
 		{
 			RD::Uniform u;
 			u.binding = 5;
@@ -3003,6 +3143,7 @@ RendererSceneRenderForward::RendererSceneRenderForward(RendererStorageRD *p_stor
 
 	//render list
 	render_list.max_elements = GLOBAL_DEF_RST("rendering/limits/rendering/max_renderable_elements", (int)128000);
+	lod_hysteresis = GLOBAL_GET("rendering/quality/mesh_lod/lod_change_hysteresis");
 	render_list.init();
 	render_pass = 0;
 
@@ -3010,6 +3151,10 @@ RendererSceneRenderForward::RendererSceneRenderForward(RendererStorageRD *p_stor
 		scene_state.max_instances = render_list.max_elements;
 		scene_state.instances = memnew_arr(InstanceData, scene_state.max_instances);
 		scene_state.instance_buffer = RD::get_singleton()->storage_buffer_create(sizeof(InstanceData) * scene_state.max_instances);
+
+		scene_state.instance_transform_capacity = INSTANCE_TRANSFORM_INITIAL_CAPACITY;
+		scene_state.instance_transforms = (InstanceTransformData *)memalloc(sizeof(InstanceTransformData) * scene_state.instance_transform_capacity);
+		scene_state.instance_transform_buffer = RD::get_singleton()->storage_buffer_create(sizeof(InstanceTransformData) * scene_state.instance_transform_capacity);
 	}
 
 	scene_state.uniform_buffer = RD::get_singleton()->uniform_buffer_create(sizeof(SceneState::UBO));
@@ -3087,9 +3232,11 @@ RendererSceneRenderForward::~RendererSceneRenderForward() {
 	{
 		RD::get_singleton()->free(scene_state.uniform_buffer);
 		RD::get_singleton()->free(scene_state.instance_buffer);
+		RD::get_singleton()->free(scene_state.instance_transform_buffer);
 		RD::get_singleton()->free(scene_state.lightmap_buffer);
 		RD::get_singleton()->free(scene_state.lightmap_capture_buffer);
 		memdelete_arr(scene_state.instances);
+		memfree(scene_state.instance_transforms);
 		memdelete_arr(scene_state.lightmaps);
 		memdelete_arr(scene_state.lightmap_captures);
 	}
@@ -31,6 +31,8 @@
 #ifndef RENDERING_SERVER_SCENE_RENDER_FORWARD_H
 #define RENDERING_SERVER_SCENE_RENDER_FORWARD_H
 
+#include "core/templates/local_vector.h"
+#include "core/templates/radix_sort.h"
 #include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
 #include "servers/rendering/renderer_rd/renderer_scene_render_rd.h"
 #include "servers/rendering/renderer_rd/renderer_storage_rd.h"
@@ -293,13 +295,18 @@ class RendererSceneRenderForward : public RendererSceneRenderRD {
 	};
 
 	struct InstanceData {
-		float transform[16];
-		float normal_transform[16];
 		uint32_t flags;
 		uint32_t instance_uniforms_ofs; //instance_offset in instancing/skeleton buffer
 		uint32_t gi_offset; //GI information when using lightmapping (VCT or lightmap)
 		uint32_t mask;
 		float lightmap_uv_scale[4];
+		uint32_t transform_index; //slot in the persistent transform buffer
+		uint32_t pad[3];
+	};
+
+	struct InstanceTransformData {
+		float transform[16];
+		float normal_transform[16];
 	};
 
 	struct SceneState {
@@ -397,6 +404,15 @@ class RendererSceneRenderForward : public RendererSceneRenderRD {
 		InstanceData *instances;
 		uint32_t max_instances;
 
+		// Transforms persist between passes and frames, one slot per instance, and
+		// only the slots of instances that changed are uploaded again.
+		RID instance_transform_buffer;
+		InstanceTransformData *instance_transforms = nullptr;
+		uint32_t instance_transform_capacity = 0;
+		uint32_t instance_transform_count = 0;
+		LocalVector<uint32_t> instance_transform_free_slots;
+		LocalVector<uint32_t> instance_transform_dirty;
+
 		bool used_screen_texture = false;
 		bool used_normal_texture = false;
 		bool used_depth_texture = false;
@@ -443,59 +459,72 @@ class RendererSceneRenderForward : public RendererSceneRenderRD {
 			alpha_element_count = 0;
 		}
 
-		//should eventually be replaced by radix
+		// Elements are sorted through (key, element) pairs with a radix sort, so the
+		// element data is only read once per sort to build the keys. The pair buffers
+		// are allocated once and shared by the color, depth and shadow passes.
+
+		struct SortItem {
+			uint64_t key;
+			Element *element;
+		};
 
-		struct SortByKey {
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				return A->sort_key < B->sort_key;
+		struct SortItemKey {
+			_FORCE_INLINE_ uint64_t operator()(const SortItem &p_item) const {
+				return p_item.key;
 			}
 		};
 
-		void sort_by_key(bool p_alpha) {
-			SortArray<Element *, SortByKey> sorter;
+		SortItem *sort_items;
+		SortItem *sort_temp;
+
+		_FORCE_INLINE_ Element **_get_sort_range(bool p_alpha, int &r_count) {
 			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
+				r_count = alpha_element_count;
+				return &elements[max_elements - alpha_element_count];
 			} else {
-				sorter.sort(elements, element_count);
+				r_count = element_count;
+				return elements;
 			}
 		}
 
-		struct SortByDepth {
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				return A->instance->depth < B->instance->depth;
+		void _sort_items(Element **p_elements, int p_count, uint32_t p_key_bits) {
+			RadixSort<SortItem, SortItemKey> sorter;
+			sorter.sort(sort_items, sort_temp, p_count, p_key_bits);
+			for (int i = 0; i < p_count; i++) {
+				p_elements[i] = sort_items[i].element;
 			}
-		};
-
-		void sort_by_depth(bool p_alpha) { //used for shadows
+		}
 
-			SortArray<Element *, SortByDepth> sorter;
-			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
-			} else {
-				sorter.sort(elements, element_count);
+		void sort_by_key(bool p_alpha) {
+			int count;
+			Element **elems = _get_sort_range(p_alpha, count);
+			for (int i = 0; i < count; i++) {
+				sort_items[i].key = elems[i]->sort_key;
+				sort_items[i].element = elems[i];
 			}
+			_sort_items(elems, count, 64);
 		}
 
-		struct SortByReverseDepthAndPriority {
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				uint32_t layer_A = uint32_t(A->priority);
-				uint32_t layer_B = uint32_t(B->priority);
-				if (layer_A == layer_B) {
-					return A->instance->depth > B->instance->depth;
-				} else {
-					return layer_A < layer_B;
-				}
+		void sort_by_depth(bool p_alpha) { //used for shadows
+			int count;
+			Element **elems = _get_sort_range(p_alpha, count);
+			for (int i = 0; i < count; i++) {
+				sort_items[i].key = RadixSort<SortItem, SortItemKey>::float_key(elems[i]->instance->depth);
+				sort_items[i].element = elems[i];
 			}
-		};
+			_sort_items(elems, count, 32);
+		}
 
 		void sort_by_reverse_depth_and_priority(bool p_alpha) { //used for alpha
-
-			SortArray<Element *, SortByReverseDepthAndPriority> sorter;
-			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
-			} else {
-				sorter.sort(elements, element_count);
+			int count;
+			Element **elems = _get_sort_range(p_alpha, count);
+			for (int i = 0; i < count; i++) {
+				// Ascending priority, then descending depth.
+				uint32_t depth_key = ~RadixSort<SortItem, SortItemKey>::float_key(elems[i]->instance->depth);
+				sort_items[i].key = (uint64_t(elems[i]->priority) << 32) | depth_key;
+				sort_items[i].element = elems[i];
 			}
+			_sort_items(elems, count, 40);
 		}
 
 		_FORCE_INLINE_ Element *add_element() {
@@ -524,6 +553,8 @@ class RendererSceneRenderForward : public RendererSceneRenderRD {
 			for (int i = 0; i < max_elements; i++) {
 				elements[i] = &base_elements[i]; // assign elements
 			}
+			sort_items = memnew_arr(SortItem, max_elements);
+			sort_temp = memnew_arr(SortItem, max_elements);
 		}
 
 		RenderList() {
@@ -533,6 +564,8 @@ class RendererSceneRenderForward : public RendererSceneRenderRD {
 		~RenderList() {
 			memdelete_arr(elements);
 			memdelete_arr(base_elements);
+			memdelete_arr(sort_items);
+			memdelete_arr(sort_temp);
 		}
 	};
 
@@ -569,7 +602,38 @@ class RendererSceneRenderForward : public RendererSceneRenderRD {
 	void _setup_environment(RID p_environment, RID p_render_buffers, const CameraMatrix &p_cam_projection, const Transform &p_cam_transform, RID p_reflection_probe, bool p_no_fog, const Size2 &p_screen_pixel_size, RID p_shadow_atlas, bool p_flip_y, const Color &p_default_bg_color, float p_znear, float p_zfar, bool p_opaque_render_buffers = false, bool p_pancake_shadows = false);
 	void _setup_lightmaps(InstanceBase **p_lightmap_cull_result, int p_lightmap_cull_count, const Transform &p_cam_transform);
 
+	enum {
+		FILL_INSTANCES_CHUNK_SIZE = 256,
+	};
+
+	struct FillInstancesData {
+		RenderList::Element **elements;
+		uint32_t element_count;
+		bool for_depth;
+		bool has_sdfgi;
+		bool has_opaque_gi;
+		volatile uint32_t lightmap_captures_used;
+	};
+
+	enum {
+		INSTANCE_TRANSFORM_INITIAL_CAPACITY = 4096,
+		INSTANCE_TRANSFORM_UPLOAD_GAP = 32, // dirty slots closer than this are uploaded as one range
+	};
+
+	void _update_instance_transforms(RenderList::Element **p_elements, int p_element_count);
+	void _fill_instances_chunk(uint32_t p_chunk, FillInstancesData *p_data);
 	void _fill_instances(RenderList::Element **p_elements, int p_element_count, bool p_for_depth, bool p_has_sdfgi = false, bool p_has_opaque_gi = false);
+	_FORCE_INLINE_ static ShaderData::CullVariant _get_cull_variant(const RenderList::Element *p_element, PassMode p_pass_mode, bool p_reverse_cull) {
+		if (p_pass_mode == PASS_MODE_DEPTH_MATERIAL || p_pass_mode == PASS_MODE_SDF || ((p_pass_mode == PASS_MODE_SHADOW || p_pass_mode == PASS_MODE_SHADOW_DP) && p_element->instance->cast_shadows == RS::SHADOW_CASTING_SETTING_DOUBLE_SIDED)) {
+			return ShaderData::CULL_VARIANT_DOUBLE_SIDED;
+		}
+		bool mirror = p_element->instance->mirror;
+		if (p_reverse_cull) {
+			mirror = !mirror;
+		}
+		return mirror ? ShaderData::CULL_VARIANT_REVERSED : ShaderData::CULL_VARIANT_NORMAL;
+	}
+
 	void _render_list(RenderingDevice::DrawListID p_draw_list, RenderingDevice::FramebufferFormatID p_framebuffer_Format, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, bool p_no_gi, RID p_render_pass_uniform_set, bool p_force_wireframe = false, const Vector2 &p_uv_offset = Vector2(), const Plane &p_lod_plane = Plane(), float p_lod_distance_multiplier = 0.0, float p_screen_lod_threshold = 0.0);
 	_FORCE_INLINE_ void _add_geometry(InstanceBase *p_instance, uint32_t p_surface, RID p_material, PassMode p_pass_mode, uint32_t p_geometry_index, bool p_using_sdfgi = false);
 	_FORCE_INLINE_ void _add_geometry_with_material(InstanceBase *p_instance, uint32_t p_surface, MaterialData *p_material, RID p_material_rid, PassMode p_pass_mode, uint32_t p_geometry_index, bool p_using_sdfgi = false);
@@ -579,6 +643,7 @@ class RendererSceneRenderForward : public RendererSceneRenderRD {
 	Map<Size2i, RID> sdfgi_framebuffer_size_cache;
 
 	bool low_end = false;
+	float lod_hysteresis = 0.1;
 
 protected:
 	virtual void _render_scene(RID p_render_buffer, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_ortogonal, InstanceBase **p_cull_result, int p_cull_count, int p_directional_light_count, RID *p_gi_probe_cull_result, int p_gi_probe_cull_count, InstanceBase **p_lightmap_cull_result, int p_lightmap_cull_count, RID p_environment, RID p_camera_effects, RID p_shadow_atlas, RID p_reflection_atlas, RID p_reflection_probe, int p_reflection_probe_pass, const Color &p_default_bg_color, float p_lod_threshold);
@@ -592,6 +657,7 @@ public:
 	virtual void set_time(double p_time, double p_step);
 
 	virtual bool free(RID p_rid);
+	virtual void instance_free_render_data(InstanceBase *p_instance);
 
 	RendererSceneRenderForward(RendererStorageRD *p_storage);
 	~RendererSceneRenderForward();
@@ -1442,9 +1442,7 @@ public:
 		return s->index_array;
 	}
 
-	_FORCE_INLINE_ RID mesh_surface_get_index_array_with_lod(void *p_surface, float p_model_scale, float p_distance_threshold, float p_lod_threshold) const {
-		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
-
+	_FORCE_INLINE_ int32_t _mesh_surface_find_lod(const Mesh::Surface *s, float p_model_scale, float p_distance_threshold, float p_lod_threshold) const {
 		int32_t current_lod = -1;
 		for (uint32_t i = 0; i < s->lod_count; i++) {
 			float screen_size = s->lods[i].edge_length * p_model_scale / p_distance_threshold;
@@ -1453,13 +1451,43 @@ public:
 			}
 			current_lod = i;
 		}
-		if (current_lod == -1) {
+		return current_lod;
+	}
+
+	// Returns the LOD to use, -1 being the full mesh. When p_previous_lod is valid, switching
+	// needs the threshold to be crossed by p_hysteresis (a fraction of it) to avoid popping back
+	// and forth around the threshold.
+	_FORCE_INLINE_ int32_t mesh_surface_get_lod(void *p_surface, float p_model_scale, float p_distance_threshold, float p_lod_threshold, int32_t p_previous_lod = -2, float p_hysteresis = 0.0) const {
+		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
+
+		int32_t lod = _mesh_surface_find_lod(s, p_model_scale, p_distance_threshold, p_lod_threshold);
+		if (p_previous_lod < -1 || p_previous_lod >= int32_t(s->lod_count) || lod == p_previous_lod || p_hysteresis <= 0.0) {
+			return lod;
+		}
+
+		if (lod > p_previous_lod) {
+			//going coarser, must be clearly below the threshold
+			return MAX(p_previous_lod, _mesh_surface_find_lod(s, p_model_scale, p_distance_threshold, p_lod_threshold * (1.0 - p_hysteresis)));
+		} else {
+			//going finer, must be clearly above the threshold
+			return MIN(p_previous_lod, _mesh_surface_find_lod(s, p_model_scale, p_distance_threshold, p_lod_threshold * (1.0 + p_hysteresis)));
+		}
+	}
+
+	_FORCE_INLINE_ RID mesh_surface_get_lod_index_array(void *p_surface, int32_t p_lod) const {
+		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
+
+		if (p_lod < 0 || p_lod >= int32_t(s->lod_count)) {
 			return s->index_array;
 		} else {
-			return s->lods[current_lod].index_array;
+			return s->lods[p_lod].index_array;
 		}
 	}
 
+	_FORCE_INLINE_ RID mesh_surface_get_index_array_with_lod(void *p_surface, float p_model_scale, float p_distance_threshold, float p_lod_threshold) const {
+		return mesh_surface_get_lod_index_array(p_surface, mesh_surface_get_lod(p_surface, p_model_scale, p_distance_threshold, p_lod_threshold));
+	}
+
 	_FORCE_INLINE_ void mesh_surface_get_vertex_arrays_and_format(void *p_surface, uint32_t p_input_mask, RID &r_vertex_array_rd, RD::VertexFormatID &r_vertex_format) {
 		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
 
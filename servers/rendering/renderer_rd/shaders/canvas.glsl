@@ -77,15 +77,35 @@ void main() {
 	vec2 vertex_base_arr[4] = vec2[](vec2(0.0, 0.0), vec2(0.0, 1.0), vec2(1.0, 1.0), vec2(1.0, 0.0));
 	vec2 vertex_base = vertex_base_arr[gl_VertexIndex];
 
-	vec2 uv = draw_data.src_rect.xy + abs(draw_data.src_rect.zw) * ((draw_data.flags & FLAGS_TRANSPOSE_RECT) != 0 ? vertex_base.yx : vertex_base.xy);
+	vec4 src_rect = draw_data.src_rect;
+	vec4 dst_rect = draw_data.dst_rect;
 	vec4 color = draw_data.modulation;
-	vec2 vertex = draw_data.dst_rect.xy + abs(draw_data.dst_rect.zw) * mix(vertex_base, vec2(1.0, 1.0) - vertex_base, lessThan(draw_data.src_rect.zw, vec2(0.0, 0.0)));
+
+	if (bool(draw_data.flags & FLAGS_BATCHED_RECTS)) {
+		BatchRect batch_rect = batch_rects.data[draw_data.batch_offset + uint(gl_InstanceIndex)];
+		src_rect = batch_rect.src_rect;
+		dst_rect = batch_rect.dst_rect;
+		color = batch_rect.modulation;
+		if (bool(batch_rect.flags & BATCH_RECT_FLAGS_REGION_IN_PIXELS)) {
+			src_rect *= draw_data.color_texture_pixel_size.xyxy;
+		}
+	}
+
+	vec2 uv = src_rect.xy + abs(src_rect.zw) * ((draw_data.flags & FLAGS_TRANSPOSE_RECT) != 0 ? vertex_base.yx : vertex_base.xy);
+	vec2 vertex = dst_rect.xy + abs(dst_rect.zw) * mix(vertex_base, vec2(1.0, 1.0) - vertex_base, lessThan(src_rect.zw, vec2(0.0, 0.0)));
 	uvec4 bones = uvec4(0, 0, 0, 0);
 
 #endif
 
 	mat4 world_matrix = mat4(vec4(draw_data.world_x, 0.0, 0.0), vec4(draw_data.world_y, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(draw_data.world_ofs, 0.0, 1.0));
 
+#if !defined(USE_ATTRIBUTES) && !defined(USE_PRIMITIVE)
+	if (bool(draw_data.flags & FLAGS_BATCHED_RECTS)) {
+		BatchRect batch_rect = batch_rects.data[draw_data.batch_offset + uint(gl_InstanceIndex)];
+		world_matrix = mat4(vec4(batch_rect.world_x, 0.0, 0.0), vec4(batch_rect.world_y, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(batch_rect.world_ofs, 0.0, 1.0));
+	}
+#endif
+
 #if 0
 	if (draw_data.flags & FLAGS_INSTANCING_ENABLED) {
 		uint offset = draw_data.flags & FLAGS_INSTANCING_STRIDE_MASK;
@@ -107,13 +107,18 @@ layout(location = 8) out float dp_clip;
 
 void main() {
 	instance_index = draw_call.instance_index;
+	if (!bool(instances.data[instance_index].flags & INSTANCE_FLAGS_MULTIMESH)) {
+		//not a multimesh, instances are for multiple draw calls batched together
+		instance_index += gl_InstanceIndex;
+	}
 	vec4 instance_custom = vec4(0.0);
 #if defined(COLOR_USED)
 	color_interp = color_attrib;
 #endif
 
-	mat4 world_matrix = instances.data[instance_index].transform;
-	mat3 world_normal_matrix = mat3(instances.data[instance_index].normal_transform);
+	uint transform_index = instances.data[instance_index].transform_index;
+	mat4 world_matrix = instance_transforms.data[transform_index].transform;
+	mat3 world_normal_matrix = mat3(instance_transforms.data[transform_index].normal_transform);
 
 	if (bool(instances.data[instance_index].flags & INSTANCE_FLAGS_MULTIMESH)) {
 		//multimesh, instances are for it
@@ -144,10 +149,6 @@ void main() {
 		matrix = transpose(matrix);
 		world_matrix = world_matrix * matrix;
 		world_normal_matrix = world_normal_matrix * mat3(matrix);
-
-	} else {
-		//not a multimesh, instances are for multiple draw calls
-		instance_index += gl_InstanceIndex;
 	}
 
 	vec3 vertex = vertex_attrib;
@@ -355,8 +356,8 @@ layout(location = 8) in float dp_clip;
 
 //defines to keep compatibility with vertex
 
-#define world_matrix instances.data[instance_index].transform
-#define world_normal_matrix instances.data[instance_index].normal_transform
+#define world_matrix instance_transforms.data[instances.data[instance_index].transform_index].transform
+#define world_normal_matrix instance_transforms.data[instances.data[instance_index].transform_index].normal_transform
 #define projection_matrix scene_data.projection_matrix
 
 #if defined(ENABLE_SSS) && defined(ENABLE_TRANSMITTANCE)
@@ -136,13 +136,15 @@ scene_data;
 #define INSTANCE_FLAGS_SKELETON (1 << 19)
 
 struct InstanceData {
-	mat4 transform;
-	mat4 normal_transform;
 	uint flags;
 	uint instance_uniforms_ofs; //base offset in global buffer for instance variables
 	uint gi_offset; //GI information when using lightmapping (VCT or lightmap index)
 	uint layer_mask;
 	vec4 lightmap_uv_scale;
+	uint transform_index; //slot in instance_transforms, persists across frames
+	uint pad0;
+	uint pad1;
+	uint pad2;
 };
 
 layout(set = 0, binding = 4, std430) restrict readonly buffer Instances {
@@ -150,6 +152,16 @@ layout(set = 0, binding = 4, std430) restrict readonly buffer Instances {
 }
 instances;
 
+struct InstanceTransformData {
+	mat4 transform;
+	mat4 normal_transform;
+};
+
+layout(set = 0, binding = 8, std430) restrict readonly buffer InstanceTransforms {
+	InstanceTransformData data[];
+}
+instance_transforms;
+
 layout(set = 0, binding = 5, std430) restrict readonly buffer Lights {
 	LightData data[];
 }
@@ -48,6 +48,15 @@ public:
 	virtual void camera_set_use_vertical_aspect(RID p_camera, bool p_enable) = 0;
 	virtual bool is_camera(RID p_camera) const = 0;
 
+	virtual RID room_create() = 0;
+	virtual void room_set_scenario(RID p_room, RID p_scenario) = 0;
+	virtual void room_set_bounds(RID p_room, const Vector<Plane> &p_planes) = 0;
+
+	virtual RID portal_create() = 0;
+	virtual void portal_set_rooms(RID p_portal, RID p_room_a, RID p_room_b) = 0;
+	virtual void portal_set_points(RID p_portal, const Vector<Vector3> &p_points) = 0;
+	virtual void portal_set_enabled(RID p_portal, bool p_enabled) = 0;
+
 	virtual RID scenario_create() = 0;
 
 	virtual void scenario_set_debug(RID p_scenario, RS::ScenarioDebugMode p_debug_mode) = 0;
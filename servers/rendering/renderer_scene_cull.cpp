@@ -30,6 +30,7 @@
 
 #include "renderer_scene_cull.h"
 
+#include "core/config/project_settings.h"
 #include "core/os/os.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
@@ -106,6 +107,386 @@ bool RendererSceneCull::is_camera(RID p_camera) const {
 	return camera_owner.owns(p_camera);
 }
 
+/* ROOM & PORTAL API */
+
+RID RendererSceneCull::room_create() {
+	Room *room = memnew(Room);
+	RID rid = room_owner.make_rid(room);
+	room->self = rid;
+	return rid;
+}
+
+void RendererSceneCull::room_set_scenario(RID p_room, RID p_scenario) {
+	Room *room = room_owner.getornull(p_room);
+	ERR_FAIL_COND(!room);
+
+	if (room->scenario) {
+		_room_clear(room);
+		room->scenario->rooms.erase(room);
+		room->scenario = nullptr;
+	}
+
+	if (p_scenario.is_valid()) {
+		Scenario *scenario = scenario_owner.getornull(p_scenario);
+		ERR_FAIL_COND(!scenario);
+
+		room->scenario = scenario;
+		scenario->rooms.push_back(room);
+		_room_update_instances(room);
+	}
+}
+
+void RendererSceneCull::room_set_bounds(RID p_room, const Vector<Plane> &p_planes) {
+	Room *room = room_owner.getornull(p_room);
+	ERR_FAIL_COND(!room);
+
+	room->planes.clear();
+	for (int i = 0; i < p_planes.size(); i++) {
+		room->planes.push_back(p_planes[i]);
+	}
+
+	_room_update_instances(room);
+}
+
+RID RendererSceneCull::portal_create() {
+	Portal *portal = memnew(Portal);
+	RID rid = portal_owner.make_rid(portal);
+	portal->self = rid;
+	return rid;
+}
+
+void RendererSceneCull::portal_set_rooms(RID p_portal, RID p_room_a, RID p_room_b) {
+	Portal *portal = portal_owner.getornull(p_portal);
+	ERR_FAIL_COND(!portal);
+
+	Room *rooms[2] = { nullptr, nullptr };
+	if (p_room_a.is_valid()) {
+		rooms[0] = room_owner.getornull(p_room_a);
+		ERR_FAIL_COND(!rooms[0]);
+	}
+	if (p_room_b.is_valid()) {
+		rooms[1] = room_owner.getornull(p_room_b);
+		ERR_FAIL_COND(!rooms[1]);
+	}
+	ERR_FAIL_COND_MSG(rooms[0] && rooms[0] == rooms[1], "A portal can't connect a room to itself.");
+
+	for (int i = 0; i < 2; i++) {
+		if (portal->rooms[i]) {
+			portal->rooms[i]->portals.erase(portal);
+			_room_dirty_light_shadows(portal->rooms[i]);
+		}
+		portal->rooms[i] = rooms[i];
+		if (rooms[i]) {
+			rooms[i]->portals.push_back(portal);
+			_room_dirty_light_shadows(rooms[i]);
+		}
+	}
+}
+
+void RendererSceneCull::portal_set_points(RID p_portal, const Vector<Vector3> &p_points) {
+	Portal *portal = portal_owner.getornull(p_portal);
+	ERR_FAIL_COND(!portal);
+
+	portal->points.clear();
+	portal->aabb = AABB();
+	portal->plane = Plane();
+
+	Vector3 center;
+	Vector3 normal;
+	int point_count = p_points.size();
+
+	for (int i = 0; i < point_count; i++) {
+		const Vector3 &a = p_points[i];
+		const Vector3 &b = p_points[(i + 1) % point_count];
+
+		//newell's method, works for slightly non planar polygons too
+		normal.x += (a.y - b.y) * (a.z + b.z);
+		normal.y += (a.z - b.z) * (a.x + b.x);
+		normal.z += (a.x - b.x) * (a.y + b.y);
+		center += a;
+
+		portal->points.push_back(a);
+		if (i == 0) {
+			portal->aabb.position = a;
+		} else {
+			portal->aabb.expand_to(a);
+		}
+	}
+
+	if (point_count >= 3 && normal.length_squared() > CMP_EPSILON2) {
+		portal->plane = Plane(center / point_count, normal.normalized());
+	} else {
+		portal->points.clear(); //degenerate, never let anything through
+	}
+
+	for (int i = 0; i < 2; i++) {
+		if (portal->rooms[i]) {
+			_room_dirty_light_shadows(portal->rooms[i]);
+		}
+	}
+}
+
+void RendererSceneCull::portal_set_enabled(RID p_portal, bool p_enabled) {
+	Portal *portal = portal_owner.getornull(p_portal);
+	ERR_FAIL_COND(!portal);
+
+	if (portal->enabled == p_enabled) {
+		return;
+	}
+
+	portal->enabled = p_enabled;
+
+	for (int i = 0; i < 2; i++) {
+		if (portal->rooms[i]) {
+			_room_dirty_light_shadows(portal->rooms[i]);
+		}
+	}
+}
+
+void RendererSceneCull::_instance_update_rooms(Instance *p_instance) {
+	_instance_clear_rooms(p_instance);
+
+	if (!p_instance->scenario) {
+		return;
+	}
+
+	LocalVector<Room *> &rooms = p_instance->scenario->rooms;
+	for (uint32_t i = 0; i < rooms.size(); i++) {
+		Room *room = rooms[i];
+		if (room->planes.empty() || !_aabb_intersects_planes(p_instance->transformed_aabb, room->planes.ptr(), room->planes.size())) {
+			continue;
+		}
+
+		p_instance->rooms.push_back(room);
+		room->instances.push_back(p_instance);
+	}
+}
+
+void RendererSceneCull::_instance_clear_rooms(Instance *p_instance) {
+	for (uint32_t i = 0; i < p_instance->rooms.size(); i++) {
+		p_instance->rooms[i]->instances.erase(p_instance);
+	}
+	p_instance->rooms.clear();
+}
+
+void RendererSceneCull::_room_update_instances(Room *p_room) {
+	_room_clear(p_room);
+
+	if (!p_room->scenario || p_room->planes.empty()) {
+		return;
+	}
+
+	for (SelfList<Instance> *E = p_room->scenario->instances.first(); E; E = E->next()) {
+		Instance *instance = E->self();
+		if (instance->octree_id == 0) {
+			continue; //not placed yet, rooms are assigned when it is
+		}
+
+		if (_aabb_intersects_planes(instance->transformed_aabb, p_room->planes.ptr(), p_room->planes.size())) {
+			instance->rooms.push_back(p_room);
+			p_room->instances.push_back(instance);
+		}
+	}
+
+	_room_dirty_light_shadows(p_room);
+}
+
+void RendererSceneCull::_room_clear(Room *p_room) {
+	_room_dirty_light_shadows(p_room);
+
+	for (uint32_t i = 0; i < p_room->instances.size(); i++) {
+		p_room->instances[i]->rooms.erase(p_room);
+	}
+	p_room->instances.clear();
+}
+
+void RendererSceneCull::_room_dirty_light_shadows(Room *p_room) {
+	for (uint32_t i = 0; i < p_room->instances.size(); i++) {
+		Instance *instance = p_room->instances[i];
+		if (instance->base_type == RS::INSTANCE_LIGHT) {
+			static_cast<InstanceLightData *>(instance->base_data)->shadow_dirty = true;
+		}
+	}
+}
+
+bool RendererSceneCull::_light_find_rooms(Instance *p_light) {
+	room_light_pass++;
+
+	if (p_light->rooms.empty()) {
+		return false;
+	}
+
+	room_light_stack.clear();
+	for (uint32_t i = 0; i < p_light->rooms.size(); i++) {
+		p_light->rooms[i]->light_pass = room_light_pass;
+		room_light_stack.push_back(p_light->rooms[i]);
+	}
+
+	//flood through open portals within reach of the light
+	while (room_light_stack.size()) {
+		Room *room = room_light_stack[room_light_stack.size() - 1];
+		room_light_stack.resize(room_light_stack.size() - 1);
+
+		for (uint32_t i = 0; i < room->portals.size(); i++) {
+			Portal *portal = room->portals[i];
+			if (!portal->enabled || portal->points.empty() || !portal->aabb.intersects_inclusive(p_light->transformed_aabb)) {
+				continue;
+			}
+
+			Room *next = portal->rooms[0] == room ? portal->rooms[1] : portal->rooms[0];
+			if (!next || next->light_pass == room_light_pass || next->scenario != room->scenario) {
+				continue;
+			}
+
+			next->light_pass = room_light_pass;
+			room_light_stack.push_back(next);
+		}
+	}
+
+	return true;
+}
+
+RendererSceneCull::Room *RendererSceneCull::_find_camera_room(Scenario *p_scenario, const Vector3 &p_point) const {
+	for (uint32_t i = 0; i < p_scenario->rooms.size(); i++) {
+		Room *room = p_scenario->rooms[i];
+		if (room->planes.empty()) {
+			continue;
+		}
+
+		bool inside = true;
+		for (uint32_t j = 0; j < room->planes.size(); j++) {
+			if (room->planes[j].is_point_over(p_point)) {
+				inside = false;
+				break;
+			}
+		}
+
+		if (inside) {
+			return room;
+		}
+	}
+
+	return nullptr;
+}
+
+static void _clip_polygon_to_plane(LocalVector<Vector3> &r_polygon, LocalVector<Vector3> &r_temp, const Plane &p_plane) {
+	r_temp.clear();
+
+	uint32_t count = r_polygon.size();
+	for (uint32_t i = 0; i < count; i++) {
+		const Vector3 &a = r_polygon[i];
+		const Vector3 &b = r_polygon[(i + 1) % count];
+		real_t da = p_plane.distance_to(a);
+		real_t db = p_plane.distance_to(b);
+
+		if (da <= 0) {
+			r_temp.push_back(a);
+		}
+		if ((da <= 0) != (db <= 0)) {
+			r_temp.push_back(a + (b - a) * (da / (da - db)));
+		}
+	}
+
+	SWAP(r_polygon, r_temp);
+}
+
+void RendererSceneCull::_room_cull(Room *p_room, Portal *p_from, const Vector<Plane> &p_planes, const Vector<Plane> &p_cam_planes, const Vector3 &p_cam_pos, const Vector3 &p_cam_dir, bool p_cam_orthogonal, int p_depth) {
+	for (uint32_t i = 0; i < p_room->instances.size() && instance_cull_count < MAX_INSTANCE_CULL; i++) {
+		Instance *ins = p_room->instances[i];
+		if (ins->room_cull_pass == render_pass || !_aabb_intersects_planes(ins->transformed_aabb, p_planes.ptr(), p_planes.size())) {
+			continue;
+		}
+
+		ins->room_cull_pass = render_pass;
+		instance_cull_result[instance_cull_count++] = ins;
+	}
+
+	if (p_depth >= MAX_ROOM_CULL) {
+		return;
+	}
+
+	LocalVector<Vector3> polygon;
+	LocalVector<Vector3> temp;
+
+	for (uint32_t i = 0; i < p_room->portals.size(); i++) {
+		Portal *portal = p_room->portals[i];
+		if (portal == p_from || !portal->enabled || portal->points.size() < 3) {
+			continue;
+		}
+
+		Room *next = portal->rooms[0] == p_room ? portal->rooms[1] : portal->rooms[0];
+		if (next && next->scenario != p_room->scenario) {
+			continue;
+		}
+
+		//only the part of the portal that is still visible can be looked through
+		polygon = portal->points;
+		for (int j = 0; j < p_planes.size() && polygon.size() >= 3; j++) {
+			_clip_polygon_to_plane(polygon, temp, p_planes[j]);
+		}
+
+		if (polygon.size() < 3) {
+			continue;
+		}
+
+		Vector<Plane> planes;
+		Plane portal_plane = portal->plane;
+		real_t cam_distance = portal_plane.distance_to(p_cam_pos);
+
+		if (Math::abs(cam_distance) > CMP_EPSILON) {
+			planes = p_cam_planes;
+
+			//nothing between the camera and the portal is seen through it
+			if (cam_distance < 0) {
+				portal_plane = -portal_plane;
+			}
+			planes.push_back(portal_plane);
+
+			Vector3 center;
+			for (uint32_t j = 0; j < polygon.size(); j++) {
+				center += polygon[j];
+			}
+			center /= polygon.size();
+
+			for (uint32_t j = 0; j < polygon.size(); j++) {
+				const Vector3 &a = polygon[j];
+				const Vector3 &b = polygon[(j + 1) % polygon.size()];
+
+				Vector3 normal = p_cam_orthogonal ? (b - a).cross(p_cam_dir) : (a - p_cam_pos).cross(b - p_cam_pos);
+				if (normal.length_squared() < CMP_EPSILON2) {
+					continue;
+				}
+
+				Plane edge_plane(a, normal.normalized());
+				if (edge_plane.is_point_over(center)) {
+					edge_plane = -edge_plane;
+				}
+				planes.push_back(edge_plane);
+			}
+		} else {
+			//camera is standing on the portal, it can't narrow anything
+			planes = p_planes;
+		}
+
+		if (next) {
+			_room_cull(next, portal, planes, p_cam_planes, p_cam_pos, p_cam_dir, p_cam_orthogonal, p_depth + 1);
+		} else if (room_exterior_cull_count < MAX_EXTERIOR_PORTALS) {
+			room_exterior_cull_count++;
+
+			int cull_count = p_room->scenario->octree.cull_convex(planes, instance_exterior_cull_result, MAX_INSTANCE_CULL);
+			for (int j = 0; j < cull_count && instance_cull_count < MAX_INSTANCE_CULL; j++) {
+				Instance *ins = instance_exterior_cull_result[j];
+				if (!ins->rooms.empty() || ins->room_cull_pass == render_pass) {
+					continue;
+				}
+
+				ins->room_cull_pass = render_pass;
+				instance_cull_result[instance_cull_count++] = ins;
+			}
+		}
+	}
+}
+
 /* SCENARIO API */
 
 void *RendererSceneCull::_instance_pair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int) {
@@ -555,6 +936,7 @@ void RendererSceneCull::instance_set_scenario(RID p_instance, RID p_scenario) {
 
 	if (instance->scenario) {
 		instance->scenario->instances.remove(&instance->scenario_item);
+		_instance_clear_rooms(instance);
 
 		if (instance->octree_id) {
 			instance->scenario->octree.erase(instance->octree_id); //make dependencies generated by the octree go away
@@ -666,6 +1048,7 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform &
 
 #endif
 	instance->transform = p_transform;
+	instance->transform_data_dirty = true;
 	_instance_queue_update(instance, true);
 }
 
@@ -919,6 +1302,10 @@ void RendererSceneCull::instance_geometry_set_flag(RID p_instance, RS::InstanceF
 		case RS::INSTANCE_FLAG_DRAW_NEXT_FRAME_IF_VISIBLE: {
 			instance->redraw_if_visible = p_enabled;
 
+		} break;
+		case RS::INSTANCE_FLAG_OCCLUDER: {
+			instance->occluder = p_enabled;
+
 		} break;
 		default: {
 		}
@@ -1142,6 +1529,10 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		return;
 	}
 
+	if (!p_instance->scenario->rooms.empty()) {
+		_instance_update_rooms(p_instance);
+	}
+
 	if (p_instance->octree_id == 0) {
 		uint32_t base_type = 1 << p_instance->base_type;
 		uint32_t pairable_mask = 0;
@@ -1340,6 +1731,9 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 	bool animated_material_found = false;
 
+	//positional shadow casters are limited to the rooms this light reaches through open portals
+	bool use_rooms = RSG::storage->light_get_type(p_instance->base) != RS::LIGHT_DIRECTIONAL && _light_find_rooms(p_instance);
+
 	switch (RSG::storage->light_get_type(p_instance->base)) {
 		case RS::LIGHT_DIRECTIONAL: {
 			Plane camera_plane(p_cam_transform.get_origin(), -p_cam_transform.basis.get_axis(Vector3::AXIS_Z));
@@ -1741,7 +2135,7 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 					for (int j = 0; j < cull_count; j++) {
 						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
+						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || (use_rooms && !_instance_in_light_rooms(instance))) {
 							cull_count--;
 							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
 							j--;
@@ -1800,7 +2194,7 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					Plane near_plane(xform.origin, -xform.basis.get_axis(2));
 					for (int j = 0; j < cull_count; j++) {
 						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
+						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || (use_rooms && !_instance_in_light_rooms(instance))) {
 							cull_count--;
 							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
 							j--;
@@ -1841,7 +2235,7 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 			Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
 			for (int j = 0; j < cull_count; j++) {
 				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
+				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || (use_rooms && !_instance_in_light_rooms(instance))) {
 					cull_count--;
 					SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
 					j--;
@@ -2003,6 +2397,103 @@ void RendererSceneCull::render_camera(RID p_render_buffers, Ref<XRInterface> &p_
 	_render_scene(p_render_buffers, cam_transform, camera_matrix, false, environment, camera->effects, p_scenario, p_shadow_atlas, RID(), -1, p_screen_lod_threshold);
 };
 
+void RendererSceneCull::_update_instance_occluder(Instance *p_instance) {
+	InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
+
+	geom->occluder_vertices.clear();
+	geom->occluder_indices.clear();
+	geom->occluder_dirty = false;
+
+	if (p_instance->base_type != RS::INSTANCE_MESH || !p_instance->base.is_valid()) {
+		return;
+	}
+
+	int surface_count = RSG::storage->mesh_get_surface_count(p_instance->base);
+	for (int i = 0; i < surface_count; i++) {
+		RS::SurfaceData sd = RSG::storage->mesh_get_surface(p_instance->base, i);
+		if (sd.primitive != RS::PRIMITIVE_TRIANGLES) {
+			continue;
+		}
+
+		Array arrays = RS::get_singleton()->mesh_create_arrays_from_surface_data(sd);
+		if (arrays[RS::ARRAY_VERTEX].get_type() != Variant::PACKED_VECTOR3_ARRAY) {
+			continue;
+		}
+
+		PackedVector3Array vertices = arrays[RS::ARRAY_VERTEX];
+		PackedInt32Array indices = arrays[RS::ARRAY_INDEX];
+
+		uint32_t base_vertex = geom->occluder_vertices.size();
+		const Vector3 *r = vertices.ptr();
+		for (int j = 0; j < vertices.size(); j++) {
+			geom->occluder_vertices.push_back(r[j]);
+		}
+
+		if (indices.size()) {
+			const int32_t *ri = indices.ptr();
+			for (int j = 0; j < indices.size(); j++) {
+				geom->occluder_indices.push_back(base_vertex + ri[j]);
+			}
+		} else {
+			for (int j = 0; j < vertices.size(); j++) {
+				geom->occluder_indices.push_back(base_vertex + j);
+			}
+		}
+	}
+}
+
+void RendererSceneCull::_occlusion_cull(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, uint32_t p_visible_layers) {
+	bool has_occluders = false;
+
+	for (int i = 0; i < instance_cull_count; i++) {
+		Instance *ins = instance_cull_result[i];
+
+		//skinned meshes are not used, their triangles don't match the bind pose
+		if (!ins->occluder || !ins->visible || ins->base_type != RS::INSTANCE_MESH || ins->skeleton.is_valid() || (p_visible_layers & ins->layer_mask) == 0) {
+			continue;
+		}
+
+		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(ins->base_data);
+		if (geom->occluder_dirty) {
+			_update_instance_occluder(ins);
+		}
+
+		if (geom->occluder_indices.empty()) {
+			continue;
+		}
+
+		if (!has_occluders) {
+			occlusion_cull.begin(p_cam_transform, p_cam_projection);
+			has_occluders = true;
+		}
+
+		occlusion_cull.add_occluder(ins->transform, geom->occluder_vertices.ptr(), geom->occluder_vertices.size(), geom->occluder_indices.ptr(), geom->occluder_indices.size());
+	}
+
+	if (!has_occluders) {
+		return;
+	}
+
+	occlusion_cull.end();
+
+	if (!occlusion_cull.is_active()) {
+		return;
+	}
+
+	int count = 0;
+	for (int i = 0; i < instance_cull_count; i++) {
+		Instance *ins = instance_cull_result[i];
+
+		if (((1 << ins->base_type) & RS::INSTANCE_GEOMETRY_MASK) && !ins->occluder && occlusion_cull.is_occluded(ins->transformed_aabb)) {
+			continue;
+		}
+
+		instance_cull_result[count++] = ins;
+	}
+
+	instance_cull_count = count;
+}
+
 void RendererSceneCull::_prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_render_buffers, RID p_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, float p_screen_lod_threshold, bool p_using_shadows) {
 	// Note, in stereo rendering:
 	// - p_cam_transform will be a transform in the middle of our two eyes
@@ -2027,9 +2518,19 @@ void RendererSceneCull::_prepare_scene(const Transform p_cam_transform, const Ca
 
 	Plane near_plane(p_cam_transform.origin, -p_cam_transform.basis.get_axis(2).normalized());
 	float z_far = p_cam_projection.get_z_far();
+	float lod_distance_multiplier = p_cam_projection.get_lod_multiplier();
 
 	/* STEP 2 - CULL */
-	instance_cull_count = scenario->octree.cull_convex(planes, instance_cull_result, MAX_INSTANCE_CULL);
+	Room *camera_room = scenario->rooms.empty() ? nullptr : _find_camera_room(scenario, p_cam_transform.origin);
+
+	if (camera_room) {
+		//inside a room, only what can be seen through its portals is considered
+		instance_cull_count = 0;
+		room_exterior_cull_count = 0;
+		_room_cull(camera_room, nullptr, planes, planes, p_cam_transform.origin, -p_cam_transform.basis.get_axis(2).normalized(), p_cam_orthogonal, 0);
+	} else {
+		instance_cull_count = scenario->octree.cull_convex(planes, instance_cull_result, MAX_INSTANCE_CULL);
+	}
 	light_cull_count = 0;
 
 	reflection_probe_cull_count = 0;
@@ -2046,8 +2547,12 @@ void RendererSceneCull::_prepare_scene(const Transform p_cam_transform, const Ca
 	print_line("OTP: "+itos(p_scenario->octree.get_pair_count()));
 	*/
 
-	/* STEP 3 - PROCESS PORTALS, VALIDATE ROOMS */
-	//removed, will replace with culling
+	/* STEP 3 - OCCLUSION CULLING */
+
+	if (occlusion_culling_enabled) {
+		RENDER_TIMESTAMP("Occlusion Culling");
+		_occlusion_cull(p_cam_transform, p_cam_projection, camera_layer_mask);
+	}
 
 	/* STEP 4 - REMOVE FURTHER CULLED OBJECTS, ADD LIGHTS */
 	uint64_t frame_number = RSG::rasterizer->get_frame_number();
@@ -2206,6 +2711,27 @@ void RendererSceneCull::_prepare_scene(const Transform p_cam_transform, const Ca
 
 			ins->depth = near_plane.distance_to(ins->transform.origin);
 			ins->depth_layer = CLAMP(int(ins->depth * 16 / z_far), 0, 15);
+
+			{
+				//distance used for mesh LOD selection, in all passes rendered for this camera
+				Vector3 support_min = ins->transformed_aabb.get_support(-near_plane.normal);
+				Vector3 support_max = ins->transformed_aabb.get_support(near_plane.normal);
+				float distance_min = near_plane.distance_to(support_min);
+				float distance_max = near_plane.distance_to(support_max);
+
+				float distance = 0.0;
+				if (distance_min * distance_max < 0.0) {
+					//crossing plane
+					distance = 0.0;
+				} else if (distance_min >= 0.0) {
+					distance = distance_min;
+				} else if (distance_max <= 0.0) {
+					distance = -distance_max;
+				}
+
+				ins->lod_distance = distance * lod_distance_multiplier;
+				ins->lod_pass = render_pass;
+			}
 		}
 
 		if (!keep) {
@@ -2871,6 +3397,12 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
 			InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
 
+			//changing the base or adding/clearing mesh surfaces always requests an AABB update too,
+			//material and skeleton changes don't, so keep the cached occluder triangles for those
+			if (p_instance->update_aabb) {
+				geom->occluder_dirty = true;
+			}
+
 			bool can_cast_shadows = true;
 			bool is_animated = false;
 			Map<StringName, RendererSceneRender::InstanceBase::InstanceShaderParameter> isparams;
@@ -3076,12 +3608,34 @@ bool RendererSceneCull::free(RID p_rid) {
 		camera_owner.free(p_rid);
 		memdelete(camera);
 
+	} else if (room_owner.owns(p_rid)) {
+		Room *room = room_owner.getornull(p_rid);
+
+		room_set_scenario(p_rid, RID());
+		//detach the portals from both sides, leaving the other side linked would turn them into exterior portals
+		while (room->portals.size()) {
+			portal_set_rooms(room->portals[0]->self, RID(), RID());
+		}
+
+		room_owner.free(p_rid);
+		memdelete(room);
+
+	} else if (portal_owner.owns(p_rid)) {
+		Portal *portal = portal_owner.getornull(p_rid);
+
+		portal_set_rooms(p_rid, RID(), RID());
+		portal_owner.free(p_rid);
+		memdelete(portal);
+
 	} else if (scenario_owner.owns(p_rid)) {
 		Scenario *scenario = scenario_owner.getornull(p_rid);
 
 		while (scenario->instances.first()) {
 			instance_set_scenario(scenario->instances.first()->self()->self, RID());
 		}
+		while (scenario->rooms.size()) {
+			room_set_scenario(scenario->rooms[0]->self, RID());
+		}
 		scene_render->free(scenario->reflection_probe_shadow_atlas);
 		scene_render->free(scenario->reflection_atlas);
 		scenario_owner.free(p_rid);
@@ -3106,6 +3660,8 @@ bool RendererSceneCull::free(RID p_rid) {
 		}
 		update_dirty_instances(); //in case something changed this
 
+		scene_render->instance_free_render_data(instance);
+
 		instance_owner.free(p_rid);
 		memdelete(instance);
 	} else {
@@ -3130,6 +3686,8 @@ RendererSceneCull *RendererSceneCull::singleton = nullptr;
 RendererSceneCull::RendererSceneCull() {
 	render_pass = 1;
 	singleton = this;
+
+	occlusion_culling_enabled = GLOBAL_GET("rendering/occlusion_culling/enabled");
 }
 
 RendererSceneCull::~RendererSceneCull() {
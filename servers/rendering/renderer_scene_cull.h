@@ -42,6 +42,7 @@
 #include "core/templates/rid_owner.h"
 #include "core/templates/self_list.h"
 #include "servers/rendering/renderer_scene.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
 #include "servers/rendering/renderer_scene_render.h"
 #include "servers/xr/xr_interface.h"
 
@@ -112,6 +113,7 @@ public:
 	/* SCENARIO API */
 
 	struct Instance;
+	struct Room;
 
 	struct Scenario {
 		RS::ScenarioDebugMode debug;
@@ -130,6 +132,8 @@ public:
 
 		LocalVector<RID> dynamic_lights;
 
+		LocalVector<Room *> rooms;
+
 		Scenario() { debug = RS::SCENARIO_DEBUG_DISABLED; }
 	};
 
@@ -179,6 +183,11 @@ public:
 		float lod_end_hysteresis;
 		RID lod_instance;
 
+		bool occluder;
+
+		LocalVector<Room *> rooms; //rooms touched by the AABB, empty means exterior
+		uint64_t room_cull_pass;
+
 		Vector<Color> lightmap_target_sh; //target is used for incrementally changing the SH over time, this avoids pops in some corner cases and when going interior <-> exterior
 
 		uint64_t last_render_pass;
@@ -220,6 +229,10 @@ public:
 			lod_begin_hysteresis = 0;
 			lod_end_hysteresis = 0;
 
+			occluder = false;
+
+			room_cull_pass = 0;
+
 			last_render_pass = 0;
 			last_frame_pass = 0;
 			version = 1;
@@ -241,6 +254,81 @@ public:
 	SelfList<Instance>::List _instance_update_list;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_dependencies = false);
 
+	/* ROOM & PORTAL API */
+
+	struct Portal;
+
+	struct Room {
+		RID self;
+		Scenario *scenario = nullptr;
+		LocalVector<Plane> planes; //convex volume, normals pointing out
+		LocalVector<Portal *> portals;
+		LocalVector<Instance *> instances;
+		uint64_t light_pass = 0;
+	};
+
+	struct Portal {
+		RID self;
+		Room *rooms[2] = { nullptr, nullptr }; //a null room is the exterior
+		LocalVector<Vector3> points;
+		Plane plane;
+		AABB aabb;
+		bool enabled = true;
+	};
+
+	mutable RID_PtrOwner<Room> room_owner;
+	mutable RID_PtrOwner<Portal> portal_owner;
+
+	uint32_t room_exterior_cull_count = 0;
+	uint64_t room_light_pass = 0;
+	LocalVector<Room *> room_light_stack;
+
+	virtual RID room_create();
+	virtual void room_set_scenario(RID p_room, RID p_scenario);
+	virtual void room_set_bounds(RID p_room, const Vector<Plane> &p_planes);
+
+	virtual RID portal_create();
+	virtual void portal_set_rooms(RID p_portal, RID p_room_a, RID p_room_b);
+	virtual void portal_set_points(RID p_portal, const Vector<Vector3> &p_points);
+	virtual void portal_set_enabled(RID p_portal, bool p_enabled);
+
+	static _FORCE_INLINE_ bool _aabb_intersects_planes(const AABB &p_aabb, const Plane *p_planes, int p_plane_count) {
+		Vector3 half_extents = p_aabb.size * 0.5;
+		Vector3 center = p_aabb.position + half_extents;
+
+		for (int i = 0; i < p_plane_count; i++) {
+			const Plane &p = p_planes[i];
+			float radius = Math::abs(p.normal.x * half_extents.x) + Math::abs(p.normal.y * half_extents.y) + Math::abs(p.normal.z * half_extents.z);
+			if (p.distance_to(center) > radius) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Casters outside every room are always kept, the others need a room reached by the light.
+	_FORCE_INLINE_ bool _instance_in_light_rooms(const Instance *p_instance) const {
+		if (p_instance->rooms.empty()) {
+			return true;
+		}
+
+		for (uint32_t i = 0; i < p_instance->rooms.size(); i++) {
+			if (p_instance->rooms[i]->light_pass == room_light_pass) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void _instance_update_rooms(Instance *p_instance);
+	void _instance_clear_rooms(Instance *p_instance);
+	void _room_update_instances(Room *p_room);
+	void _room_clear(Room *p_room);
+	void _room_dirty_light_shadows(Room *p_room);
+	bool _light_find_rooms(Instance *p_light);
+	Room *_find_camera_room(Scenario *p_scenario, const Vector3 &p_point) const;
+	void _room_cull(Room *p_room, Portal *p_from, const Vector<Plane> &p_planes, const Vector<Plane> &p_cam_planes, const Vector3 &p_cam_pos, const Vector3 &p_cam_dir, bool p_cam_orthogonal, int p_depth);
+
 	struct InstanceGeometryData : public InstanceBaseData {
 		List<Instance *> lighting;
 		bool lighting_dirty;
@@ -258,6 +346,11 @@ public:
 
 		List<Instance *> lightmap_captures;
 
+		//triangles used when the instance is an occluder, in local space
+		LocalVector<Vector3> occluder_vertices;
+		LocalVector<uint32_t> occluder_indices;
+		bool occluder_dirty;
+
 		InstanceGeometryData() {
 			lighting_dirty = false;
 			reflection_dirty = true;
@@ -265,6 +358,7 @@ public:
 			material_is_animated = true;
 			gi_probes_dirty = true;
 			decal_dirty = true;
+			occluder_dirty = true;
 		}
 	};
 
@@ -400,6 +494,7 @@ public:
 	int instance_cull_count;
 	Instance *instance_cull_result[MAX_INSTANCE_CULL];
 	Instance *instance_shadow_cull_result[MAX_INSTANCE_CULL]; //used for generating shadowmaps
+	Instance *instance_exterior_cull_result[MAX_INSTANCE_CULL]; //used for culling outside through exterior portals
 	Instance *light_cull_result[MAX_LIGHTS_CULLED];
 	RID sdfgi_light_cull_result[MAX_LIGHTS_CULLED];
 	RID light_instance_cull_result[MAX_LIGHTS_CULLED];
@@ -415,6 +510,9 @@ public:
 	Instance *lightmap_cull_result[MAX_LIGHTS_CULLED];
 	int lightmap_cull_count;
 
+	RendererSceneOcclusionCull occlusion_cull;
+	bool occlusion_culling_enabled = true;
+
 	RID_PtrOwner<Instance> instance_owner;
 
 	virtual RID instance_create();
@@ -460,6 +558,8 @@ public:
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance);
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
+	void _update_instance_occluder(Instance *p_instance);
+	void _occlusion_cull(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, uint32_t p_visible_layers);
 
 	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_scren_lod_threshold);
 
@@ -0,0 +1,269 @@
+/*************************************************************************/
+/*  renderer_scene_occlusion_cull.cpp                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "renderer_scene_occlusion_cull.h"
+
+void RendererSceneOcclusionCull::_rasterize_triangle(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c) {
+	Vector3 a = p_a;
+	Vector3 b = p_b;
+	Vector3 c = p_c;
+
+	float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+	if (Math::absf(area) < CMP_EPSILON) {
+		return;
+	}
+	if (area < 0) {
+		//occluders are rasterized two-sided, so just fix the winding
+		SWAP(b, c);
+		area = -area;
+	}
+
+	Mip &mip = mips[0];
+
+	int min_x = MAX(0, int(Math::floor(MIN(a.x, MIN(b.x, c.x)))));
+	int max_x = MIN(int(mip.width) - 1, int(Math::floor(MAX(a.x, MAX(b.x, c.x)))));
+	int min_y = MAX(0, int(Math::floor(MIN(a.y, MIN(b.y, c.y)))));
+	int max_y = MIN(int(mip.height) - 1, int(Math::floor(MAX(a.y, MAX(b.y, c.y)))));
+
+	if (min_x > max_x || min_y > max_y) {
+		return;
+	}
+
+	triangles_rasterized++;
+
+	// Edge functions and depth are linear in screen space, so step them per pixel.
+	float inv_area = 1.0 / area;
+
+	float e0_dx = -(c.y - b.y);
+	float e0_dy = c.x - b.x;
+	float e1_dx = -(a.y - c.y);
+	float e1_dy = a.x - c.x;
+	float e2_dx = -(b.y - a.y);
+	float e2_dy = b.x - a.x;
+
+	float z_dx = (e0_dx * a.z + e1_dx * b.z + e2_dx * c.z) * inv_area;
+
+	float px = min_x + 0.5;
+	float py = min_y + 0.5;
+
+	float e0_row = (c.x - b.x) * (py - b.y) - (c.y - b.y) * (px - b.x);
+	float e1_row = (a.x - c.x) * (py - c.y) - (a.y - c.y) * (px - c.x);
+	float e2_row = (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+
+	for (int y = min_y; y <= max_y; y++) {
+		float e0 = e0_row;
+		float e1 = e1_row;
+		float e2 = e2_row;
+		float z = (e0 * a.z + e1 * b.z + e2 * c.z) * inv_area;
+
+		float *row = &mip.depth[y * mip.width];
+
+		for (int x = min_x; x <= max_x; x++) {
+			if (e0 >= 0 && e1 >= 0 && e2 >= 0 && z < row[x]) {
+				row[x] = z;
+			}
+			e0 += e0_dx;
+			e1 += e1_dx;
+			e2 += e2_dx;
+			z += z_dx;
+		}
+
+		e0_row += e0_dy;
+		e1_row += e1_dy;
+		e2_row += e2_dy;
+	}
+}
+
+void RendererSceneOcclusionCull::begin(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection) {
+	view_projection = p_cam_projection * CameraMatrix(p_cam_transform.affine_inverse());
+
+	float *depth = mips[0].depth.ptr();
+	uint32_t size = mips[0].depth.size();
+	for (uint32_t i = 0; i < size; i++) {
+		depth[i] = 1.0;
+	}
+
+	triangles_rasterized = 0;
+	active = false;
+}
+
+void RendererSceneOcclusionCull::add_occluder(const Transform &p_xform, const Vector3 *p_vertices, uint32_t p_vertex_count, const uint32_t *p_indices, uint32_t p_index_count) {
+	CameraMatrix mvp = view_projection * CameraMatrix(p_xform);
+
+	screen_vertices.resize(p_vertex_count);
+	screen_vertex_valid.resize(p_vertex_count);
+
+	float half_width = mips[0].width * 0.5;
+	float half_height = mips[0].height * 0.5;
+
+	for (uint32_t i = 0; i < p_vertex_count; i++) {
+		Plane clip = mvp.xform4(Plane(p_vertices[i], 1.0));
+
+		// Vertices behind the near plane are not drawn on screen, so they can't hide anything.
+		if (clip.d <= CMP_EPSILON || clip.normal.z < -clip.d) {
+			screen_vertex_valid[i] = 0;
+			continue;
+		}
+
+		float inv_w = 1.0 / clip.d;
+		screen_vertices[i] = Vector3((clip.normal.x * inv_w + 1.0) * half_width, (clip.normal.y * inv_w + 1.0) * half_height, clip.normal.z * inv_w);
+		screen_vertex_valid[i] = 1;
+	}
+
+	for (uint32_t i = 0; i + 2 < p_index_count; i += 3) {
+		uint32_t i0 = p_indices[i + 0];
+		uint32_t i1 = p_indices[i + 1];
+		uint32_t i2 = p_indices[i + 2];
+
+		if (i0 >= p_vertex_count || i1 >= p_vertex_count || i2 >= p_vertex_count) {
+			continue;
+		}
+
+		// Clipping is skipped, a triangle crossing the near plane is simply left out.
+		if (!screen_vertex_valid[i0] || !screen_vertex_valid[i1] || !screen_vertex_valid[i2]) {
+			continue;
+		}
+
+		_rasterize_triangle(screen_vertices[i0], screen_vertices[i1], screen_vertices[i2]);
+	}
+}
+
+void RendererSceneOcclusionCull::end() {
+	if (triangles_rasterized == 0) {
+		active = false;
+		return;
+	}
+
+	for (uint32_t i = 1; i < mip_count; i++) {
+		const Mip &src = mips[i - 1];
+		Mip &dst = mips[i];
+
+		for (uint32_t y = 0; y < dst.height; y++) {
+			uint32_t sy0 = y * 2;
+			uint32_t sy1 = MIN(sy0 + 1, src.height - 1);
+
+			for (uint32_t x = 0; x < dst.width; x++) {
+				uint32_t sx0 = x * 2;
+				uint32_t sx1 = MIN(sx0 + 1, src.width - 1);
+
+				float d = MAX(MAX(src.depth[sy0 * src.width + sx0], src.depth[sy0 * src.width + sx1]), MAX(src.depth[sy1 * src.width + sx0], src.depth[sy1 * src.width + sx1]));
+				dst.depth[y * dst.width + x] = d;
+			}
+		}
+	}
+
+	active = true;
+}
+
+bool RendererSceneOcclusionCull::is_occluded(const AABB &p_aabb) const {
+	if (!active) {
+		return false;
+	}
+
+	float min_x = 1e20;
+	float max_x = -1e20;
+	float min_y = 1e20;
+	float max_y = -1e20;
+	float min_z = 1e20;
+
+	for (int i = 0; i < 8; i++) {
+		Vector3 corner = p_aabb.get_endpoint(i);
+		Plane clip = view_projection.xform4(Plane(corner, 1.0));
+
+		if (clip.d <= CMP_EPSILON || clip.normal.z < -clip.d) {
+			//crosses the near plane, can't be hidden
+			return false;
+		}
+
+		float inv_w = 1.0 / clip.d;
+		float x = clip.normal.x * inv_w;
+		float y = clip.normal.y * inv_w;
+		float z = clip.normal.z * inv_w;
+
+		min_x = MIN(min_x, x);
+		max_x = MAX(max_x, x);
+		min_y = MIN(min_y, y);
+		max_y = MAX(max_y, y);
+		min_z = MIN(min_z, z);
+	}
+
+	const Mip &base = mips[0];
+
+	int x0 = int(Math::floor((min_x + 1.0) * 0.5 * base.width));
+	int x1 = int(Math::floor((max_x + 1.0) * 0.5 * base.width));
+	int y0 = int(Math::floor((min_y + 1.0) * 0.5 * base.height));
+	int y1 = int(Math::floor((max_y + 1.0) * 0.5 * base.height));
+
+	if (x1 < 0 || y1 < 0 || x0 >= int(base.width) || y0 >= int(base.height)) {
+		return false;
+	}
+
+	x0 = MAX(x0, 0);
+	y0 = MAX(y0, 0);
+	x1 = MIN(x1, int(base.width) - 1);
+	y1 = MIN(y1, int(base.height) - 1);
+
+	// Pick the level where the rectangle spans at most a couple of texels.
+	uint32_t span = MAX(x1 - x0, y1 - y0);
+	uint32_t level = 0;
+	while (level + 1 < mip_count && (span >> level) > 1) {
+		level++;
+	}
+
+	const Mip &mip = mips[level];
+
+	for (int y = y0 >> level; y <= (y1 >> level); y++) {
+		for (int x = x0 >> level; x <= (x1 >> level); x++) {
+			if (mip.depth[y * mip.width + x] >= min_z) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+RendererSceneOcclusionCull::RendererSceneOcclusionCull() {
+	uint32_t w = BUFFER_WIDTH;
+	uint32_t h = BUFFER_HEIGHT;
+
+	for (uint32_t i = 0; i < MAX_MIPS; i++) {
+		mips[i].width = w;
+		mips[i].height = h;
+		mips[i].depth.resize(w * h);
+		mip_count++;
+
+		if (w == 1 && h == 1) {
+			break;
+		}
+		w = MAX(1u, w >> 1);
+		h = MAX(1u, h >> 1);
+	}
+}
@@ -0,0 +1,84 @@
+/*************************************************************************/
+/*  renderer_scene_occlusion_cull.h                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef RENDERER_SCENE_OCCLUSION_CULL_H
+#define RENDERER_SCENE_OCCLUSION_CULL_H
+
+#include "core/math/aabb.h"
+#include "core/math/camera_matrix.h"
+#include "core/math/transform.h"
+#include "core/templates/local_vector.h"
+
+// Small CPU depth buffer used to reject instances hidden behind occluder meshes.
+// Occluders are rasterized once per camera pass, then a max-depth pyramid is
+// built so an AABB can be tested against a handful of texels at the mip level
+// matching its screen size.
+
+class RendererSceneOcclusionCull {
+public:
+	enum {
+		BUFFER_WIDTH = 256,
+		BUFFER_HEIGHT = 128,
+		MAX_MIPS = 9,
+	};
+
+private:
+	struct Mip {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		LocalVector<float> depth;
+	};
+
+	Mip mips[MAX_MIPS];
+	uint32_t mip_count = 0;
+
+	CameraMatrix view_projection;
+	bool active = false;
+	uint32_t triangles_rasterized = 0;
+
+	LocalVector<Vector3> screen_vertices;
+	LocalVector<uint8_t> screen_vertex_valid;
+
+	void _rasterize_triangle(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c);
+
+public:
+	void begin(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection);
+	void add_occluder(const Transform &p_xform, const Vector3 *p_vertices, uint32_t p_vertex_count, const uint32_t *p_indices, uint32_t p_index_count);
+	void end();
+
+	bool is_occluded(const AABB &p_aabb) const;
+
+	_FORCE_INLINE_ bool is_active() const { return active; }
+	_FORCE_INLINE_ uint32_t get_triangles_rasterized() const { return triangles_rasterized; }
+
+	RendererSceneOcclusionCull();
+};
+
+#endif // RENDERER_SCENE_OCCLUSION_CULL_H
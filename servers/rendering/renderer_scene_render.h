@@ -32,6 +32,7 @@
 #define RENDERINGSERVERSCENERENDER_H
 
 #include "core/math/camera_matrix.h"
+#include "core/templates/local_vector.h"
 #include "servers/rendering/renderer_storage.h"
 
 class RendererSceneRender {
@@ -183,6 +184,20 @@ public:
 		bool instance_allocated_shader_parameters = false;
 		int32_t instance_allocated_shader_parameters_offset = -1;
 
+		int32_t transform_data_index = -1; //slot used by the renderer to keep the transform on the GPU
+		bool transform_data_dirty = true;
+
+		//mesh LOD distance, computed by the cull stage once per scene pass and shared by all its render passes
+		float lod_distance = 0.0;
+		uint64_t lod_pass = 0;
+
+		struct SurfaceLOD {
+			int32_t lod = -2; //-1 is the full mesh, -2 means not selected yet
+			uint64_t pass = 0;
+		};
+
+		LocalVector<SurfaceLOD> surface_lods; //last LOD selected per surface, used for hysteresis
+
 		InstanceBase() {
 			base_type = RS::INSTANCE_NONE;
 			cast_shadows = RS::SHADOW_CASTING_SETTING_ON;
@@ -204,6 +219,8 @@ public:
 		}
 	};
 
+	virtual void instance_free_render_data(InstanceBase *p_instance) {}
+
 	virtual RID light_instance_create(RID p_light) = 0;
 	virtual void light_instance_set_transform(RID p_light_instance, const Transform &p_transform) = 0;
 	virtual void light_instance_set_aabb(RID p_light_instance, const AABB &p_aabb) = 0;
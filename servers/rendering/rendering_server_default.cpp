@@ -181,7 +181,14 @@ void RenderingServerDefault::finish() {
 /* STATUS INFORMATION */
 
 int RenderingServerDefault::get_render_info(RenderInfo p_info) {
-	return RSG::storage->get_render_info(p_info);
+	switch (p_info) {
+		case INFO_2D_ITEMS_IN_FRAME:
+		case INFO_2D_BATCHES_IN_FRAME:
+		case INFO_2D_BATCHED_RECTS_IN_FRAME:
+			return RSG::canvas_render->get_render_info(p_info);
+		default:
+			return RSG::storage->get_render_info(p_info);
+	}
 }
 
 String RenderingServerDefault::get_video_adapter_name() const {
@@ -497,6 +497,17 @@ public:
 	BIND2(camera_set_camera_effects, RID, RID)
 	BIND2(camera_set_use_vertical_aspect, RID, bool)
 
+	/* ROOM & PORTAL API */
+
+	BIND0R(RID, room_create)
+	BIND2(room_set_scenario, RID, RID)
+	BIND2(room_set_bounds, RID, const Vector<Plane> &)
+
+	BIND0R(RID, portal_create)
+	BIND3(portal_set_rooms, RID, RID, RID)
+	BIND2(portal_set_points, RID, const Vector<Vector3> &)
+	BIND2(portal_set_enabled, RID, bool)
+
 #undef BINDBASE
 //from now on, calls forwarded to this singleton
 #define BINDBASE RSG::viewport
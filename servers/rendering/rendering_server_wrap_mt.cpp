@@ -126,6 +126,8 @@ void RenderingServerWrapMT::finish() {
 	particles_free_cached_ids();
 	particles_collision_free_cached_ids();
 	camera_free_cached_ids();
+	room_free_cached_ids();
+	portal_free_cached_ids();
 	viewport_free_cached_ids();
 	environment_free_cached_ids();
 	camera_effects_free_cached_ids();
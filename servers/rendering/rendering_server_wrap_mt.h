@@ -404,6 +404,17 @@ public:
 	FUNC2(camera_set_camera_effects, RID, RID)
 	FUNC2(camera_set_use_vertical_aspect, RID, bool)
 
+	/* ROOM & PORTAL API */
+
+	FUNCRID(room)
+	FUNC2(room_set_scenario, RID, RID)
+	FUNC2(room_set_bounds, RID, const Vector<Plane> &)
+
+	FUNCRID(portal)
+	FUNC3(portal_set_rooms, RID, RID, RID)
+	FUNC2(portal_set_points, RID, const Vector<Vector3> &)
+	FUNC2(portal_set_enabled, RID, bool)
+
 	/* VIEWPORT TARGET API */
 
 	FUNCRID(viewport)
@@ -92,6 +92,17 @@ Array RenderingServer::_instances_cull_ray_bind(const Vector3 &p_from, const Vec
 	return to_array(ids);
 }
 
+void RenderingServer::_room_set_bounds_bind(RID p_room, const Array &p_planes) {
+	Vector<Plane> planes;
+	for (int i = 0; i < p_planes.size(); ++i) {
+		Variant v = p_planes[i];
+		ERR_FAIL_COND(v.get_type() != Variant::PLANE);
+		planes.push_back(v);
+	}
+
+	room_set_bounds(p_room, planes);
+}
+
 Array RenderingServer::_instances_cull_convex_bind(const Array &p_convex, RID p_scenario) const {
 	Vector<Plane> planes;
 	for (int i = 0; i < p_convex.size(); ++i) {
@@ -1625,6 +1636,15 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("camera_set_environment", "camera", "env"), &RenderingServer::camera_set_environment);
 	ClassDB::bind_method(D_METHOD("camera_set_use_vertical_aspect", "camera", "enable"), &RenderingServer::camera_set_use_vertical_aspect);
 
+	ClassDB::bind_method(D_METHOD("room_create"), &RenderingServer::room_create);
+	ClassDB::bind_method(D_METHOD("room_set_scenario", "room", "scenario"), &RenderingServer::room_set_scenario);
+	ClassDB::bind_method(D_METHOD("room_set_bounds", "room", "planes"), &RenderingServer::_room_set_bounds_bind);
+
+	ClassDB::bind_method(D_METHOD("portal_create"), &RenderingServer::portal_create);
+	ClassDB::bind_method(D_METHOD("portal_set_rooms", "portal", "room_a", "room_b"), &RenderingServer::portal_set_rooms);
+	ClassDB::bind_method(D_METHOD("portal_set_points", "portal", "points"), &RenderingServer::portal_set_points);
+	ClassDB::bind_method(D_METHOD("portal_set_enabled", "portal", "enabled"), &RenderingServer::portal_set_enabled);
+
 	ClassDB::bind_method(D_METHOD("viewport_create"), &RenderingServer::viewport_create);
 	ClassDB::bind_method(D_METHOD("viewport_set_use_xr", "viewport", "use_xr"), &RenderingServer::viewport_set_use_xr);
 	ClassDB::bind_method(D_METHOD("viewport_set_size", "viewport", "width", "height"), &RenderingServer::viewport_set_size);
@@ -2087,6 +2107,7 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INSTANCE_FLAG_USE_BAKED_LIGHT);
 	BIND_ENUM_CONSTANT(INSTANCE_FLAG_USE_DYNAMIC_GI);
 	BIND_ENUM_CONSTANT(INSTANCE_FLAG_DRAW_NEXT_FRAME_IF_VISIBLE);
+	BIND_ENUM_CONSTANT(INSTANCE_FLAG_OCCLUDER);
 	BIND_ENUM_CONSTANT(INSTANCE_FLAG_MAX);
 
 	BIND_ENUM_CONSTANT(SHADOW_CASTING_SETTING_OFF);
@@ -2173,6 +2194,9 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_VIDEO_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_VERTEX_MEM_USED);
+	BIND_ENUM_CONSTANT(INFO_2D_ITEMS_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_2D_BATCHES_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_2D_BATCHED_RECTS_IN_FRAME);
 
 	BIND_ENUM_CONSTANT(FEATURE_SHADERS);
 	BIND_ENUM_CONSTANT(FEATURE_MULTITHREADED);
@@ -2329,6 +2353,9 @@ RenderingServer::RenderingServer() {
 	GLOBAL_DEF("rendering/quality/glow/upscale_mode.mobile", 0);
 	GLOBAL_DEF("rendering/quality/glow/use_high_quality", false);
 
+	GLOBAL_DEF("rendering/quality/mesh_lod/lod_change_hysteresis", 0.1);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/mesh_lod/lod_change_hysteresis", PropertyInfo(Variant::FLOAT, "rendering/quality/mesh_lod/lod_change_hysteresis", PROPERTY_HINT_RANGE, "0,0.5,0.01"));
+
 	GLOBAL_DEF("rendering/quality/screen_space_reflection/roughness_quality", 1);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/screen_space_reflection/roughness_quality", PropertyInfo(Variant::INT, "rendering/quality/screen_space_reflection/roughness_quality", PROPERTY_HINT_ENUM, "Disabled (Fastest),Low (Fast),Medium (Average),High (Slow)"));
 
@@ -2344,6 +2371,8 @@ RenderingServer::RenderingServer() {
 	GLOBAL_DEF("rendering/lightmapper/probe_capture_update_speed", 15);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/lightmapper/probe_capture_update_speed", PropertyInfo(Variant::FLOAT, "rendering/lightmapper/probe_capture_update_speed", PROPERTY_HINT_RANGE, "0.001,256,0.001"));
 
+	GLOBAL_DEF("rendering/occlusion_culling/enabled", true);
+
 	GLOBAL_DEF("rendering/sdfgi/probe_ray_count", 2);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/sdfgi/probe_ray_count", PropertyInfo(Variant::INT, "rendering/sdfgi/probe_ray_count", PROPERTY_HINT_ENUM, "8 (Fastest),16,32,64,96,128 (Slowest)"));
 	GLOBAL_DEF("rendering/sdfgi/frames_to_converge", 1);
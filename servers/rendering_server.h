@@ -695,6 +695,19 @@ public:
 	virtual void camera_set_camera_effects(RID p_camera, RID p_camera_effects) = 0;
 	virtual void camera_set_use_vertical_aspect(RID p_camera, bool p_enable) = 0;
 
+	/* ROOM & PORTAL API */
+
+	virtual RID room_create() = 0;
+	virtual void room_set_scenario(RID p_room, RID p_scenario) = 0;
+	virtual void room_set_bounds(RID p_room, const Vector<Plane> &p_planes) = 0;
+
+	void _room_set_bounds_bind(RID p_room, const Array &p_planes);
+
+	virtual RID portal_create() = 0;
+	virtual void portal_set_rooms(RID p_portal, RID p_room_a, RID p_room_b) = 0;
+	virtual void portal_set_points(RID p_portal, const Vector<Vector3> &p_points) = 0;
+	virtual void portal_set_enabled(RID p_portal, bool p_enabled) = 0;
+
 	/* VIEWPORT TARGET API */
 
 	enum CanvasItemTextureFilter {
@@ -1123,6 +1136,7 @@ public:
 		INSTANCE_FLAG_USE_BAKED_LIGHT,
 		INSTANCE_FLAG_USE_DYNAMIC_GI,
 		INSTANCE_FLAG_DRAW_NEXT_FRAME_IF_VISIBLE,
+		INSTANCE_FLAG_OCCLUDER,
 		INSTANCE_FLAG_MAX
 	};
 
@@ -1393,6 +1407,9 @@ public:
 		INFO_VIDEO_MEM_USED,
 		INFO_TEXTURE_MEM_USED,
 		INFO_VERTEX_MEM_USED,
+		INFO_2D_ITEMS_IN_FRAME,
+		INFO_2D_BATCHES_IN_FRAME,
+		INFO_2D_BATCHED_RECTS_IN_FRAME,
 	};
 
 	virtual int get_render_info(RenderInfo p_info) = 0;
@@ -0,0 +1,176 @@
+/*************************************************************************/
+/*  test_animation.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_ANIMATION_H
+#define TEST_ANIMATION_H
+
+#include "scene/resources/animation.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestAnimation {
+
+// Keys start after 0 so looping also interpolates from the last key to the first one.
+static Ref<Animation> create_animation(real_t p_extent) {
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(2);
+	animation->set_loop(true);
+	animation->add_track(Animation::TYPE_TRANSFORM);
+	animation->track_set_path(0, NodePath("Node:transform"));
+	for (int i = 0; i < 20; i++) {
+		const float time = 0.05 + i * 0.1;
+		const Vector3 loc = Vector3(Math::sin(time), Math::cos(time * 3), time * 0.5) * p_extent;
+		const Quat rot = Quat(Vector3(1, 2, 3).normalized(), time * 2);
+		const Vector3 scale = Vector3(1 + 0.5 * Math::sin(time * 2), 1, 1 + time);
+		animation->transform_track_insert_key(0, time, loc, rot, scale);
+	}
+	return animation;
+}
+
+static Ref<Animation> copy_through_properties(const Ref<Animation> &p_animation) {
+	Ref<Animation> copy = memnew(Animation);
+	List<PropertyInfo> properties;
+	p_animation->get_property_list(&properties);
+	for (List<PropertyInfo>::Element *E = properties.front(); E; E = E->next()) {
+		if (E->get().usage & PROPERTY_USAGE_STORAGE) {
+			copy->set(E->get().name, p_animation->get(E->get().name));
+		}
+	}
+	return copy;
+}
+
+static bool is_sample_equal(const Ref<Animation> &p_animation, float p_time, int *r_cursor) {
+	Vector3 loc, cursor_loc;
+	Quat rot, cursor_rot;
+	Vector3 scale, cursor_scale;
+	p_animation->transform_track_interpolate(0, p_time, &loc, &rot, &scale);
+	p_animation->transform_track_interpolate(0, p_time, &cursor_loc, &cursor_rot, &cursor_scale, r_cursor);
+	return loc == cursor_loc && rot == cursor_rot && scale == cursor_scale;
+}
+
+TEST_CASE("[Animation] Compressed transform tracks stay within the maximum error") {
+	const float max_error = 0.001;
+	Ref<Animation> animation = create_animation(2);
+	Ref<Animation> compressed = create_animation(2);
+	compressed->compress(max_error);
+	REQUIRE(compressed->track_is_compressed(0));
+
+	float loc_error = 0;
+	float scale_error = 0;
+	float rot_dot = 1;
+	for (float time = 0; time < animation->get_length(); time += 0.013) {
+		Vector3 loc, compressed_loc;
+		Quat rot, compressed_rot;
+		Vector3 scale, compressed_scale;
+		animation->transform_track_interpolate(0, time, &loc, &rot, &scale);
+		compressed->transform_track_interpolate(0, time, &compressed_loc, &compressed_rot, &compressed_scale);
+		for (int i = 0; i < 3; i++) {
+			loc_error = MAX(loc_error, Math::abs(loc[i] - compressed_loc[i]));
+			scale_error = MAX(scale_error, Math::abs(scale[i] - compressed_scale[i]));
+		}
+		rot_dot = MIN(rot_dot, (real_t)Math::abs(rot.dot(compressed_rot)));
+	}
+
+	CHECK_MESSAGE(loc_error <= max_error, "Compressed locations should stay within the maximum error.");
+	CHECK_MESSAGE(scale_error <= max_error, "Compressed scales should stay within the maximum error.");
+	CHECK_MESSAGE(rot_dot > 0.9999, "Compressed rotations should stay close to the original ones.");
+
+	Ref<Animation> large = create_animation(100000);
+	large->compress(max_error);
+	CHECK_MESSAGE(!large->track_is_compressed(0), "Tracks that can't be quantized within the maximum error should be left uncompressed.");
+}
+
+TEST_CASE("[Animation] Compressed transform tracks are stored and loaded as is") {
+	Ref<Animation> animation = create_animation(2);
+	animation->compress(0.001);
+	REQUIRE(animation->track_is_compressed(0));
+
+	List<PropertyInfo> properties;
+	animation->get_property_list(&properties);
+	for (List<PropertyInfo>::Element *E = properties.front(); E; E = E->next()) {
+		if (E->get().name == "tracks/0/keys") {
+			CHECK_MESSAGE(animation->get(E->get().name).get_type() == E->get().type, "The keys of a compressed track should have the type they are declared with.");
+		}
+	}
+
+	Ref<Animation> copy = copy_through_properties(animation);
+	REQUIRE(copy->get_track_count() == 1);
+	CHECK_MESSAGE(copy->track_is_compressed(0), "Compressed tracks should stay compressed when loaded.");
+	REQUIRE(copy->track_get_key_count(0) == animation->track_get_key_count(0));
+
+	bool match = true;
+	for (int i = 0; i < animation->track_get_key_count(0); i++) {
+		Vector3 loc, copy_loc;
+		Quat rot, copy_rot;
+		Vector3 scale, copy_scale;
+		animation->transform_track_get_key(0, i, &loc, &rot, &scale);
+		copy->transform_track_get_key(0, i, &copy_loc, &copy_rot, &copy_scale);
+		match = match && animation->track_get_key_time(0, i) == copy->track_get_key_time(0, i);
+		match = match && loc == copy_loc && rot == copy_rot && scale == copy_scale;
+	}
+	CHECK_MESSAGE(match, "Compressed keys should be the same after being loaded.");
+}
+
+static void check_cursor_sampling(const Ref<Animation> &p_animation) {
+	int cursor = -1;
+	bool match = true;
+	for (int frame = 0; frame < 360; frame++) {
+		const float time = Math::fposmod(frame / 60.0f, p_animation->get_length());
+		match = match && is_sample_equal(p_animation, time, &cursor);
+	}
+	CHECK_MESSAGE(match, "Forward and looping playback should sample the same transforms with a cursor.");
+
+	match = true;
+	for (float time = p_animation->get_length(); time >= 0; time -= 0.037) {
+		match = match && is_sample_equal(p_animation, time, &cursor);
+	}
+	const float seeks[] = { 1.5, 0.2, 1.95, 0.05, 0, 1, 0.99, 2, 0.01 };
+	for (int i = 0; i < 9; i++) {
+		match = match && is_sample_equal(p_animation, seeks[i], &cursor);
+	}
+	CHECK_MESSAGE(match, "Seeking backwards should sample the same transforms with a cursor.");
+}
+
+TEST_CASE("[Animation] Sampling with a cursor matches sampling without one") {
+	Ref<Animation> animation = create_animation(2);
+
+	SUBCASE("Uncompressed track") {
+		check_cursor_sampling(animation);
+	}
+
+	SUBCASE("Compressed track") {
+		animation->compress(0.001);
+		REQUIRE(animation->track_is_compressed(0));
+		check_cursor_sampling(animation);
+	}
+}
+} // namespace TestAnimation
+
+#endif // TEST_ANIMATION_H
@@ -0,0 +1,260 @@
+/*************************************************************************/
+/*  test_animation_tree.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_ANIMATION_TREE_H
+#define TEST_ANIMATION_TREE_H
+
+#include "scene/3d/node_3d.h"
+#include "scene/animation/animation_blend_space_1d.h"
+#include "scene/animation/animation_blend_tree.h"
+#include "scene/animation/animation_player.h"
+#include "scene/animation/animation_tree.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+// Runs the steps the trees go through in a frame, as they can't be processed
+// outside of a SceneTree.
+class AnimationTreeTester {
+public:
+	static void process_serial(AnimationTree *p_tree, float p_delta) {
+		p_tree->_process_graph(p_delta);
+	}
+
+	// Evaluates the trees on worker threads, as done by the first tree processed in a frame.
+	static void evaluate_parallel(const LocalVector<AnimationTree *> &p_trees, float p_delta) {
+		AnimationTree::parallel_batch_pass++;
+		for (uint32_t i = 0; i < p_trees.size(); i++) {
+			p_trees[i]->parallel_evaluated = p_trees[i]->_add_to_parallel_batch(p_delta);
+		}
+
+		AnimationTree::_evaluate_parallel_batch();
+	}
+
+	// Applies the results, as done by each tree when it is processed.
+	static void apply_parallel(const LocalVector<AnimationTree *> &p_trees, float p_delta) {
+		for (uint32_t i = 0; i < p_trees.size(); i++) {
+			AnimationTree *tree = p_trees[i];
+			if (tree->parallel_evaluated) {
+				tree->parallel_evaluated = false;
+				tree->_apply_graph(p_delta);
+			} else {
+				tree->_process_graph(p_delta);
+			}
+		}
+	}
+
+	static void process_parallel(const LocalVector<AnimationTree *> &p_trees, float p_delta) {
+		evaluate_parallel(p_trees, p_delta);
+		apply_parallel(p_trees, p_delta);
+	}
+};
+
+namespace TestAnimationTree {
+
+class AnimationTreeTarget : public Node {
+	GDCLASS(AnimationTreeTarget, Node);
+
+	float amount = 0;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_amount", "amount"), &AnimationTreeTarget::set_amount);
+		ClassDB::bind_method(D_METHOD("get_amount"), &AnimationTreeTarget::get_amount);
+		ClassDB::bind_method(D_METHOD("set_event", "event"), &AnimationTreeTarget::set_event);
+		ClassDB::bind_method(D_METHOD("get_event"), &AnimationTreeTarget::get_event);
+
+		ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "amount"), "set_amount", "get_amount");
+		ADD_PROPERTY(PropertyInfo(Variant::INT, "event"), "set_event", "get_event");
+	}
+
+public:
+	Vector<int> events;
+
+	void set_amount(float p_amount) { amount = p_amount; }
+	float get_amount() const { return amount; }
+
+	// Discrete keys are the track events, so every value set is recorded.
+	void set_event(int p_event) { events.push_back(p_event); }
+	int get_event() const { return events.size() ? events[events.size() - 1] : 0; }
+};
+
+struct TreeSetup {
+	Node *root = nullptr;
+	AnimationPlayer *player = nullptr;
+	Node3D *target = nullptr;
+	AnimationTreeTarget *events = nullptr;
+	AnimationTree *tree = nullptr;
+};
+
+static Ref<Animation> create_animation(real_t p_speed, int p_first_event) {
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(1);
+	animation->set_loop(true);
+
+	animation->add_track(Animation::TYPE_TRANSFORM);
+	animation->track_set_path(0, NodePath("Target"));
+	for (int i = 0; i < 5; i++) {
+		const float time = i * 0.25;
+		animation->transform_track_insert_key(0, time, Vector3(time * p_speed, Math::sin(time * 3), 0), Quat(Vector3(0, 1, 0), time * p_speed), Vector3(1, 1, 1));
+	}
+
+	animation->add_track(Animation::TYPE_VALUE);
+	animation->track_set_path(1, NodePath("Events:amount"));
+	animation->track_insert_key(1, 0, 0.0);
+	animation->track_insert_key(1, 1, p_speed);
+
+	animation->add_track(Animation::TYPE_VALUE);
+	animation->track_set_path(2, NodePath("Events:event"));
+	animation->value_track_set_update_mode(2, Animation::UPDATE_DISCRETE);
+	for (int i = 0; i < 3; i++) {
+		animation->track_insert_key(2, 0.1 + i * 0.3, p_first_event + i);
+	}
+
+	return animation;
+}
+
+static TreeSetup create_tree(const Ref<Animation> &p_walk, const Ref<Animation> &p_run, bool p_parallel) {
+	TreeSetup setup;
+	setup.root = memnew(Node);
+
+	setup.player = memnew(AnimationPlayer);
+	setup.player->set_name("Player");
+	setup.player->set_root(NodePath(".."));
+	setup.player->add_animation("walk", p_walk);
+	setup.player->add_animation("run", p_run);
+	setup.root->add_child(setup.player);
+
+	setup.target = memnew(Node3D);
+	setup.target->set_name("Target");
+	setup.root->add_child(setup.target);
+
+	setup.events = memnew(AnimationTreeTarget);
+	setup.events->set_name("Events");
+	setup.root->add_child(setup.events);
+
+	// Every tree needs its own nodes, trees sharing them are evaluated serially.
+	Ref<AnimationNodeAnimation> walk = memnew(AnimationNodeAnimation);
+	walk->set_animation("walk");
+	Ref<AnimationNodeAnimation> run = memnew(AnimationNodeAnimation);
+	run->set_animation("run");
+	Ref<AnimationNodeBlendSpace1D> blend_space = memnew(AnimationNodeBlendSpace1D);
+	blend_space->add_blend_point(walk, -1);
+	blend_space->add_blend_point(run, 1);
+
+	setup.tree = memnew(AnimationTree);
+	setup.tree->set_name("Tree");
+	setup.root->add_child(setup.tree);
+	setup.tree->set_animation_player(NodePath("../Player"));
+	setup.tree->set_tree_root(blend_space);
+	setup.tree->set_parallel_evaluation(p_parallel);
+	setup.tree->set_active(true);
+
+	return setup;
+}
+
+TEST_CASE("[AnimationTree] Parallel evaluation matches serial evaluation") {
+	const int tree_count = 4;
+	const float delta = 1.0 / 60.0;
+
+	LocalVector<TreeSetup> serial;
+	LocalVector<TreeSetup> parallel;
+	LocalVector<AnimationTree *> parallel_trees;
+	for (int i = 0; i < tree_count; i++) {
+		Ref<Animation> walk = create_animation(1 + i, 100 * i);
+		Ref<Animation> run = create_animation(3 + i, 100 * i + 10);
+		serial.push_back(create_tree(walk, run, false));
+		parallel.push_back(create_tree(walk, run, true));
+		parallel_trees.push_back(parallel[i].tree);
+	}
+
+	bool poses_match = true;
+	for (int frame = 0; frame < 150; frame++) {
+		for (int i = 0; i < tree_count; i++) {
+			const float blend_position = Math::sin(frame * 0.05 + i);
+			serial[i].tree->set("parameters/blend_position", blend_position);
+			parallel[i].tree->set("parameters/blend_position", blend_position);
+			AnimationTreeTester::process_serial(serial[i].tree, delta);
+		}
+		AnimationTreeTester::process_parallel(parallel_trees, delta);
+
+		for (int i = 0; i < tree_count; i++) {
+			poses_match = poses_match && serial[i].target->get_transform().is_equal_approx(parallel[i].target->get_transform());
+			poses_match = poses_match && Math::is_equal_approx(serial[i].events->get_amount(), parallel[i].events->get_amount());
+		}
+	}
+
+	CHECK_MESSAGE(poses_match, "Trees evaluated in parallel should have the same poses as trees evaluated serially.");
+	for (int i = 0; i < tree_count; i++) {
+		CHECK_MESSAGE(serial[i].events->events.size() > 0, "Discrete value tracks should have been triggered.");
+		CHECK_MESSAGE(serial[i].events->events == parallel[i].events->events, "Trees evaluated in parallel should trigger the same events as trees evaluated serially.");
+	}
+
+	for (int i = 0; i < tree_count; i++) {
+		memdelete(serial[i].root);
+		memdelete(parallel[i].root);
+	}
+}
+TEST_CASE("[AnimationTree] Caches cleared after parallel evaluation") {
+	const float delta = 1.0 / 60.0;
+
+	Ref<Animation> walk = create_animation(1, 0);
+	Ref<Animation> run = create_animation(3, 10);
+	TreeSetup serial = create_tree(walk, run, false);
+	TreeSetup parallel = create_tree(walk, run, true);
+	LocalVector<AnimationTree *> parallel_trees;
+	parallel_trees.push_back(parallel.tree);
+
+	bool poses_match = true;
+	for (int frame = 0; frame < 90; frame++) {
+		const float blend_position = Math::sin(frame * 0.05);
+		serial.tree->set("parameters/blend_position", blend_position);
+		parallel.tree->set("parameters/blend_position", blend_position);
+		AnimationTreeTester::process_serial(serial.tree, delta);
+
+		AnimationTreeTester::evaluate_parallel(parallel_trees, delta);
+		if (frame % 7 == 3) {
+			// As done by the player when a node it animates is removed.
+			parallel.player->emit_signal("caches_cleared");
+		}
+		AnimationTreeTester::apply_parallel(parallel_trees, delta);
+
+		poses_match = poses_match && serial.target->get_transform().is_equal_approx(parallel.target->get_transform());
+		poses_match = poses_match && Math::is_equal_approx(serial.events->get_amount(), parallel.events->get_amount());
+	}
+
+	CHECK_MESSAGE(poses_match, "Clearing the caches after the batch shouldn't advance the tree again.");
+	CHECK_MESSAGE(serial.events->events == parallel.events->events, "Clearing the caches after the batch shouldn't lose or repeat events.");
+
+	memdelete(serial.root);
+	memdelete(parallel.root);
+}
+} // namespace TestAnimationTree
+
+#endif // TEST_ANIMATION_TREE_H
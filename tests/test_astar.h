@@ -90,6 +90,31 @@ TEST_CASE("[AStar] ABCX path") {
 	CHECK(path[3] == ABCX::C);
 }
 
+TEST_CASE("[AStar] Compact connections") {
+	ABCX abcx;
+	abcx.set_compact_connections_enabled(true);
+	CHECK(abcx.is_compact_connections_enabled());
+
+	Vector<int> path = abcx.get_id_path(ABCX::X, ABCX::C);
+	REQUIRE(path.size() == 4);
+	CHECK(path[0] == ABCX::X);
+	CHECK(path[1] == ABCX::A);
+	CHECK(path[2] == ABCX::B);
+	CHECK(path[3] == ABCX::C);
+
+	// The compact connections must follow the changes made to the graph.
+	abcx.disconnect_points(ABCX::A, ABCX::B);
+	path = abcx.get_id_path(ABCX::X, ABCX::C);
+	REQUIRE(path.size() == 3);
+	CHECK(path[0] == ABCX::X);
+	CHECK(path[1] == ABCX::A);
+	CHECK(path[2] == ABCX::C);
+
+	abcx.remove_point(ABCX::A);
+	path = abcx.get_id_path(ABCX::X, ABCX::C);
+	CHECK(path.size() == 0);
+}
+
 TEST_CASE("[AStar] Add/Remove") {
 	AStar a;
 
@@ -225,6 +250,7 @@ TEST_CASE("[Stress][AStar] Find paths") {
 
 	for (int test = 0; test < 1000; test++) {
 		AStar a;
+		a.set_compact_connections_enabled(test % 2 == 1); // Alternate both ways of storing the connections.
 		Vector3 p[N];
 		bool adj[N][N] = { { false } };
 
@@ -0,0 +1,215 @@
+/*************************************************************************/
+/*  test_astar_grid_2d.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_ASTAR_GRID_2D_H
+#define TEST_ASTAR_GRID_2D_H
+
+#include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
+#include "core/math/math_funcs.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAStarGrid2D {
+
+static real_t get_path_length(const TypedArray<Vector2i> &p_path) {
+	real_t length = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		Vector2i from = p_path[i - 1];
+		Vector2i to = p_path[i];
+		length += (from.x != to.x && from.y != to.y) ? Math_SQRT2 : 1.0;
+	}
+	return length;
+}
+
+TEST_CASE("[AStarGrid2D] Paths") {
+	AStarGrid2D a;
+	a.set_size(Size2i(32, 32));
+	a.set_cell_size(Size2(16, 16));
+	a.set_point_solid(Vector2i(2, 2));
+
+	TypedArray<Vector2i> path = a.get_id_path(Vector2i(0, 0), Vector2i(3, 4));
+	REQUIRE(path.size() == 5);
+	CHECK(Vector2i(path[0]) == Vector2i(0, 0));
+	CHECK(Vector2i(path[1]) == Vector2i(1, 1));
+	CHECK(Vector2i(path[2]) == Vector2i(1, 2));
+	CHECK(Vector2i(path[3]) == Vector2i(2, 3));
+	CHECK(Vector2i(path[4]) == Vector2i(3, 4));
+
+	Vector<Vector2> point_path = a.get_point_path(Vector2i(0, 0), Vector2i(3, 4));
+	REQUIRE(point_path.size() == 5);
+	CHECK(point_path[4] == Vector2(48, 64));
+
+	// A path can't end on a solid point.
+	CHECK(a.get_id_path(Vector2i(0, 0), Vector2i(2, 2)).size() == 0);
+
+	// Wall off the first column.
+	for (int y = 0; y < 32; y++) {
+		a.set_point_solid(Vector2i(1, y));
+	}
+	CHECK(a.get_id_path(Vector2i(0, 0), Vector2i(3, 4)).size() == 0);
+	a.set_jumping_enabled(true);
+	CHECK(a.get_id_path(Vector2i(0, 0), Vector2i(3, 4)).size() == 0);
+}
+
+TEST_CASE("[AStarGrid2D] Diagonal modes") {
+	AStarGrid2D a;
+	a.set_size(Size2i(3, 3));
+	// Only the diagonal from (0, 0) to (1, 1) is blocked on both sides.
+	a.set_point_solid(Vector2i(1, 0));
+	a.set_point_solid(Vector2i(0, 1));
+
+	a.set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_ALWAYS);
+	CHECK(a.get_id_path(Vector2i(0, 0), Vector2i(1, 1)).size() == 2);
+	a.set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE);
+	CHECK(a.get_id_path(Vector2i(0, 0), Vector2i(1, 1)).size() == 0);
+
+	a.set_point_solid(Vector2i(1, 0), false);
+	CHECK(a.get_id_path(Vector2i(0, 0), Vector2i(1, 1)).size() == 2);
+	a.set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES);
+	CHECK(a.get_id_path(Vector2i(0, 0), Vector2i(1, 1)).size() == 3);
+
+	a.set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_NEVER);
+	CHECK(a.get_id_path(Vector2i(0, 0), Vector2i(2, 2)).size() == 5);
+}
+
+TEST_CASE("[Stress][AStarGrid2D] Jump point search finds paths of the same length") {
+	Math::seed(0);
+
+	for (int test = 0; test < 400; test++) {
+		const Size2i size(1 + Math::rand() % 24, 1 + Math::rand() % 24);
+		const AStarGrid2D::DiagonalMode mode = AStarGrid2D::DiagonalMode(Math::rand() % AStarGrid2D::DIAGONAL_MODE_MAX);
+		const int density = Math::rand() % 50;
+
+		AStarGrid2D a;
+		AStarGrid2D jps;
+		a.set_size(size);
+		jps.set_size(size);
+		a.set_diagonal_mode(mode);
+		jps.set_diagonal_mode(mode);
+		jps.set_jumping_enabled(true);
+
+		for (int y = 0; y < size.y; y++) {
+			for (int x = 0; x < size.x; x++) {
+				if (int(Math::rand() % 100) < density) {
+					a.set_point_solid(Vector2i(x, y));
+					jps.set_point_solid(Vector2i(x, y));
+				}
+			}
+		}
+
+		bool match = true;
+		for (int query = 0; query < 10; query++) {
+			const Vector2i from(Math::rand() % size.x, Math::rand() % size.y);
+			const Vector2i to(Math::rand() % size.x, Math::rand() % size.y);
+
+			TypedArray<Vector2i> path = a.get_id_path(from, to);
+			TypedArray<Vector2i> jps_path = jps.get_id_path(from, to);
+			if (path.size() == 0 || jps_path.size() == 0) {
+				match = match && path.size() == jps_path.size();
+				continue;
+			}
+			match = match && Vector2i(jps_path[0]) == from && Vector2i(jps_path[jps_path.size() - 1]) == to;
+			match = match && Math::is_equal_approx(get_path_length(path), get_path_length(jps_path));
+		}
+		CHECK_MESSAGE(match, vformat("Test #%d: jump point search found the same paths.", test + 1));
+	}
+}
+
+TEST_CASE("[Stress][AStarGrid2D] Large grid paths match AStar2D") {
+	const int N = 512;
+	Math::seed(0);
+
+	AStar2D astar;
+	AStarGrid2D grid;
+	grid.set_size(Size2i(N, N));
+
+	astar.reserve_space(N * N);
+	for (int y = 0; y < N; y++) {
+		for (int x = 0; x < N; x++) {
+			astar.add_point(y * N + x, Vector2(x, y));
+		}
+	}
+	for (int y = 0; y < N; y++) {
+		for (int x = 0; x < N; x++) {
+			if (x + 1 < N) {
+				astar.connect_points(y * N + x, y * N + x + 1);
+			}
+			if (y + 1 < N) {
+				astar.connect_points(y * N + x, (y + 1) * N + x);
+				if (x + 1 < N) {
+					astar.connect_points(y * N + x, (y + 1) * N + x + 1);
+				}
+				if (x > 0) {
+					astar.connect_points(y * N + x, (y + 1) * N + x - 1);
+				}
+			}
+		}
+	}
+
+	// Scatter obstacles, keeping the corners free.
+	for (int i = 0; i < N * N / 5; i++) {
+		const Vector2i p(Math::rand() % N, Math::rand() % N);
+		if ((p.x < 2 && p.y < 2) || (p.x >= N - 2 && p.y >= N - 2)) {
+			continue;
+		}
+		astar.set_point_disabled(p.y * N + p.x);
+		grid.set_point_solid(p);
+	}
+
+	Vector<int> astar_path = astar.get_id_path(0, N * N - 1);
+
+	astar.set_compact_connections_enabled(true);
+	astar.get_id_path(0, 1); // Builds the compact connections.
+	astar_path = astar.get_id_path(0, N * N - 1);
+
+	TypedArray<Vector2i> grid_path = grid.get_id_path(Vector2i(0, 0), Vector2i(N - 1, N - 1));
+
+	grid.set_jumping_enabled(true);
+	TypedArray<Vector2i> jps_path = grid.get_id_path(Vector2i(0, 0), Vector2i(N - 1, N - 1));
+
+	REQUIRE(astar_path.size() > 0);
+	real_t astar_length = 0;
+	for (int i = 1; i < astar_path.size(); i++) {
+		astar_length += astar.get_point_position(astar_path[i - 1]).distance_to(astar.get_point_position(astar_path[i]));
+	}
+	CHECK(Math::is_equal_approx(astar_length, get_path_length(grid_path)));
+	CHECK(Math::is_equal_approx(astar_length, get_path_length(jps_path)));
+
+	// Without diagonals, jumping scans rows at every vertical step.
+	grid.set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_NEVER);
+	jps_path = grid.get_id_path(Vector2i(0, 0), Vector2i(N - 1, N - 1));
+	grid.set_jumping_enabled(false);
+	grid_path = grid.get_id_path(Vector2i(0, 0), Vector2i(N - 1, N - 1));
+	CHECK(Math::is_equal_approx(get_path_length(grid_path), get_path_length(jps_path)));
+}
+} // namespace TestAStarGrid2D
+
+#endif // TEST_ASTAR_GRID_2D_H
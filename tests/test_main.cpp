@@ -33,7 +33,10 @@
 #include "core/templates/list.h"
 
 #include "test_aabb.h"
+#include "test_animation.h"
+#include "test_animation_tree.h"
 #include "test_astar.h"
+#include "test_astar_grid_2d.h"
 #include "test_basis.h"
 #include "test_class_db.h"
 #include "test_color.h"
@@ -54,13 +57,17 @@
 #include "test_oa_hash_map.h"
 #include "test_object.h"
 #include "test_ordered_hash_map.h"
+#include "test_packed_scene.h"
 #include "test_paged_array.h"
 #include "test_pck_packer.h"
 #include "test_physics_2d.h"
 #include "test_physics_3d.h"
+#include "test_radix_sort.h"
 #include "test_random_number_generator.h"
 #include "test_rect2.h"
 #include "test_render.h"
+#include "test_renderer_scene_occlusion_cull.h"
+#include "test_resource_loader.h"
 #include "test_shader_lang.h"
 #include "test_string.h"
 #include "test_text_server.h"
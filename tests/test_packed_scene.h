@@ -0,0 +1,156 @@
+/*************************************************************************/
+/*  test_packed_scene.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PACKED_SCENE_H
+#define TEST_PACKED_SCENE_H
+
+#include "scene/main/timer.h"
+#include "scene/resources/packed_scene.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPackedScene {
+
+static Ref<PackedScene> create_pooled_scene() {
+	Timer *root = memnew(Timer);
+	root->set_name("Root");
+	root->set_wait_time(2.0);
+	root->add_to_group("pooled", true);
+
+	Timer *child = memnew(Timer);
+	child->set_name("Child");
+	child->set_one_shot(true);
+	root->add_child(child);
+	child->set_owner(root);
+
+	Ref<PackedScene> scene;
+	scene.instance();
+	CHECK(scene->pack(root) == OK);
+	memdelete(root);
+
+	return scene;
+}
+
+TEST_CASE("[PackedScene] Released instances are reused like fresh ones") {
+	Ref<PackedScene> scene = create_pooled_scene();
+	Node *fresh = scene->instance();
+	REQUIRE(fresh);
+
+	Node *instance = scene->instance_pooled();
+	REQUIRE(instance);
+	Timer *root = Object::cast_to<Timer>(instance);
+	Timer *child = Object::cast_to<Timer>(instance->get_node(NodePath("Child")));
+	REQUIRE(root);
+	REQUIRE(child);
+
+	root->set_wait_time(5.0);
+	root->set_autostart(true);
+	child->set_one_shot(false);
+
+	scene->release_instance(instance);
+	CHECK_MESSAGE(
+			scene->get_pooled_instance_count() == 1,
+			"A released instance with an unchanged structure should be kept in the pool.");
+
+	Node *reused = scene->instance_pooled();
+	CHECK_MESSAGE(reused == instance, "The pooled instance should be reused.");
+	CHECK(scene->get_pooled_instance_count() == 0);
+
+	Timer *fresh_root = Object::cast_to<Timer>(fresh);
+	Timer *fresh_child = Object::cast_to<Timer>(fresh->get_node(NodePath("Child")));
+	CHECK(root->get_wait_time() == doctest::Approx(fresh_root->get_wait_time()));
+	CHECK(root->has_autostart() == fresh_root->has_autostart());
+	CHECK(child->is_one_shot() == fresh_child->is_one_shot());
+	CHECK(reused->get_child_count() == fresh->get_child_count());
+	CHECK(reused->is_in_group("pooled") == fresh->is_in_group("pooled"));
+
+	memdelete(fresh);
+	scene->release_instance(reused);
+	scene->clear_pool();
+	CHECK(scene->get_pooled_instance_count() == 0);
+}
+
+TEST_CASE("[PackedScene] Instances that can't be reused are rejected or freed") {
+	Ref<PackedScene> scene = create_pooled_scene();
+
+	SUBCASE("Nodes not obtained from the pool of this scene") {
+		Node *foreign = memnew(Node);
+		Node *instance = scene->instance();
+
+		ERR_PRINT_OFF;
+		scene->release_instance(foreign);
+		scene->release_instance(instance);
+		ERR_PRINT_ON;
+
+		CHECK_MESSAGE(
+				scene->get_pooled_instance_count() == 0,
+				"Nodes not obtained with instance_pooled() should be rejected.");
+
+		// Rejected nodes are left alone, so they are still valid here.
+		memdelete(foreign);
+		memdelete(instance);
+	}
+
+	SUBCASE("Added child") {
+		Node *instance = scene->instance_pooled();
+		instance->add_child(memnew(Node));
+		scene->release_instance(instance);
+		CHECK(scene->get_pooled_instance_count() == 0);
+	}
+
+	SUBCASE("Removed child") {
+		Node *instance = scene->instance_pooled();
+		Node *child = instance->get_node(NodePath("Child"));
+		instance->remove_child(child);
+		memdelete(child);
+		scene->release_instance(instance);
+		CHECK(scene->get_pooled_instance_count() == 0);
+	}
+
+	SUBCASE("Changed groups") {
+		Node *instance = scene->instance_pooled();
+		instance->remove_from_group("pooled");
+		scene->release_instance(instance);
+		CHECK(scene->get_pooled_instance_count() == 0);
+	}
+
+	SUBCASE("Added signal connection") {
+		Node *instance = scene->instance_pooled();
+		Node *target = memnew(Node);
+		instance->connect("timeout", Callable(target, "queue_free"));
+		scene->release_instance(instance);
+		CHECK(scene->get_pooled_instance_count() == 0);
+		memdelete(target);
+	}
+}
+
+} // namespace TestPackedScene
+
+#endif // TEST_PACKED_SCENE_H
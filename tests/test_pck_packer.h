@@ -109,6 +109,97 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_len() <= 35000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Pack a PCK file with compressed files") {
+	const String base_dir = OS::get_singleton()->get_executable_path().get_base_dir();
+
+	PCKPacker pck_packer_plain;
+	const String plain_pck_path = OS::get_singleton()->get_cache_path().plus_file("output_plain.pck");
+	CHECK(pck_packer_plain.pck_start(plain_pck_path, 32, ENCRYPTION_KEY) == OK);
+	CHECK(pck_packer_plain.add_file("icon.svg", base_dir.plus_file("../icon.svg")) == OK);
+	CHECK(pck_packer_plain.add_file("logo.svg", base_dir.plus_file("../logo.svg")) == OK);
+	CHECK(pck_packer_plain.flush() == OK);
+
+	PCKPacker pck_packer;
+	const String output_pck_path = OS::get_singleton()->get_cache_path().plus_file("output_compressed.pck");
+	CHECK(pck_packer.pck_start(output_pck_path, 32, ENCRYPTION_KEY) == OK);
+	pck_packer.set_compression_mode(PCKPacker::COMPRESSION_ZSTD);
+	CHECK_MESSAGE(
+			pck_packer.add_file("icon.svg", base_dir.plus_file("../icon.svg"), false, true) == OK,
+			"Adding a compressed file to the PCK should return an OK error code.");
+	CHECK_MESSAGE(
+			pck_packer.add_file("logo.svg", base_dir.plus_file("../logo.svg"), true, true) == OK,
+			"Adding a compressed and encrypted file to the PCK should return an OK error code.");
+	CHECK_MESSAGE(
+			pck_packer.flush() == OK,
+			"Flushing the PCK should return an OK error code.");
+
+	FileAccessRef f_plain = FileAccess::open(plain_pck_path, FileAccess::READ);
+	FileAccessRef f = FileAccess::open(output_pck_path, FileAccess::READ);
+	CHECK_MESSAGE(
+			f->get_len() < f_plain->get_len(),
+			"The PCK file with compressed text files should be smaller than the uncompressed one.");
+}
+
+TEST_CASE("[PCKPacker] Read back compressed and encrypted files") {
+	const String base_dir = OS::get_singleton()->get_executable_path().get_base_dir();
+	const String output_pck_path = OS::get_singleton()->get_cache_path().plus_file("output_round_trip.pck");
+
+	struct PackedFile {
+		String path;
+		String source;
+		bool encrypt;
+		bool compress;
+	};
+
+	// The files are read back with the built-in encryption key, which is
+	// all zeros (like `ENCRYPTION_KEY`) unless the build sets a custom one.
+	const PackedFile packed_files[] = {
+		{ "res://round_trip/version.py", base_dir.plus_file("../version.py"), false, false },
+		{ "res://round_trip/icon.svg", base_dir.plus_file("../icon.svg"), false, true },
+		{ "res://round_trip/logo.svg", base_dir.plus_file("../logo.svg"), true, true },
+		{ "res://round_trip/logo.png", base_dir.plus_file("../logo.png"), true, false },
+	};
+	const int packed_file_count = sizeof(packed_files) / sizeof(packed_files[0]);
+
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(output_pck_path, 32, ENCRYPTION_KEY) == OK);
+	pck_packer.set_compression_mode(PCKPacker::COMPRESSION_ZSTD);
+	for (int i = 0; i < packed_file_count; i++) {
+		REQUIRE(pck_packer.add_file(packed_files[i].path, packed_files[i].source, packed_files[i].encrypt, packed_files[i].compress) == OK);
+	}
+	REQUIRE(pck_packer.flush() == OK);
+
+	PackedData packed_data;
+	REQUIRE_MESSAGE(
+			packed_data.add_pack(output_pck_path, true, 0) == OK,
+			"The generated PCK file should be loaded successfully.");
+
+	for (int i = 0; i < packed_file_count; i++) {
+		const Vector<uint8_t> expected = FileAccess::get_file_as_array(packed_files[i].source);
+		REQUIRE(expected.size() > 0);
+
+		FileAccess *f = packed_data.try_open_path(packed_files[i].path);
+		REQUIRE_MESSAGE(f, "The file should be found in the PCK: " + packed_files[i].path);
+
+		CHECK_MESSAGE(
+				f->get_len() == (size_t)expected.size(),
+				"The file read from the PCK should have its original size: " + packed_files[i].path);
+
+		Vector<uint8_t> data;
+		data.resize(expected.size());
+		CHECK(f->get_buffer(data.ptrw(), data.size()) == expected.size());
+		CHECK_MESSAGE(
+				data == expected,
+				"The file read from the PCK should have its original contents: " + packed_files[i].path);
+
+		// Seeking backwards must work too, compressed files are read block by block.
+		f->seek(expected.size() / 2);
+		CHECK(f->get_8() == expected[expected.size() / 2]);
+
+		memdelete(f);
+	}
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
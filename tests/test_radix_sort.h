@@ -0,0 +1,111 @@
+/*************************************************************************/
+/*  test_radix_sort.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RADIX_SORT_H
+#define TEST_RADIX_SORT_H
+
+#include "core/math/random_number_generator.h"
+#include "core/templates/radix_sort.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestRadixSort {
+
+struct KeyValue {
+	uint64_t key;
+	uint32_t value;
+};
+
+struct KeyValueKey {
+	_FORCE_INLINE_ uint64_t operator()(const KeyValue &p_item) const { return p_item.key; }
+};
+
+TEST_CASE("[RadixSort] Matches comparison sort") {
+	Ref<RandomNumberGenerator> rng = memnew(RandomNumberGenerator);
+	rng->set_seed(0);
+
+	const uint32_t count = 10000;
+	Vector<uint64_t> keys;
+	keys.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		keys.write[i] = (uint64_t(rng->randi()) << 32) | rng->randi();
+	}
+
+	Vector<uint64_t> expected = keys;
+	expected.sort();
+
+	Vector<uint64_t> temp;
+	temp.resize(count);
+	RadixSort<uint64_t> sorter;
+	sorter.sort(keys.ptrw(), temp.ptrw(), count);
+
+	bool all_match = true;
+	for (uint32_t i = 0; i < count; i++) {
+		if (keys[i] != expected[i]) {
+			all_match = false;
+			break;
+		}
+	}
+	CHECK_MESSAGE(all_match, "RadixSort should produce the same order as a comparison sort.");
+}
+
+TEST_CASE("[RadixSort] Stable for equal keys") {
+	KeyValue items[6] = { { 3, 0 }, { 1, 1 }, { 3, 2 }, { 1, 3 }, { 0x100, 4 }, { 1, 5 } };
+	KeyValue temp[6];
+
+	RadixSort<KeyValue, KeyValueKey> sorter;
+	sorter.sort(items, temp, 6, 16);
+
+	const uint32_t expected_values[6] = { 1, 3, 5, 0, 2, 4 };
+	for (int i = 0; i < 6; i++) {
+		CHECK(items[i].value == expected_values[i]);
+	}
+}
+
+TEST_CASE("[RadixSort] Float keys") {
+	const float values[7] = { 3.5, -1.0, 0.0, -100.25, 1e10, -1e-5, 2.0 };
+	uint32_t keys[7];
+	uint32_t temp[7];
+	for (int i = 0; i < 7; i++) {
+		keys[i] = RadixSort<uint32_t>::float_key(values[i]);
+	}
+
+	RadixSort<uint32_t> sorter;
+	sorter.sort(keys, temp, 7, 32);
+
+	const float expected[7] = { -100.25, -1.0, -1e-5, 0.0, 2.0, 3.5, 1e10 };
+	for (int i = 0; i < 7; i++) {
+		CHECK(keys[i] == RadixSort<uint32_t>::float_key(expected[i]));
+	}
+}
+
+} // namespace TestRadixSort
+
+#endif // TEST_RADIX_SORT_H
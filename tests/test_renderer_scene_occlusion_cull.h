@@ -0,0 +1,94 @@
+/*************************************************************************/
+/*  test_renderer_scene_occlusion_cull.h                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_OCCLUSION_CULL_H
+#define TEST_RENDERER_SCENE_OCCLUSION_CULL_H
+
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestRendererSceneOcclusionCull {
+
+// Camera at the origin looking down -Z, with an 8x8 wall 5 units in front of it.
+static void rasterize_wall(RendererSceneOcclusionCull &r_occlusion_cull) {
+	CameraMatrix projection;
+	projection.set_perspective(70, 2, 0.1, 100);
+
+	const Vector3 vertices[4] = {
+		Vector3(-4, -4, -5),
+		Vector3(4, -4, -5),
+		Vector3(4, 4, -5),
+		Vector3(-4, 4, -5),
+	};
+	const uint32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+
+	r_occlusion_cull.begin(Transform(), projection);
+	r_occlusion_cull.add_occluder(Transform(), vertices, 4, indices, 6);
+	r_occlusion_cull.end();
+}
+
+TEST_CASE("[RendererSceneOcclusionCull] Without occluders") {
+	RendererSceneOcclusionCull occlusion_cull;
+	CameraMatrix projection;
+	projection.set_perspective(70, 2, 0.1, 100);
+
+	occlusion_cull.begin(Transform(), projection);
+	occlusion_cull.end();
+
+	CHECK_MESSAGE(!occlusion_cull.is_active(), "Occlusion culling should be inactive when nothing was rasterized.");
+	CHECK_MESSAGE(
+			!occlusion_cull.is_occluded(AABB(Vector3(-0.5, -0.5, -10.5), Vector3(1, 1, 1))),
+			"Nothing should be occluded without occluders.");
+}
+
+TEST_CASE("[RendererSceneOcclusionCull] Boxes around an occluder") {
+	RendererSceneOcclusionCull occlusion_cull;
+	rasterize_wall(occlusion_cull);
+
+	REQUIRE(occlusion_cull.is_active());
+	CHECK(occlusion_cull.get_triangles_rasterized() == 2);
+
+	CHECK_MESSAGE(
+			occlusion_cull.is_occluded(AABB(Vector3(-0.5, -0.5, -10.5), Vector3(1, 1, 1))),
+			"A box fully behind the occluder should be occluded.");
+	CHECK_MESSAGE(
+			!occlusion_cull.is_occluded(AABB(Vector3(6, -0.5, -10.5), Vector3(6, 1, 1))),
+			"A box partly behind the occluder should be visible.");
+	CHECK_MESSAGE(
+			!occlusion_cull.is_occluded(AABB(Vector3(-0.5, -0.5, -3.5), Vector3(1, 1, 1))),
+			"A box in front of the occluder should be visible.");
+	CHECK_MESSAGE(
+			!occlusion_cull.is_occluded(AABB(Vector3(-1, -1, -6), Vector3(2, 2, 2))),
+			"A box crossing the occluder should be visible.");
+}
+} // namespace TestRendererSceneOcclusionCull
+
+#endif // TEST_RENDERER_SCENE_OCCLUSION_CULL_H
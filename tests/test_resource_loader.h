@@ -0,0 +1,236 @@
+/*************************************************************************/
+/*  test_resource_loader.h                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RESOURCE_LOADER_H
+#define TEST_RESOURCE_LOADER_H
+
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/os/dir_access.h"
+#include "core/os/os.h"
+#include "servers/audio/audio_stream.h"
+
+#include "tests/test_macros.h"
+
+namespace TestResourceLoader {
+
+// Saves `leaf <- middle <- root`, each one referencing the previous one as an external resource.
+static void save_dependency_chain(const String &p_leaf_path, const String &p_middle_path, const String &p_root_path) {
+	Ref<AudioStreamRandomPitch> leaf;
+	leaf.instance();
+	REQUIRE(ResourceSaver::save(p_leaf_path, leaf, ResourceSaver::FLAG_CHANGE_PATH) == OK);
+
+	Ref<AudioStreamRandomPitch> middle;
+	middle.instance();
+	middle->set_audio_stream(leaf);
+	REQUIRE(ResourceSaver::save(p_middle_path, middle, ResourceSaver::FLAG_CHANGE_PATH) == OK);
+
+	Ref<AudioStreamRandomPitch> root;
+	root.instance();
+	root->set_audio_stream(middle);
+	REQUIRE(ResourceSaver::save(p_root_path, root) == OK);
+}
+
+static ResourceLoader::ThreadLoadStatus wait_for_prefetch(const String &p_path, float *r_progress) {
+	ResourceLoader::ThreadLoadStatus status = ResourceLoader::prefetch_get_status(p_path, r_progress);
+	for (int i = 0; i < 5000 && status == ResourceLoader::THREAD_LOAD_IN_PROGRESS; i++) {
+		OS::get_singleton()->delay_usec(1000);
+		status = ResourceLoader::prefetch_get_status(p_path, r_progress);
+	}
+	return status;
+}
+
+TEST_CASE("[ResourceLoader] Prefetch a missing resource") {
+	const String path = OS::get_singleton()->get_cache_path().plus_file("prefetch_missing.tres");
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(
+			ResourceLoader::prefetch_request(path) == ERR_FILE_NOT_FOUND,
+			"Prefetching a resource that doesn't exist should fail.");
+	ERR_PRINT_ON;
+
+	CHECK_MESSAGE(
+			ResourceLoader::prefetch_get_status(path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE,
+			"A failed prefetch request shouldn't leave a prefetch set behind.");
+}
+
+TEST_CASE("[ResourceLoader] Prefetch a resource and its dependencies") {
+	const String cache_path = OS::get_singleton()->get_cache_path();
+	const String leaf_path = cache_path.plus_file("prefetch_leaf.tres");
+	const String middle_path = cache_path.plus_file("prefetch_middle.tres");
+	const String root_path = cache_path.plus_file("prefetch_root.tres");
+
+	save_dependency_chain(leaf_path, middle_path, root_path);
+	REQUIRE(!ResourceCache::has(leaf_path));
+	REQUIRE(!ResourceCache::has(middle_path));
+
+	CHECK(ResourceLoader::prefetch_request(root_path) == OK);
+	CHECK_MESSAGE(
+			ResourceLoader::prefetch_request(root_path) == OK,
+			"Requesting a prefetch already in progress should be allowed.");
+
+	float progress = 0;
+	CHECK(wait_for_prefetch(root_path, &progress) == ResourceLoader::THREAD_LOAD_LOADED);
+	CHECK(progress == doctest::Approx(1.0));
+
+	CHECK_MESSAGE(ResourceCache::has(root_path), "The prefetched resource should be cached.");
+	CHECK_MESSAGE(ResourceCache::has(middle_path), "Direct dependencies should be cached.");
+	CHECK_MESSAGE(ResourceCache::has(leaf_path), "Indirect dependencies should be loaded along with the direct ones.");
+
+	Ref<AudioStreamRandomPitch> root = ResourceLoader::load(root_path);
+	REQUIRE(root.is_valid());
+	CHECK(root->get_audio_stream()->get_path() == middle_path);
+	root = Ref<AudioStreamRandomPitch>();
+
+	ResourceLoader::prefetch_release(root_path);
+
+	CHECK_MESSAGE(
+			ResourceLoader::prefetch_get_status(root_path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE,
+			"A released prefetch should be gone.");
+	CHECK_MESSAGE(!ResourceCache::has(root_path), "Releasing the prefetch should free unused resources.");
+	CHECK_MESSAGE(!ResourceCache::has(middle_path), "Releasing the prefetch should free unused dependencies.");
+	CHECK_MESSAGE(!ResourceCache::has(leaf_path), "Releasing the prefetch should free unused indirect dependencies.");
+}
+
+TEST_CASE("[ResourceLoader] Load a single sub-resource from a binary resource") {
+	const String path = OS::get_singleton()->get_cache_path().plus_file("sub_resources.res");
+	String first_path;
+	String second_path;
+	String shared_path;
+
+	{
+		// The first sub-resource references another one, the second is unrelated.
+		Ref<Resource> shared;
+		shared.instance();
+		shared->set_name("shared");
+
+		Ref<Resource> first;
+		first.instance();
+		first->set_name("first");
+		first->set_meta("shared", shared);
+
+		Ref<Resource> second;
+		second.instance();
+		second->set_name("second");
+
+		Ref<Resource> resource;
+		resource.instance();
+		resource->set_meta("first", first);
+		resource->set_meta("second", second);
+		REQUIRE(ResourceSaver::save(path, resource) == OK);
+
+		// Saving assigns the indices of the built-in resources.
+		first_path = path + "::" + itos(first->get_subindex());
+		second_path = path + "::" + itos(second->get_subindex());
+		shared_path = path + "::" + itos(shared->get_subindex());
+	}
+
+	REQUIRE(!ResourceCache::has(path));
+	REQUIRE(!ResourceCache::has(first_path));
+
+	Ref<Resource> first = ResourceLoader::load(first_path);
+	REQUIRE(first.is_valid());
+	CHECK(first->get_name() == "first");
+	CHECK(first->get_path() == first_path);
+
+	Ref<Resource> shared = first->get_meta("shared");
+	REQUIRE_MESSAGE(shared.is_valid(), "Sub-resources referenced by the loaded one should be loaded too.");
+	CHECK(shared->get_name() == "shared");
+	CHECK(shared->get_path() == shared_path);
+
+	CHECK_MESSAGE(!ResourceCache::has(second_path), "Unrelated sub-resources shouldn't be loaded.");
+	CHECK_MESSAGE(!ResourceCache::has(path), "The main resource shouldn't be loaded.");
+
+	Error error = OK;
+	ERR_PRINT_OFF;
+	Ref<Resource> missing = ResourceLoader::load(path + "::999", "", false, &error);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(missing.is_null(), "Loading a sub-resource that doesn't exist should fail.");
+	CHECK(error != OK);
+	CHECK_MESSAGE(!ResourceCache::has(path), "A failed sub-resource load shouldn't load the main resource.");
+}
+
+static int dependency_errors = 0;
+
+static void count_dependency_error(void *p_ud, const String &p_loading, const String &p_which, const String &p_type) {
+	dependency_errors++;
+}
+
+TEST_CASE("[ResourceLoader] Load a binary resource with a missing dependency referenced several times") {
+	const String cache_path = OS::get_singleton()->get_cache_path();
+	const String dependency_path = cache_path.plus_file("missing_dependency.tres");
+	const String path = cache_path.plus_file("missing_dependency_owner.res");
+
+	{
+		Ref<AudioStreamRandomPitch> dependency;
+		dependency.instance();
+		REQUIRE(ResourceSaver::save(dependency_path, dependency, ResourceSaver::FLAG_CHANGE_PATH) == OK);
+
+		// An internal sub-resource referencing it too, so the external index is hit from two resources.
+		Ref<Resource> sub_resource;
+		sub_resource.instance();
+		sub_resource->set_meta("dependency", dependency);
+
+		Ref<Resource> resource;
+		resource.instance();
+		resource->set_meta("first", dependency);
+		resource->set_meta("second", dependency);
+		resource->set_meta("third", dependency);
+		resource->set_meta("sub_resource", sub_resource);
+		REQUIRE(ResourceSaver::save(path, resource) == OK);
+	}
+
+	DirAccessRef da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	REQUIRE(da->remove(dependency_path) == OK);
+
+	dependency_errors = 0;
+	ResourceLoader::set_dependency_error_notify_func(nullptr, count_dependency_error);
+
+	ERR_PRINT_OFF;
+	Ref<Resource> resource = ResourceLoader::load(path, "", true);
+	ERR_PRINT_ON;
+
+	ResourceLoader::set_dependency_error_notify_func(nullptr, nullptr);
+
+	REQUIRE_MESSAGE(resource.is_valid(), "A missing dependency shouldn't prevent the resource from loading.");
+	CHECK_MESSAGE(
+			dependency_errors == 1,
+			"The missing dependency should be tried and reported only once.");
+	CHECK(Ref<Resource>(resource->get_meta("first")).is_null());
+	CHECK(Ref<Resource>(resource->get_meta("third")).is_null());
+
+	Ref<Resource> sub_resource = resource->get_meta("sub_resource");
+	REQUIRE(sub_resource.is_valid());
+	CHECK(Ref<Resource>(sub_resource->get_meta("dependency")).is_null());
+}
+
+} // namespace TestResourceLoader
+
+#endif // TEST_RESOURCE_LOADER_H